@@ -0,0 +1,33 @@
+// Author: JUNSEOK LEE
+// Date: 2025 December 29
+// as the days dwindle down to a precious few
+
+// Uniform blocks written once per frame by DemoDepthPost into one ring buffer
+// and bound with glBindBufferRange, instead of glUniform calls per program.
+// std140, so the C++ structs in DemoDepthPost.cpp mirror these byte for byte;
+// the offsets are checked against the driver's reflection when a program is acquired.
+// Members are highp so every stage that includes this file declares them identically.
+// Binding points: 1 = PerFrame, 2 = PerView, 3 = PerPass.
+
+layout(std140) uniform PerFrame
+{
+    highp float uTime;
+};
+
+layout(std140) uniform PerView
+{
+    highp mat3 uViewProjection;
+    highp vec2 uResolution;
+    highp vec2 uTexelSize;
+};
+
+layout(std140) uniform PerPass
+{
+    highp float uStrength;
+    highp float uIntensity;
+    highp float uRadius;
+    highp float uSoftness;
+    highp float uGrainIntensity;
+    highp float uScanlineIntensity;
+    highp float uGamma;
+};
@@ -6,17 +6,17 @@
 
 precision mediump float;
 
+#include "blocks.glsl"
+#include "post_effects.glsl"
+
 in vec2 vTexCoord;
 
 uniform sampler2D uInput;
-uniform float uGamma;
 
 out vec4 FragColor;
 
 void main()
 {
     vec3 color = texture(uInput, vTexCoord).rgb;
-    float inv_gamma = 1.0 / max(uGamma, 0.001);
-    color = pow(color, vec3(inv_gamma));
-    FragColor = vec4(color, 1.0);
+    FragColor = vec4(apply_gamma(color, uGamma), 1.0);
 }
@@ -0,0 +1,44 @@
+// Author: JUNSEOK LEE
+// Date: 2025 December 29
+// as the days dwindle down to a precious few
+
+// Post effects shared by the single-effect shaders and post_fused.frag.
+// Pulled in with #include, so no #version or precision statement here.
+
+vec3 apply_chromatic(sampler2D source, vec2 uv, vec2 texel_size, float strength)
+{
+    vec2 centered = uv - vec2(0.5);
+    vec2 offset = centered * strength * texel_size;
+
+    float r = texture(source, uv + offset).r;
+    float g = texture(source, uv).g;
+    float b = texture(source, uv - offset).b;
+    return vec3(r, g, b);
+}
+
+vec3 apply_vignette(vec3 color, vec2 uv, float intensity, float radius, float softness)
+{
+    float dist = distance(uv, vec2(0.5));
+    float vignette = smoothstep(radius, radius - softness, dist);
+    return color * mix(1.0, vignette, intensity);
+}
+
+float post_rand(vec2 co)
+{
+    return fract(sin(dot(co, vec2(12.9898, 78.233))) * 43758.5453);
+}
+
+vec3 apply_grain(vec3 color, vec2 uv, vec2 resolution, float time, float grain_intensity, float scanline_intensity)
+{
+    float noise = post_rand(uv * resolution + time * 60.0);
+    color += (noise - 0.5) * grain_intensity;
+
+    float scan = sin(uv.y * resolution.y * 3.14159);
+    return color * (1.0 - scanline_intensity * (0.5 - 0.5 * scan));
+}
+
+vec3 apply_gamma(vec3 color, float gamma)
+{
+    float inv_gamma = 1.0 / max(gamma, 0.001);
+    return pow(color, vec3(inv_gamma));
+}
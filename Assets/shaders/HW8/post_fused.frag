@@ -0,0 +1,47 @@
+#version 300 es
+
+// Author: JUNSEOK LEE
+// Date: 2025 December 29
+// as the days dwindle down to a precious few
+
+// Whole post chain in one pass. The host injects POST_CHROMATIC, POST_VIGNETTE,
+// POST_GRAIN and POST_GAMMA after the #version line to select a permutation.
+// Effects run in the same order as the per-effect passes. All effect
+// parameters come from the PerView, PerFrame and PerPass blocks.
+
+precision mediump float;
+
+#include "blocks.glsl"
+#include "post_effects.glsl"
+
+in vec2 vTexCoord;
+
+uniform sampler2D uInput;
+
+out vec4 FragColor;
+
+void main()
+{
+#ifdef POST_CHROMATIC
+    vec3 color = apply_chromatic(uInput, vTexCoord, uTexelSize, uStrength);
+#else
+    vec3 color = texture(uInput, vTexCoord).rgb;
+#endif
+
+#ifdef POST_VIGNETTE
+    color = apply_vignette(color, vTexCoord, uIntensity, uRadius, uSoftness);
+#endif
+
+#ifdef POST_GRAIN
+    color = apply_grain(color, vTexCoord, uResolution, uTime, uGrainIntensity, uScanlineIntensity);
+#endif
+
+    // the separate passes clamp when writing to RGBA8 targets, do the same here
+    color = clamp(color, 0.0, 1.0);
+
+#ifdef POST_GAMMA
+    color = apply_gamma(color, uGamma);
+#endif
+
+    FragColor = vec4(color, 1.0);
+}
@@ -6,10 +6,11 @@
 
 precision highp float;
 
+#include "blocks.glsl"
+
 layout(location = 0) in vec2 aPosition;
 layout(location = 1) in vec2 aTexCoord;
 
-uniform mat3 uViewProjection;
 uniform mat3 uModel;
 uniform float uDepth;
 
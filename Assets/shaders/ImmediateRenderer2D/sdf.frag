@@ -11,7 +11,8 @@ precision mediump float;
 
 out vec4 FragColor;
 
-uniform int shapetype; // iguess we need to pass a variable of this name in a later stage... 
+// the shape is chosen at compile time, ImmediateRenderer2D builds one variant
+// with SDF_SHAPE_CIRCLE and one with SDF_SHAPE_RECTANGLE defined
 
 uniform vec2 size; // was u world size
 
@@ -58,15 +59,14 @@ vec4 evaluate_color(float sdf)
 void main()
 {
  // based off shape evaluate the sdf
-    float sdf = 0.0;
-    if(shapetype == 0)
-    {
-        float radius = min(size.x, size.y)*0.5;
-        sdf = sdCircle(testpoint, radius);
-    }else if(shapetype == 1)
-    {
-        sdf = sdRectangle(testpoint, 0.5*size);
-    }
+#if defined(SDF_SHAPE_CIRCLE)
+    float radius = min(size.x, size.y)*0.5;
+    float sdf = sdCircle(testpoint, radius);
+#elif defined(SDF_SHAPE_RECTANGLE)
+    float sdf = sdRectangle(testpoint, 0.5*size);
+#else
+#   error "sdf.frag needs SDF_SHAPE_CIRCLE or SDF_SHAPE_RECTANGLE"
+#endif
  // get the color
     vec4 color = evaluate_color(sdf);
     if(color.a <= 0.0)
@@ -0,0 +1,24 @@
+#version 300 es
+
+// Author: Junseok Lee
+// Date: 2025 Fall
+// Round particles cut out of their quad, with a one pixel soft edge so tiny ones do not shimmer.
+
+precision mediump float;
+
+in vec2 vLocal;
+in float vAlpha;
+
+uniform vec4 uColor;
+
+out vec4 FragColor;
+
+void main()
+{
+    float distance_to_center = length(vLocal);
+    float coverage = 1.0 - smoothstep(1.0 - fwidth(distance_to_center), 1.0, distance_to_center);
+    float alpha = uColor.a * vAlpha * coverage;
+    if (alpha <= 0.0)
+        discard;
+    FragColor = vec4(uColor.rgb, alpha);
+}
@@ -0,0 +1,27 @@
+#version 300 es
+
+// Author: Junseok Lee
+// Date: 2025 Fall
+// One unit quad drawn once per particle, see CS230::ParticleEmitter.
+
+layout(std140) uniform Camera
+{
+    mat3 uViewProjection;
+};
+
+layout(location = 0) in vec2 aCorner;   // -0.5 to 0.5
+layout(location = 1) in vec4 aInstance; // center xy, diameter, alpha
+
+uniform mat3 uModel;
+
+out vec2 vLocal;
+out float vAlpha;
+
+void main()
+{
+    vec2 world_pos = aInstance.xy + aCorner * aInstance.z;
+    vec3 ndc_pos = uViewProjection * (uModel * vec3(world_pos, 1.0));
+    gl_Position = vec4(ndc_pos.xy, 0.0, 1.0);
+    vLocal = aCorner * 2.0;
+    vAlpha = aInstance.w;
+}
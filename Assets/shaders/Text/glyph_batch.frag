@@ -0,0 +1,22 @@
+#version 300 es
+
+// Author: Junseok Lee
+// Date: 2025 Fall
+// Same tinting as ImmediateRenderer2D/quad.frag, so laid out text matches Font::DrawText.
+
+precision mediump float;
+
+in vec2 vTexCoord;
+
+uniform sampler2D uTex2d;
+uniform vec4 uTintColor;
+
+out vec4 FragColor;
+
+void main()
+{
+    vec4 color = texture(uTex2d, vTexCoord) * uTintColor;
+    if (color.a == 0.0)
+        discard;
+    FragColor = color;
+}
@@ -0,0 +1,25 @@
+#version 300 es
+
+// Author: Junseok Lee
+// Date: 2025 Fall
+// Bitmap font glyph quads kept in a persistent vertex buffer, see CS230::TextLayout.
+
+layout(std140) uniform Camera
+{
+    mat3 uViewProjection;
+};
+
+layout(location = 0) in vec2 aPosition;
+layout(location = 1) in vec2 aTexCoord;
+
+uniform mat3 uModel;
+
+out vec2 vTexCoord;
+
+void main()
+{
+    vec3 world_pos = uModel * vec3(aPosition, 1.0);
+    vec3 ndc_pos = uViewProjection * world_pos;
+    gl_Position = vec4(ndc_pos.xy, 0.0, 1.0);
+    vTexCoord = aTexCoord;
+}
@@ -0,0 +1,39 @@
+#version 300 es
+
+// Author: Junseok Lee
+// Date: 2025 Fall
+// The atlas stores 0.5 on the glyph edge, more inside, less outside.
+// Thresholding that distance instead of coverage keeps edges sharp at any scale.
+
+precision mediump float;
+
+in vec2 vTexCoord;
+
+uniform sampler2D uAtlas;
+uniform vec4 uFillColor;
+uniform vec4 uOutlineColor;
+uniform float uOutlineWidth; // in distance units, 0.5 is the full spread
+
+out vec4 FragColor;
+
+void main()
+{
+    float distance = texture(uAtlas, vTexCoord).r;
+
+    // one screen pixel worth of distance, so the edge is antialiased the same at every scale
+    float smoothing = max(fwidth(distance) * 0.75, 0.0001);
+
+    float fill = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);
+    vec4 color = uFillColor;
+    float shape = fill;
+    if (uOutlineWidth > 0.0)
+    {
+        float outer_edge = 0.5 - uOutlineWidth;
+        shape = smoothstep(outer_edge - smoothing, outer_edge + smoothing, distance);
+        color = mix(uOutlineColor, uFillColor, fill);
+    }
+
+    FragColor = vec4(color.rgb, color.a * shape);
+    if (FragColor.a <= 0.0)
+        discard;
+}
@@ -10,7 +10,10 @@ include(cmake/dependencies/GLEW.cmake)      # defines target the_glew
 include(cmake/dependencies/SDL2.cmake)      # defines target the_sdl2
 include(cmake/dependencies/DearImGUI.cmake) # defines target the_imgui   ;  note DearImGUI.cmake depends on SDL2.cmake
 include(cmake/dependencies/GSL.cmake)       # defines target the_gsl
-include(cmake/dependencies/STB.cmake)       # defines target the_stb
+include(cmake/dependencies/STB.cmake)       # defines targets the_stb and the_stb_write, the latter only linked by tools
+include(cmake/dependencies/SPNG.cmake)      # defines target the_spng, empty unless CS200_USE_SPNG is on
+
+find_package(Threads REQUIRED)             # TextureManager decode workers
 
 add_library(dependencies INTERFACE)
 
@@ -21,4 +24,6 @@ target_link_libraries(dependencies INTERFACE
     the_imgui
     the_gsl
     the_stb
+    the_spng
+    Threads::Threads
 )
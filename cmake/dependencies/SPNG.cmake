@@ -0,0 +1,47 @@
+# author Junseok Lee
+# date 2025 Fall
+# CS200 Computer Graphics I
+# copyright DigiPen Institute of Technology
+
+# Optional png decoder for CS200::Image, stb_image stays the default and handles every other format.
+# libspng runs the png row filters with SSE2/NEON and inflates through zlib-ng, whose inflate is SIMD too.
+# Compare the two with the cs200_image_bench tool.
+
+option(CS200_USE_SPNG "Decode png files with libspng and zlib-ng instead of stb_image" OFF)
+
+add_library(the_spng INTERFACE)
+
+if(CS200_USE_SPNG AND NOT EMSCRIPTEN)
+    # zlib-ng in zlib compatible mode, built static without touching BUILD_SHARED_LIBS for the other dependencies
+    set(saved_build_shared_libs ${BUILD_SHARED_LIBS})
+    set(BUILD_SHARED_LIBS OFF)
+    set(ZLIB_COMPAT ON CACHE BOOL "" FORCE)
+    set(ZLIB_ENABLE_TESTS OFF CACHE BOOL "" FORCE)
+    set(ZLIBNG_ENABLE_TESTS OFF CACHE BOOL "" FORCE)
+    set(WITH_GTEST OFF CACHE BOOL "" FORCE)
+    FetchContent_Declare(
+        zlib_ng
+        GIT_REPOSITORY https://github.com/zlib-ng/zlib-ng.git
+        GIT_TAG 2.2.2
+    )
+    FetchContent_MakeAvailable(zlib_ng)
+    set(BUILD_SHARED_LIBS ${saved_build_shared_libs})
+
+    # spng is one C file, built here rather than through its own CMakeLists, which looks for a system zlib;
+    # SOURCE_SUBDIR names a folder that does not exist, so MakeAvailable only downloads the sources
+    FetchContent_Declare(
+        spng
+        GIT_REPOSITORY https://github.com/randy408/libspng.git
+        GIT_TAG v0.7.4
+        SOURCE_SUBDIR no-cmake-build
+    )
+    FetchContent_MakeAvailable(spng)
+
+    add_library(the_spng_impl STATIC ${spng_SOURCE_DIR}/spng/spng.c)
+    target_include_directories(the_spng_impl SYSTEM PUBLIC ${spng_SOURCE_DIR}/spng)
+    target_compile_definitions(the_spng_impl PUBLIC SPNG_STATIC)
+    target_link_libraries(the_spng_impl PRIVATE zlib)
+
+    target_link_libraries(the_spng INTERFACE the_spng_impl)
+    target_compile_definitions(the_spng INTERFACE CS200_USE_SPNG)
+endif()
@@ -12,19 +12,26 @@ FetchContent_Declare(
 
 FetchContent_MakeAvailable(stb_github)
 
-if(NOT EXISTS ${CMAKE_CURRENT_BINARY_DIR}/stb_implementation.cpp)
-    set(STB_IMPLEMENTATION_CODE "// This file is auto-generated from cmake/depenendencies/STB.cmake
-    #define STB_IMAGE_IMPLEMENTATION
-    #include \"stb_image.h\"
-    //#define STB_PERLIN_IMPLEMENTATION
-    //#include \"stb_perlin.h\"
-    //#include \"stb_vorbis.c\"
-    ")
-
-    file(WRITE ${CMAKE_CURRENT_BINARY_DIR}/stb_implementation.cpp ${STB_IMPLEMENTATION_CODE})
-    set_source_files_properties(${CMAKE_CURRENT_BINARY_DIR}/stb_implementation.cpp PROPERTIES GENERATED TRUE)
-endif()
+# file(CONFIGURE) only rewrites the file when the content changes, so existing build folders pick up new implementations
+file(CONFIGURE OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/stb_implementation.cpp CONTENT "// This file is auto-generated from cmake/depenendencies/STB.cmake
+#define STB_IMAGE_IMPLEMENTATION
+#include \"stb_image.h\"
+//#define STB_PERLIN_IMPLEMENTATION
+//#include \"stb_perlin.h\"
+//#include \"stb_vorbis.c\"
+" @ONLY)
 
 add_library(the_stb STATIC ${CMAKE_CURRENT_BINARY_DIR}/stb_implementation.cpp)
 target_include_directories(the_stb SYSTEM PUBLIC ${stb_github_SOURCE_DIR})
 
+# stb_image_write only for the offline tools, the game never writes images; the asset packer uses its zlib compressor,
+# stb_image has the matching decoder
+if(NOT EMSCRIPTEN)
+    file(CONFIGURE OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/stb_write_implementation.cpp CONTENT "// This file is auto-generated from cmake/depenendencies/STB.cmake
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include \"stb_image_write.h\"
+" @ONLY)
+
+    add_library(the_stb_write STATIC ${CMAKE_CURRENT_BINARY_DIR}/stb_write_implementation.cpp)
+    target_include_directories(the_stb_write SYSTEM PUBLIC ${stb_github_SOURCE_DIR})
+endif()
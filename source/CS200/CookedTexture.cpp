@@ -0,0 +1,70 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "CookedTexture.hpp"
+
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    constexpr std::uint32_t CookedMagic       = 0x58544343; // "CCTX"
+    constexpr std::uint32_t CookedVersion     = 2; // 1 stored the png's byte count
+    constexpr std::uint32_t FlagPremultiplied = 1;
+
+    struct CookedHeader
+    {
+        std::uint32_t Magic;
+        std::uint32_t Version;
+        std::uint64_t SourceHash;
+        std::int32_t  Width;
+        std::int32_t  Height;
+        std::uint32_t Flags;
+        std::uint32_t Reserved; // keeps the texels 8 byte aligned in the file
+    };
+    static_assert(sizeof(CookedHeader) == 32);
+}
+
+namespace CS200
+{
+    bool WriteCookedTexture(const std::filesystem::path& path, const CookedTexture& texture)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+
+        const CookedHeader header{ CookedMagic, CookedVersion, texture.SourceHash, texture.Size.x, texture.Size.y,
+                                   texture.Premultiplied ? FlagPremultiplied : 0u, 0 };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(texture.Texels.data()), static_cast<std::streamsize>(texture.Texels.size() * sizeof(RGBA)));
+        return static_cast<bool>(file);
+    }
+
+    std::optional<CookedTexture> ReadCookedTexture(std::span<const std::uint8_t> file_bytes)
+    {
+        CookedHeader header{};
+        if (file_bytes.size() < sizeof(header))
+            return std::nullopt;
+        std::memcpy(&header, file_bytes.data(), sizeof(header));
+        if (header.Magic != CookedMagic || header.Version != CookedVersion)
+            return std::nullopt;
+        if (header.Width <= 0 || header.Height <= 0 || header.Width > 16384 || header.Height > 16384)
+            return std::nullopt;
+
+        const auto texel_count = static_cast<std::size_t>(header.Width) * static_cast<std::size_t>(header.Height);
+        if (file_bytes.size() != sizeof(header) + texel_count * sizeof(RGBA))
+            return std::nullopt;
+
+        CookedTexture texture;
+        texture.Size          = { header.Width, header.Height };
+        texture.SourceHash    = header.SourceHash;
+        texture.Premultiplied = (header.Flags & FlagPremultiplied) != 0;
+        texture.Texels.resize(texel_count);
+        std::memcpy(texture.Texels.data(), file_bytes.data() + sizeof(header), texel_count * sizeof(RGBA));
+        return texture;
+    }
+}
@@ -0,0 +1,48 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Engine/Vec2.hpp"
+#include "RGBA.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace CS200
+{
+    /**
+     * \brief An image already decoded and laid out for upload, as written by cs200_cook
+     *
+     * A .ctex file is a small header followed by the RGBA8 texels, bottom row
+     * first like OpenGL expects. Loading one is a file read and a glTexImage2D,
+     * with no png inflate, no filtering and no flip; it is bigger on disk than
+     * the png it was cooked from, which is what an asset pack's mapping is for.
+     */
+    struct CookedTexture
+    {
+        Math::ivec2       Size{ 0, 0 };
+        std::uint64_t     SourceHash    = 0;     ///< assets::hash_bytes() of the png the texels were cooked from, to detect stale files
+        bool              Premultiplied = false; ///< Colors multiplied by alpha, for renderers that blend with GL_ONE
+        std::vector<RGBA> Texels;
+    };
+
+    /**
+     * \brief Write a .ctex file
+     * \return False if the file cannot be written
+     */
+    bool WriteCookedTexture(const std::filesystem::path& path, const CookedTexture& texture);
+
+    /**
+     * \brief Parse the contents of a .ctex file
+     * \param file_bytes The whole file, from disk or from the asset pack
+     * \return Nothing if the bytes are not a complete .ctex of the current version
+     */
+    [[nodiscard]] std::optional<CookedTexture> ReadCookedTexture(std::span<const std::uint8_t> file_bytes);
+}
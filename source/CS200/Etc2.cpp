@@ -0,0 +1,441 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "Etc2.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    using Texel = std::array<int, 4>; // r g b a, 0..255
+    using Block = std::array<Texel, 16>;
+
+    // ETC1 modifier tables, pixel index 0..3 selects +small, +large, -small, -large
+    constexpr int ColorTables[8][2] = { { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 } };
+
+    constexpr int AlphaTables[16][8] = {
+        { -3, -6, -9, -15, 2, 5, 8, 14 }, { -3, -7, -10, -13, 2, 6, 9, 12 }, { -2, -5, -8, -13, 1, 4, 7, 12 }, { -2, -4, -6, -13, 1, 3, 5, 12 },
+        { -3, -6, -8, -12, 2, 5, 7, 11 }, { -3, -7, -9, -11, 2, 6, 8, 10 },  { -4, -7, -8, -11, 3, 6, 7, 10 }, { -3, -5, -8, -11, 2, 4, 7, 10 },
+        { -2, -6, -8, -10, 1, 5, 7, 9 },  { -2, -5, -8, -10, 1, 4, 7, 9 },   { -2, -4, -8, -10, 1, 3, 7, 9 },  { -2, -5, -7, -10, 1, 4, 6, 9 },
+        { -3, -4, -7, -10, 2, 3, 6, 9 },  { -1, -2, -3, -10, 0, 1, 2, 9 },   { -4, -6, -8, -9, 3, 5, 7, 8 },   { -3, -5, -7, -9, 2, 4, 6, 8 },
+    };
+
+    int modifier(int table, int index) noexcept
+    {
+        const int magnitude = ColorTables[table][index & 1];
+        return (index & 2) != 0 ? -magnitude : magnitude;
+    }
+
+    int clamp_byte(int value) noexcept
+    {
+        return std::clamp(value, 0, 255);
+    }
+
+    int expand4(int value) noexcept
+    {
+        return (value << 4) | value;
+    }
+
+    int expand5(int value) noexcept
+    {
+        return (value << 3) | (value >> 2);
+    }
+
+    // texels are numbered down the columns, the way the block stores its indices
+    int texel_number(int x, int y) noexcept
+    {
+        return x * 4 + y;
+    }
+
+    bool in_second_half(int number, bool flip) noexcept
+    {
+        return flip ? (number % 4) >= 2 : (number / 4) >= 2;
+    }
+
+    struct HalfFit
+    {
+        long long Error = std::numeric_limits<long long>::max();
+        int       Table = 0;
+        std::array<int, 16> Indices{};
+    };
+
+    HalfFit fit_half(const Block& block, bool flip, bool second, const std::array<int, 3>& base)
+    {
+        HalfFit best;
+        for (int table = 0; table < 8; ++table)
+        {
+            HalfFit candidate;
+            candidate.Error = 0;
+            candidate.Table = table;
+            for (int n = 0; n < 16; ++n)
+            {
+                if (in_second_half(n, flip) != second)
+                    continue;
+
+                long long best_texel = std::numeric_limits<long long>::max();
+                for (int index = 0; index < 4; ++index)
+                {
+                    long long error = 0;
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        const int d = clamp_byte(base[static_cast<std::size_t>(c)] + modifier(table, index)) - block[static_cast<std::size_t>(n)][static_cast<std::size_t>(c)];
+                        error += static_cast<long long>(d) * d;
+                    }
+                    if (error < best_texel)
+                    {
+                        best_texel                                         = error;
+                        candidate.Indices[static_cast<std::size_t>(n)] = index;
+                    }
+                }
+                candidate.Error += best_texel;
+            }
+            if (candidate.Error < best.Error)
+            {
+                best = candidate;
+            }
+        }
+        return best;
+    }
+
+    void write_be64(std::uint8_t* out, std::uint64_t bits) noexcept
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            out[i] = static_cast<std::uint8_t>(bits >> (56 - 8 * i));
+        }
+    }
+
+    std::uint64_t read_be64(const std::uint8_t* in) noexcept
+    {
+        std::uint64_t bits = 0;
+        for (int i = 0; i < 8; ++i)
+        {
+            bits = (bits << 8) | in[i];
+        }
+        return bits;
+    }
+
+    std::uint64_t encode_color(const Block& block)
+    {
+        std::uint64_t best_bits  = 0;
+        long long     best_error = std::numeric_limits<long long>::max();
+
+        for (const bool flip : { false, true })
+        {
+            std::array<std::array<double, 3>, 2> average{};
+            for (int n = 0; n < 16; ++n)
+            {
+                auto& sum = average[in_second_half(n, flip) ? 1 : 0];
+                for (int c = 0; c < 3; ++c)
+                    sum[static_cast<std::size_t>(c)] += block[static_cast<std::size_t>(n)][static_cast<std::size_t>(c)] / 8.0;
+            }
+
+            // differential mode keeps 5 bits per base when the two halves are close
+            std::array<std::array<int, 3>, 2> q5{};
+            bool                              differential = true;
+            for (int c = 0; c < 3; ++c)
+            {
+                for (int h = 0; h < 2; ++h)
+                    q5[static_cast<std::size_t>(h)][static_cast<std::size_t>(c)] = static_cast<int>(std::lround(average[static_cast<std::size_t>(h)][static_cast<std::size_t>(c)] * 31.0 / 255.0));
+                const int delta = q5[1][static_cast<std::size_t>(c)] - q5[0][static_cast<std::size_t>(c)];
+                differential    = differential && delta >= -4 && delta <= 3;
+            }
+
+            for (const bool use_differential : { true, false })
+            {
+                if (use_differential && !differential)
+                    continue;
+
+                std::array<std::array<int, 3>, 2> stored{};
+                std::array<std::array<int, 3>, 2> base{};
+                for (int h = 0; h < 2; ++h)
+                {
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        const auto hh = static_cast<std::size_t>(h);
+                        const auto cc = static_cast<std::size_t>(c);
+                        if (use_differential)
+                        {
+                            stored[hh][cc] = q5[hh][cc];
+                            base[hh][cc]   = expand5(q5[hh][cc]);
+                        }
+                        else
+                        {
+                            stored[hh][cc] = static_cast<int>(std::lround(average[hh][cc] * 15.0 / 255.0));
+                            base[hh][cc]   = expand4(stored[hh][cc]);
+                        }
+                    }
+                }
+
+                const HalfFit first  = fit_half(block, flip, false, base[0]);
+                const HalfFit second = fit_half(block, flip, true, base[1]);
+                const long long error = first.Error + second.Error;
+                if (error >= best_error)
+                    continue;
+
+                std::uint64_t bits = 0;
+                for (int c = 0; c < 3; ++c)
+                {
+                    const auto cc    = static_cast<std::size_t>(c);
+                    const int  shift = 56 - 8 * c;
+                    if (use_differential)
+                    {
+                        const int delta = stored[1][cc] - stored[0][cc];
+                        bits |= static_cast<std::uint64_t>(stored[0][cc]) << (shift + 3);
+                        bits |= static_cast<std::uint64_t>(delta & 7) << shift;
+                    }
+                    else
+                    {
+                        bits |= static_cast<std::uint64_t>(stored[0][cc]) << (shift + 4);
+                        bits |= static_cast<std::uint64_t>(stored[1][cc]) << shift;
+                    }
+                }
+                bits |= static_cast<std::uint64_t>(first.Table) << 37;
+                bits |= static_cast<std::uint64_t>(second.Table) << 34;
+                bits |= static_cast<std::uint64_t>(use_differential ? 1 : 0) << 33;
+                bits |= static_cast<std::uint64_t>(flip ? 1 : 0) << 32;
+                for (int n = 0; n < 16; ++n)
+                {
+                    const int index = in_second_half(n, flip) ? second.Indices[static_cast<std::size_t>(n)] : first.Indices[static_cast<std::size_t>(n)];
+                    bits |= static_cast<std::uint64_t>(index >> 1) << (16 + n);
+                    bits |= static_cast<std::uint64_t>(index & 1) << n;
+                }
+
+                best_error = error;
+                best_bits  = bits;
+            }
+        }
+        return best_bits;
+    }
+
+    std::uint64_t encode_alpha(const Block& block)
+    {
+        int low = 255, high = 0;
+        for (const auto& texel : block)
+        {
+            low  = std::min(low, texel[3]);
+            high = std::max(high, texel[3]);
+        }
+        if (low == high)
+        {
+            // table 13 has a zero modifier at index 4, exact for flat blocks
+            std::uint64_t bits = static_cast<std::uint64_t>(low) << 56 | std::uint64_t{ 1 } << 52 | std::uint64_t{ 13 } << 48;
+            for (int n = 0; n < 16; ++n)
+                bits |= std::uint64_t{ 4 } << (45 - 3 * n);
+            return bits;
+        }
+
+        std::uint64_t best_bits  = 0;
+        long long     best_error = std::numeric_limits<long long>::max();
+        for (int table = 0; table < 16; ++table)
+        {
+            const int    span       = AlphaTables[table][7] - AlphaTables[table][3];
+            const double multiplier = static_cast<double>(high - low) / span;
+            for (int m = static_cast<int>(multiplier) - 1; m <= static_cast<int>(multiplier) + 2; ++m)
+            {
+                if (m < 1 || m > 15)
+                    continue;
+                const int center = (low + high - (AlphaTables[table][3] + AlphaTables[table][7]) * m) / 2;
+                for (int base = center - 2; base <= center + 2; ++base)
+                {
+                    if (base < 0 || base > 255)
+                        continue;
+
+                    std::uint64_t bits  = static_cast<std::uint64_t>(base) << 56 | static_cast<std::uint64_t>(m) << 52 | static_cast<std::uint64_t>(table) << 48;
+                    long long     error = 0;
+                    for (int n = 0; n < 16 && error < best_error; ++n)
+                    {
+                        int best_index = 0, best_texel = std::numeric_limits<int>::max();
+                        for (int index = 0; index < 8; ++index)
+                        {
+                            const int d = clamp_byte(base + AlphaTables[table][index] * m) - block[static_cast<std::size_t>(n)][3];
+                            if (d * d < best_texel)
+                            {
+                                best_texel = d * d;
+                                best_index = index;
+                            }
+                        }
+                        error += best_texel;
+                        bits |= static_cast<std::uint64_t>(best_index) << (45 - 3 * n);
+                    }
+                    if (error < best_error)
+                    {
+                        best_error = error;
+                        best_bits  = bits;
+                    }
+                }
+            }
+        }
+        return best_bits;
+    }
+
+    bool decode_color(std::uint64_t bits, Block& block)
+    {
+        const bool flip         = ((bits >> 32) & 1) != 0;
+        const bool differential = ((bits >> 33) & 1) != 0;
+
+        std::array<std::array<int, 3>, 2> base{};
+        for (int c = 0; c < 3; ++c)
+        {
+            const int shift = 56 - 8 * c;
+            if (differential)
+            {
+                const int first = static_cast<int>((bits >> (shift + 3)) & 31);
+                int       delta = static_cast<int>((bits >> shift) & 7);
+                delta           = delta >= 4 ? delta - 8 : delta;
+                if (first + delta < 0 || first + delta > 31)
+                    return false; // T, H or planar mode, never written by encode_color
+                base[0][static_cast<std::size_t>(c)] = expand5(first);
+                base[1][static_cast<std::size_t>(c)] = expand5(first + delta);
+            }
+            else
+            {
+                base[0][static_cast<std::size_t>(c)] = expand4(static_cast<int>((bits >> (shift + 4)) & 15));
+                base[1][static_cast<std::size_t>(c)] = expand4(static_cast<int>((bits >> shift) & 15));
+            }
+        }
+
+        const int tables[2] = { static_cast<int>((bits >> 37) & 7), static_cast<int>((bits >> 34) & 7) };
+        for (int n = 0; n < 16; ++n)
+        {
+            const int half  = in_second_half(n, flip) ? 1 : 0;
+            const int index = static_cast<int>(((bits >> (16 + n)) & 1) << 1 | ((bits >> n) & 1));
+            for (int c = 0; c < 3; ++c)
+                block[static_cast<std::size_t>(n)][static_cast<std::size_t>(c)] = clamp_byte(base[static_cast<std::size_t>(half)][static_cast<std::size_t>(c)] + modifier(tables[half], index));
+        }
+        return true;
+    }
+
+    void decode_alpha(std::uint64_t bits, Block& block) noexcept
+    {
+        const int base  = static_cast<int>(bits >> 56);
+        const int m     = static_cast<int>((bits >> 52) & 15);
+        const int table = static_cast<int>((bits >> 48) & 15);
+        for (int n = 0; n < 16; ++n)
+        {
+            const int index                          = static_cast<int>((bits >> (45 - 3 * n)) & 7);
+            block[static_cast<std::size_t>(n)][3] = clamp_byte(base + AlphaTables[table][index] * m);
+        }
+    }
+}
+
+namespace CS200
+{
+    std::size_t Etc2DataSize(Math::ivec2 size, Etc2Format format) noexcept
+    {
+        const auto blocks_x = static_cast<std::size_t>((size.x + 3) / 4);
+        const auto blocks_y = static_cast<std::size_t>((size.y + 3) / 4);
+        return blocks_x * blocks_y * Etc2BlockBytes(format);
+    }
+
+    bool HasTranslucentTexels(const Image& image) noexcept
+    {
+        const auto  size  = image.GetSize();
+        const auto* bytes = reinterpret_cast<const std::uint8_t*>(image.data());
+        const auto  count = static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (bytes[i * 4 + 3] != 255)
+                return true;
+        }
+        return false;
+    }
+
+    std::vector<std::uint8_t> EncodeEtc2(const Image& image, Etc2Format format)
+    {
+        const auto size = image.GetSize();
+        return EncodeEtc2(std::span<const RGBA>(image.data(), static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y)), size, format);
+    }
+
+    std::vector<std::uint8_t> EncodeEtc2(std::span<const RGBA> texels, Math::ivec2 size, Etc2Format format)
+    {
+        const auto* bytes       = reinterpret_cast<const std::uint8_t*>(texels.data());
+        const auto  block_bytes = Etc2BlockBytes(format);
+
+        std::vector<std::uint8_t> blocks(Etc2DataSize(size, format));
+        std::uint8_t*             out = blocks.data();
+        for (int by = 0; by < size.y; by += 4)
+        {
+            for (int bx = 0; bx < size.x; bx += 4)
+            {
+                // edge blocks repeat the last row and column, the extra texels are never sampled
+                Block block{};
+                for (int x = 0; x < 4; ++x)
+                {
+                    for (int y = 0; y < 4; ++y)
+                    {
+                        const int  sx    = std::min(bx + x, size.x - 1);
+                        const int  sy    = std::min(by + y, size.y - 1);
+                        const auto texel = (static_cast<std::size_t>(sy) * static_cast<std::size_t>(size.x) + static_cast<std::size_t>(sx)) * 4;
+                        auto&      dst   = block[static_cast<std::size_t>(texel_number(x, y))];
+                        for (int c = 0; c < 4; ++c)
+                            dst[static_cast<std::size_t>(c)] = bytes[texel + static_cast<std::size_t>(c)];
+                    }
+                }
+
+                if (format == Etc2Format::RGBA8)
+                {
+                    write_be64(out, encode_alpha(block));
+                    write_be64(out + 8, encode_color(block));
+                }
+                else
+                {
+                    write_be64(out, encode_color(block));
+                }
+                out += block_bytes;
+            }
+        }
+        return blocks;
+    }
+
+    std::optional<std::vector<RGBA>> DecodeEtc2(std::span<const std::uint8_t> blocks, Math::ivec2 size, Etc2Format format)
+    {
+        if (blocks.size() < Etc2DataSize(size, format))
+            return std::nullopt;
+
+        const auto         block_bytes = Etc2BlockBytes(format);
+        std::vector<RGBA>  texels(static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y));
+        auto*              out = reinterpret_cast<std::uint8_t*>(texels.data());
+        const std::uint8_t* in = blocks.data();
+        for (int by = 0; by < size.y; by += 4)
+        {
+            for (int bx = 0; bx < size.x; bx += 4)
+            {
+                Block block{};
+                for (auto& texel : block)
+                    texel[3] = 255;
+
+                if (format == Etc2Format::RGBA8)
+                {
+                    decode_alpha(read_be64(in), block);
+                    if (!decode_color(read_be64(in + 8), block))
+                        return std::nullopt;
+                }
+                else if (!decode_color(read_be64(in), block))
+                {
+                    return std::nullopt;
+                }
+                in += block_bytes;
+
+                for (int x = 0; x < 4 && bx + x < size.x; ++x)
+                {
+                    for (int y = 0; y < 4 && by + y < size.y; ++y)
+                    {
+                        const auto texel = (static_cast<std::size_t>(by + y) * static_cast<std::size_t>(size.x) + static_cast<std::size_t>(bx + x)) * 4;
+                        const auto& src  = block[static_cast<std::size_t>(texel_number(x, y))];
+                        for (int c = 0; c < 4; ++c)
+                            out[texel + static_cast<std::size_t>(c)] = static_cast<std::uint8_t>(src[static_cast<std::size_t>(c)]);
+                    }
+                }
+            }
+        }
+        return texels;
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Engine/Vec2.hpp"
+#include "Image.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace CS200
+{
+    /**
+     * \brief The two ETC2 block formats the engine uses, both core in OpenGL ES 3.0 and WebGL2
+     *
+     * RGB8 stores a 4x4 block of opaque texels in 8 bytes, 4 bits per texel
+     * instead of 32. RGBA8 adds an 8 byte EAC alpha block in front, 8 bits
+     * per texel.
+     */
+    enum class Etc2Format
+    {
+        RGB8,
+        RGBA8
+    };
+
+    [[nodiscard]] constexpr std::size_t Etc2BlockBytes(Etc2Format format) noexcept
+    {
+        return format == Etc2Format::RGB8 ? 8 : 16;
+    }
+
+    /**
+     * \brief Bytes of compressed data for an image, partial blocks at the edges count as whole ones
+     */
+    [[nodiscard]] std::size_t Etc2DataSize(Math::ivec2 size, Etc2Format format) noexcept;
+
+    /**
+     * \brief Whether any texel of the image has alpha below 255, RGB8 would lose it
+     */
+    [[nodiscard]] bool HasTranslucentTexels(const Image& image) noexcept;
+
+    /**
+     * \brief Compress an image into ETC2 blocks
+     * \param image Source texels, rows are encoded in the order they are stored
+     * \param format Block format to produce
+     * \return Blocks in row major order, Etc2DataSize() bytes
+     *
+     * Color blocks use the ETC1 compatible individual and differential modes
+     * of ETC2, trying both block orientations and all eight modifier tables
+     * per half block. Alpha blocks search every EAC table with the multiplier
+     * and base value fitted to the block's range. This is a straightforward
+     * offline encoder, not a fast one.
+     */
+    [[nodiscard]] std::vector<std::uint8_t> EncodeEtc2(const Image& image, Etc2Format format);
+
+    /**
+     * \brief Compress texels that did not come from a file, such as the levels of a mip chain
+     * \param texels size.x * size.y texels, rows are encoded in the order they are stored
+     */
+    [[nodiscard]] std::vector<std::uint8_t> EncodeEtc2(std::span<const RGBA> texels, Math::ivec2 size, Etc2Format format);
+
+    /**
+     * \brief Expand ETC2 blocks back into RGBA texels
+     * \param blocks Data produced by EncodeEtc2()
+     * \param size Image size in texels
+     * \param format Block format of the data
+     * \return Texels in the order the blocks were encoded, or nothing if a block uses the T, H or planar mode
+     *
+     * Used by cs200_compress_textures to measure the encoding error. Only the
+     * modes EncodeEtc2() writes are understood.
+     */
+    [[nodiscard]] std::optional<std::vector<RGBA>> DecodeEtc2(std::span<const std::uint8_t> blocks, Math::ivec2 size, Etc2Format format);
+}
@@ -10,27 +10,69 @@
 
 #include "Engine/Error.hpp"
 #include "Engine/Path.hpp"
+#include "ImageDecoder.hpp"
+#include "ImageProcessing.hpp"
 
+#include <fstream>
+#include <new>
 #include <stb_image.h>
+#include <utility>
+#include <vector>
 
 namespace CS200
 {
     Image::Image(const std::filesystem::path& image_path, bool flip_vertical)
     {
-        const std::filesystem::path path_image = assets::locate_asset(image_path);
+        // straight from the mapped asset pack when there is one, no file to open
+        if (const auto packed = assets::find_packed(image_path))
+        {
+            if (!decode(*packed, flip_vertical))
+            {
+                throw std::runtime_error("failed to load packed image : " + image_path.string());
+            }
+            return;
+        }
 
-        stbi_set_flip_vertically_on_load(flip_vertical);
-        int x = 0, y = 0;
-        int files_num_channels = 0;
-        constexpr int desired_channels = 4; // RGBA
+        const std::filesystem::path path_image = assets::locate_asset(image_path);
 
-        pixeldata = stbi_load(path_image.string().c_str(),&x,&y,&files_num_channels,desired_channels);
+        std::ifstream             file(path_image, std::ios::binary | std::ios::ate);
+        std::vector<std::uint8_t> encoded(file ? static_cast<std::size_t>(file.tellg()) : 0);
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
 
-        if(pixeldata == nullptr)
+        if(!file || !decode(encoded, flip_vertical))
         {
             throw std::runtime_error("failed to load image : " + path_image.string());
         }
-        size = {x,y};
+    }
+
+    bool Image::decode(std::span<const std::uint8_t> encoded, bool flip_vertical)
+    {
+        const auto& decoder = GetImageDecoder();
+        const auto  found   = decoder.ReadSize(encoded);
+        if (!found || found->x <= 0 || found->y <= 0)
+        {
+            return false;
+        }
+
+        const auto texel_count = static_cast<std::size_t>(found->x) * static_cast<std::size_t>(found->y);
+        pixeldata              = static_cast<unsigned char*>(::operator new[](texel_count * sizeof(RGBA), std::align_val_t{ ImageAlignment }));
+        size                   = *found;
+        const std::span<RGBA> texels(data(), texel_count);
+        if (!decoder.Decode(encoded, texels))
+        {
+            // the constructor throws next and no destructor runs for a half built Image, so free it here
+            ::operator delete[](pixeldata, std::align_val_t{ ImageAlignment });
+            pixeldata = nullptr;
+            size      = { 0, 0 };
+            return false;
+        }
+        // flipped here rather than by the decoder, stb's flip flag is shared state
+        if (flip_vertical)
+        {
+            ImageProcessing::FlipVertical(texels, size);
+        }
+        return true;
     }
 
    Image::Image(Image&& temporary) noexcept
@@ -43,10 +85,8 @@ namespace CS200
 
     Image& Image::operator=(Image&& temporary) noexcept
     {
-
-        pixeldata = std::move(temporary.pixeldata);
-
-        size = std::move(temporary.size);
+        std::swap(pixeldata, temporary.pixeldata);
+        std::swap(size, temporary.size);
         return *this;
     }
 
@@ -54,7 +94,7 @@ namespace CS200
     {
         if(pixeldata != nullptr)
         {
-             stbi_image_free(pixeldata);
+             ::operator delete[](pixeldata, std::align_val_t{ ImageAlignment });
         }
     }
 
@@ -74,6 +114,26 @@ namespace CS200
         return size;
     }
 
+    std::optional<Math::ivec2> Image::ReadSize(const std::filesystem::path& image_path)
+    {
+        int x = 0, y = 0, channels = 0;
+        if (const auto packed = assets::find_packed(image_path))
+        {
+            if (stbi_info_from_memory(packed->data(), static_cast<int>(packed->size()), &x, &y, &channels) == 0)
+            {
+                return std::nullopt;
+            }
+            return Math::ivec2{ x, y };
+        }
+
+        const std::filesystem::path path_image = assets::locate_asset(image_path);
+        if (stbi_info(path_image.string().c_str(), &x, &y, &channels) == 0)
+        {
+            return std::nullopt;
+        }
+        return Math::ivec2{ x, y };
+    }
+
 
 
 }
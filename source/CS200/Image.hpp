@@ -12,6 +12,9 @@
 #include "RGBA.hpp"
 #include <filesystem>
 #include <gsl/gsl>
+#include <cstdint>
+#include <optional>
+#include <span>
 
 namespace CS200
 {
@@ -23,7 +26,7 @@ namespace CS200
      * complexity of file loading, memory management, and data conversion.
      *
      * Key Features:
-     * - Automatic file loading using stb_image library
+     * - Automatic file loading using stb_image, or libspng for png files when built with CS200_USE_SPNG
      * - Always converts to consistent RGBA format (4 bytes per pixel)
      * - RAII memory management (automatic cleanup in destructor)
      * - Move-only semantics to prevent expensive copying
@@ -67,9 +70,9 @@ namespace CS200
          *
          * Implementation notes:
          * - Use assets::locate_asset() to find the full file path
-         * - Use stb_image library functions to load the image data
+         * - Decode with GetImageDecoder(), stb_image or libspng depending on the build
          * - Always load as 4-channel RGBA regardless of source format
-         * - Set stbi_set_flip_vertically_on_load() before loading
+         * - Flip with ImageProcessing::FlipVertical() after loading, stb's flip flag is shared state
          * - Throw an error if loading fails
          * - Store the loaded pixel data and image dimensions
          */
@@ -114,7 +117,7 @@ namespace CS200
          *
          * Implementation notes:
          * - Check if pixel data pointer is not nullptr
-         * - Use stbi_image_free() to properly release memory allocated by stb_image
+         * - The texels are ImageAlignment aligned, release them with the matching aligned delete
          */
         ~Image();
 
@@ -148,8 +151,20 @@ namespace CS200
          */
         Math::ivec2 GetSize() const noexcept;
 
+        /**
+         * \brief Read only the dimensions from an image file header
+         * \param image_path Path to the image file, resolved like the constructor does
+         * \return Width and height in pixels, or nothing if the file is not a readable image
+         *
+         * Much cheaper than loading the image, nothing is decoded. Lets a texture
+         * report its final size while the pixels are still being decoded.
+         */
+        static std::optional<Math::ivec2> ReadSize(const std::filesystem::path& image_path);
+
     private:
-        unsigned char * pixeldata = nullptr; //first pixel pointed to is the top left most pixel in image
+        bool decode(std::span<const std::uint8_t> encoded, bool flip_vertical);
+
+        unsigned char * pixeldata = nullptr; //first pixel pointed to is the top left most pixel in image, ImageAlignment aligned
         Math::ivec2 size {0,0};
         
     };
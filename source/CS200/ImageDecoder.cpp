@@ -0,0 +1,153 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "ImageDecoder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <stb_image.h>
+
+#if defined(CS200_USE_SPNG)
+#    include <spng.h>
+#endif
+
+namespace CS200
+{
+    namespace
+    {
+        class StbImageDecoder final : public ImageDecoder
+        {
+        public:
+            const char* GetName() const noexcept override
+            {
+                return "stb_image";
+            }
+
+            std::optional<Math::ivec2> ReadSize(std::span<const std::uint8_t> encoded) const override
+            {
+                int x = 0, y = 0, channels = 0;
+                if (stbi_info_from_memory(encoded.data(), static_cast<int>(encoded.size()), &x, &y, &channels) == 0)
+                {
+                    return std::nullopt;
+                }
+                return Math::ivec2{ x, y };
+            }
+
+            bool Decode(std::span<const std::uint8_t> encoded, std::span<RGBA> target) const override
+            {
+                // stb allocates the texels itself, so they take one copy to reach the caller's memory
+                int            x = 0, y = 0, channels = 0;
+                constexpr int  desired_channels = 4; // RGBA
+                unsigned char* texels           = stbi_load_from_memory(encoded.data(), static_cast<int>(encoded.size()), &x, &y, &channels, desired_channels);
+                if (texels == nullptr)
+                {
+                    return false;
+                }
+                const bool fits = static_cast<std::size_t>(x) * static_cast<std::size_t>(y) == target.size();
+                if (fits)
+                {
+                    std::memcpy(target.data(), texels, target.size_bytes());
+                }
+                stbi_image_free(texels);
+                return fits;
+            }
+        };
+
+#if defined(CS200_USE_SPNG)
+        bool is_png(std::span<const std::uint8_t> encoded) noexcept
+        {
+            constexpr std::array<std::uint8_t, 8> signature = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+            return encoded.size() >= signature.size() && std::equal(signature.begin(), signature.end(), encoded.begin());
+        }
+
+        using SpngContext = std::unique_ptr<spng_ctx, decltype(&spng_ctx_free)>;
+
+        SpngContext open_png(std::span<const std::uint8_t> encoded)
+        {
+            SpngContext context(spng_ctx_new(0), &spng_ctx_free);
+            if (context == nullptr)
+            {
+                return context;
+            }
+            // stb_image does not check chunk checksums either, and they cost a pass over every byte
+            spng_set_crc_action(context.get(), SPNG_CRC_USE, SPNG_CRC_USE);
+            if (spng_set_png_buffer(context.get(), encoded.data(), encoded.size()) != 0)
+            {
+                context.reset();
+            }
+            return context;
+        }
+
+        class SpngImageDecoder final : public ImageDecoder
+        {
+        public:
+            const char* GetName() const noexcept override
+            {
+                return "libspng";
+            }
+
+            std::optional<Math::ivec2> ReadSize(std::span<const std::uint8_t> encoded) const override
+            {
+                if (!is_png(encoded))
+                {
+                    return GetStbImageDecoder().ReadSize(encoded);
+                }
+                const auto context = open_png(encoded);
+                spng_ihdr  header{};
+                if (context == nullptr || spng_get_ihdr(context.get(), &header) != 0)
+                {
+                    return std::nullopt;
+                }
+                return Math::ivec2{ static_cast<int>(header.width), static_cast<int>(header.height) };
+            }
+
+            bool Decode(std::span<const std::uint8_t> encoded, std::span<RGBA> target) const override
+            {
+                if (!is_png(encoded))
+                {
+                    return GetStbImageDecoder().Decode(encoded, target);
+                }
+                const auto  context       = open_png(encoded);
+                std::size_t decoded_bytes = 0;
+                if (context == nullptr || spng_decoded_image_size(context.get(), SPNG_FMT_RGBA8, &decoded_bytes) != 0 || decoded_bytes != target.size_bytes())
+                {
+                    return false;
+                }
+                // tRNS turns into alpha like stb does; no gamma, stb does not apply it either
+                return spng_decode_image(context.get(), target.data(), target.size_bytes(), SPNG_FMT_RGBA8, SPNG_DECODE_TRNS) == 0;
+            }
+        };
+#endif
+    }
+
+    const ImageDecoder& GetStbImageDecoder() noexcept
+    {
+        static const StbImageDecoder decoder;
+        return decoder;
+    }
+
+    const ImageDecoder* GetSpngImageDecoder() noexcept
+    {
+#if defined(CS200_USE_SPNG)
+        static const SpngImageDecoder decoder;
+        return &decoder;
+#else
+        return nullptr;
+#endif
+    }
+
+    const ImageDecoder& GetImageDecoder() noexcept
+    {
+        if (const auto* spng = GetSpngImageDecoder())
+        {
+            return *spng;
+        }
+        return GetStbImageDecoder();
+    }
+}
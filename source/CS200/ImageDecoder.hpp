@@ -0,0 +1,72 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Engine/Vec2.hpp"
+#include "RGBA.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace CS200
+{
+    /**
+     * \brief Alignment of the texel buffers images decode into, a cache line and enough for any SIMD store
+     */
+    constexpr std::size_t ImageAlignment = 64;
+
+    /**
+     * \brief Turns the bytes of an image file into RGBA8 texels
+     *
+     * Decoders write into memory the caller owns, so CS200::Image decodes
+     * straight into its own aligned buffer and the bench tool can reuse one
+     * buffer for every run. Decoders hold no state; one object is shared by
+     * every thread.
+     *
+     * Which decoder CS200::Image uses is picked at build time, see
+     * GetImageDecoder().
+     */
+    class ImageDecoder
+    {
+    public:
+        virtual ~ImageDecoder() = default;
+
+        [[nodiscard]] virtual const char* GetName() const noexcept = 0;
+
+        /**
+         * \brief Width and height from the file header, nothing is decoded
+         * \return Nothing if the bytes are not an image this decoder reads
+         */
+        [[nodiscard]] virtual std::optional<Math::ivec2> ReadSize(std::span<const std::uint8_t> encoded) const = 0;
+
+        /**
+         * \brief Decode the whole image, top row first, R, G, B, A bytes per texel
+         * \param encoded The image file
+         * \param target Exactly width * height texels, preferably ImageAlignment aligned
+         * \return False if the file is damaged or its size does not match target
+         */
+        [[nodiscard]] virtual bool Decode(std::span<const std::uint8_t> encoded, std::span<RGBA> target) const = 0;
+    };
+
+    /**
+     * \brief stb_image, for every format it knows: png, jpg, bmp, tga, ...
+     */
+    [[nodiscard]] const ImageDecoder& GetStbImageDecoder() noexcept;
+
+    /**
+     * \brief libspng for png files, handing everything else to stb_image
+     * \return Null unless the build has CS200_USE_SPNG on
+     */
+    [[nodiscard]] const ImageDecoder* GetSpngImageDecoder() noexcept;
+
+    /**
+     * \brief The decoder CS200::Image uses: libspng when built with CS200_USE_SPNG, otherwise stb_image
+     */
+    [[nodiscard]] const ImageDecoder& GetImageDecoder() noexcept;
+}
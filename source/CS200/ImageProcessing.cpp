@@ -0,0 +1,208 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "ImageProcessing.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define CS200_IMAGE_SSE2 1
+#    include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    define CS200_IMAGE_NEON 1
+#    include <arm_neon.h>
+#endif
+
+namespace CS200::ImageProcessing
+{
+    namespace
+    {
+        // x * a / 255 rounded to nearest, exact for every pair of bytes
+        constexpr std::uint8_t multiply_255(unsigned x, unsigned a) noexcept
+        {
+            const unsigned t = x * a + 128u;
+            return static_cast<std::uint8_t>((t + (t >> 8)) >> 8);
+        }
+
+        void premultiply_scalar(std::uint8_t* bytes, std::size_t first, std::size_t count) noexcept
+        {
+            for (std::size_t i = first; i < count; ++i)
+            {
+                auto* texel = bytes + i * 4;
+                texel[0]    = multiply_255(texel[0], texel[3]);
+                texel[1]    = multiply_255(texel[1], texel[3]);
+                texel[2]    = multiply_255(texel[2], texel[3]);
+            }
+        }
+
+        // outputs first to half_x of one row, each the mean of a 2x2 box; columns past the edge repeat the last one
+        void downscale_row_scalar(const std::uint8_t* row0, const std::uint8_t* row1, std::uint8_t* out, int size_x, int first, int half_x) noexcept
+        {
+            for (int x = first; x < half_x; ++x)
+            {
+                const int column0 = std::min(x * 2, size_x - 1);
+                const int column1 = std::min(x * 2 + 1, size_x - 1);
+                for (int c = 0; c < 4; ++c)
+                {
+                    const unsigned sum = 0u + row0[column0 * 4 + c] + row0[column1 * 4 + c] + row1[column0 * 4 + c] + row1[column1 * 4 + c];
+                    out[x * 4 + c]     = static_cast<std::uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+
+        const std::uint8_t* source_row(const std::uint8_t* from, Math::ivec2 size, int y) noexcept
+        {
+            // a 1 texel tall source repeats its only row
+            return from + static_cast<std::size_t>(std::min(y, size.y - 1)) * static_cast<std::size_t>(size.x) * 4;
+        }
+    }
+
+    void FlipVertical(std::span<RGBA> texels, Math::ivec2 size) noexcept
+    {
+        const auto row_texels = static_cast<std::size_t>(size.x);
+        for (int top = 0, bottom = size.y - 1; top < bottom; ++top, --bottom)
+        {
+            auto* top_row    = texels.data() + static_cast<std::size_t>(top) * row_texels;
+            auto* bottom_row = texels.data() + static_cast<std::size_t>(bottom) * row_texels;
+            std::swap_ranges(top_row, top_row + row_texels, bottom_row); // plain loads and stores, the compiler widens them
+        }
+    }
+
+    void PremultiplyAlpha(std::span<RGBA> texels) noexcept
+    {
+        auto*             bytes = reinterpret_cast<std::uint8_t*>(texels.data());
+        const std::size_t count = texels.size();
+        std::size_t       i     = 0;
+#if defined(CS200_IMAGE_SSE2)
+        // 4 texels per step, widened to 16 bits; the alpha lanes are multiplied by 255, which leaves them as they were
+        const __m128i zero       = _mm_setzero_si128();
+        const __m128i rgb_lanes  = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+        const __m128i keep_alpha = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+        const __m128i rounding   = _mm_set1_epi16(128);
+        const auto    multiply   = [&](__m128i channels)
+        {
+            __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(channels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            alpha         = _mm_or_si128(_mm_and_si128(alpha, rgb_lanes), keep_alpha);
+            const __m128i t = _mm_add_epi16(_mm_mullo_epi16(channels, alpha), rounding);
+            return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+        };
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128i texel4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i * 4));
+            const __m128i low    = multiply(_mm_unpacklo_epi8(texel4, zero));
+            const __m128i high   = multiply(_mm_unpackhi_epi8(texel4, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes + i * 4), _mm_packus_epi16(low, high));
+        }
+#elif defined(CS200_IMAGE_NEON)
+        // 16 texels per step, split into one register per channel by the interleaved load
+        const auto multiply = [](uint8x16_t channel, uint8x16_t alpha)
+        {
+            const uint16x8_t low  = vmull_u8(vget_low_u8(channel), vget_low_u8(alpha));
+            const uint16x8_t high = vmull_u8(vget_high_u8(channel), vget_high_u8(alpha));
+            return vcombine_u8(vraddhn_u16(low, vrshrq_n_u16(low, 8)), vraddhn_u16(high, vrshrq_n_u16(high, 8)));
+        };
+        for (; i + 16 <= count; i += 16)
+        {
+            uint8x16x4_t texel16 = vld4q_u8(bytes + i * 4);
+            texel16.val[0]       = multiply(texel16.val[0], texel16.val[3]);
+            texel16.val[1]       = multiply(texel16.val[1], texel16.val[3]);
+            texel16.val[2]       = multiply(texel16.val[2], texel16.val[3]);
+            vst4q_u8(bytes + i * 4, texel16);
+        }
+#endif
+        premultiply_scalar(bytes, i, count);
+    }
+
+    Math::ivec2 Downscale2x(std::span<const RGBA> source, Math::ivec2 size, std::span<RGBA> target) noexcept
+    {
+        const Math::ivec2 half{ std::max(size.x / 2, 1), std::max(size.y / 2, 1) };
+        const auto*       from = reinterpret_cast<const std::uint8_t*>(source.data());
+        auto*             to   = reinterpret_cast<std::uint8_t*>(target.data());
+        // outputs whose box has two real columns; the rest repeat the last column
+        const int paired = size.x >= 2 ? size.x / 2 : 0;
+
+        for (int y = 0; y < half.y; ++y)
+        {
+            const auto* row0 = source_row(from, size, y * 2);
+            const auto* row1 = source_row(from, size, y * 2 + 1);
+            auto*       out  = to + static_cast<std::size_t>(y) * static_cast<std::size_t>(half.x) * 4;
+            int         x    = 0;
+#if defined(CS200_IMAGE_SSE2)
+            // 2 outputs per step from 4 texels of each row
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i two  = _mm_set1_epi16(2);
+            for (; x + 2 <= paired; x += 2)
+            {
+                const __m128i upper = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8));
+                const __m128i lower = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8));
+                const __m128i left  = _mm_add_epi16(_mm_unpacklo_epi8(upper, zero), _mm_unpacklo_epi8(lower, zero));
+                const __m128i right = _mm_add_epi16(_mm_unpackhi_epi8(upper, zero), _mm_unpackhi_epi8(lower, zero));
+                const __m128i sums  = _mm_unpacklo_epi64(_mm_add_epi16(left, _mm_srli_si128(left, 8)), _mm_add_epi16(right, _mm_srli_si128(right, 8)));
+                const __m128i means = _mm_srli_epi16(_mm_add_epi16(sums, two), 2);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(out + x * 4), _mm_packus_epi16(means, means));
+            }
+#elif defined(CS200_IMAGE_NEON)
+            for (; x + 2 <= paired; x += 2)
+            {
+                const uint8x16_t upper = vld1q_u8(row0 + x * 8);
+                const uint8x16_t lower = vld1q_u8(row1 + x * 8);
+                const uint16x8_t left  = vaddl_u8(vget_low_u8(upper), vget_low_u8(lower));
+                const uint16x8_t right = vaddl_u8(vget_high_u8(upper), vget_high_u8(lower));
+                const uint16x8_t sums  = vcombine_u16(vadd_u16(vget_low_u16(left), vget_high_u16(left)), vadd_u16(vget_low_u16(right), vget_high_u16(right)));
+                vst1_u8(out + x * 4, vrshrn_n_u16(sums, 2));
+            }
+#endif
+            downscale_row_scalar(row0, row1, out, size.x, x, half.x);
+        }
+        return half;
+    }
+
+    bool MatchesScalar()
+    {
+        // every pair of color and alpha byte, then the same bytes again as images of awkward sizes
+        std::vector<RGBA> texels(256 * 256);
+        auto*             bytes = reinterpret_cast<std::uint8_t*>(texels.data());
+        for (std::size_t i = 0; i < texels.size(); ++i)
+        {
+            bytes[i * 4 + 0] = static_cast<std::uint8_t>(i);
+            bytes[i * 4 + 1] = static_cast<std::uint8_t>(255 - (i & 255));
+            bytes[i * 4 + 2] = static_cast<std::uint8_t>((i * 7) ^ (i >> 8));
+            bytes[i * 4 + 3] = static_cast<std::uint8_t>(i >> 8);
+        }
+
+        auto premultiplied = texels;
+        PremultiplyAlpha(premultiplied);
+        auto expected = texels;
+        premultiply_scalar(reinterpret_cast<std::uint8_t*>(expected.data()), 0, expected.size());
+        if (premultiplied != expected)
+        {
+            return false;
+        }
+
+        for (const Math::ivec2 size : { Math::ivec2{ 256, 256 }, Math::ivec2{ 255, 257 }, Math::ivec2{ 37, 11 }, Math::ivec2{ 1, 64 }, Math::ivec2{ 64, 1 } })
+        {
+            const std::span<const RGBA> source(texels.data(), static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y));
+            const Math::ivec2           half{ std::max(size.x / 2, 1), std::max(size.y / 2, 1) };
+            std::vector<RGBA>           result(static_cast<std::size_t>(half.x) * static_cast<std::size_t>(half.y));
+            std::vector<RGBA>           reference(result.size());
+            Downscale2x(source, size, result);
+            for (int y = 0; y < half.y; ++y)
+            {
+                auto* out = reinterpret_cast<std::uint8_t*>(reference.data()) + static_cast<std::size_t>(y) * static_cast<std::size_t>(half.x) * 4;
+                downscale_row_scalar(source_row(bytes, size, y * 2), source_row(bytes, size, y * 2 + 1), out, size.x, 0, half.x);
+            }
+            if (result != reference)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
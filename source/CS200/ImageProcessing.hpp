@@ -0,0 +1,74 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Engine/Vec2.hpp"
+#include "RGBA.hpp"
+#include <span>
+
+namespace CS200
+{
+    /**
+     * \brief Steps run on decoded images before they are uploaded
+     *
+     * Every function works on RGBA8 texels in the byte order images are
+     * decoded in (R, G, B, A in memory), touches nothing but its arguments,
+     * and so can run on the TextureManager worker threads next to the
+     * decoder. The inner loops use SSE2 on x86 and NEON on ARM, picked at
+     * compile time, with a scalar loop for other targets and for the tail
+     * that does not fill a whole register. All builds give the same bytes.
+     */
+    namespace ImageProcessing
+    {
+        /**
+         * \brief Turn an image upside down in place
+         * \param texels size.x * size.y texels in row major order
+         * \param size Size of the image
+         *
+         * OpenGL wants the bottom row first and images are stored top row
+         * first. Rows are swapped whole, so this runs at copy speed; it
+         * replaces stb_image's flip flag, which is global state.
+         */
+        void FlipVertical(std::span<RGBA> texels, Math::ivec2 size) noexcept;
+
+        /**
+         * \brief Multiply red, green and blue by alpha, rounded, alpha unchanged
+         *
+         * Premultiplied texels filter and blend without dark fringes around
+         * transparent edges. Draw them with GL_ONE, GL_ONE_MINUS_SRC_ALPHA.
+         */
+        void PremultiplyAlpha(std::span<RGBA> texels) noexcept;
+
+        /**
+         * \brief Halve an image with a plain 2x2 box average of all four channels
+         * \param source size.x * size.y texels in row major order
+         * \param size Size of the source
+         * \param target Room for max(size / 2, 1) texels, the size OpenGL expects for the next mip level
+         * \return Size of the result
+         *
+         * The right average for premultiplied and for fully opaque images;
+         * on opaque ones it gives the same bytes as DownsampleBox(), which
+         * BuildMipChain() relies on to take this path for them. Straight
+         * alpha images with transparency need DownsampleBox(), which weights
+         * colors by alpha. On odd sizes the last row or column is dropped; a
+         * 1 texel wide or tall source keeps its only column or row.
+         */
+        Math::ivec2 Downscale2x(std::span<const RGBA> source, Math::ivec2 size, std::span<RGBA> target) noexcept;
+
+        /**
+         * \brief Run the SSE2 or NEON loops and the scalar loop on the same images and compare
+         * \return True when every function above gives the scalar bytes, always true on scalar builds
+         *
+         * Covers every pair of color and alpha byte and odd, 1 texel wide and
+         * 1 texel tall sizes; takes a few milliseconds. The asset tools run it
+         * before writing anything, so a wrong vector path fails loudly instead
+         * of baking bad texels.
+         */
+        [[nodiscard]] bool MatchesScalar();
+    }
+}
@@ -27,7 +27,7 @@ namespace CS200
           shader(std::move(other.shader)),
           view_projection(other.view_projection),
 
-        SDF_shader(std::move(other.SDF_shader)),
+        SDF_shaders(std::move(other.SDF_shaders)),
         SDF_vertex_array(other.SDF_vertex_array),
         SDF_buffer(other.SDF_buffer),
         SDF_index(other.SDF_index),
@@ -41,7 +41,7 @@ namespace CS200
         other.camera_uniform_buffer = 0;
         other.SDF_buffer = 0;
         other.shader = OpenGL::CompiledShader{};
-        other.SDF_shader = OpenGL::CompiledShader{};
+        other.SDF_shaders = {};
         other.view_projection.Reset();
     }
 
@@ -59,7 +59,7 @@ namespace CS200
             std::swap(shader, other.shader);
             std::swap(view_projection, other.view_projection);
 
-            std::swap(SDF_shader, other.SDF_shader);
+            std::swap(SDF_shaders, other.SDF_shaders);
             std::swap(SDF_buffer,other.SDF_buffer);
         }
         return *this;
@@ -74,7 +74,11 @@ namespace CS200
 
     void ImmediateRenderer2D::Init()
     {
-        SDF_shader = OpenGL::CreateShader(assets::locate_asset("Assets/shaders/ImmediateRenderer2D/sdf.vert"), assets::locate_asset("Assets/shaders/ImmediateRenderer2D/sdf.frag"));
+        // one branch-free program per shape instead of switching on a uniform in sdf.frag
+        SDF_shaders[static_cast<std::size_t>(SDFShape::Circle)] = OpenGL::CreateShader(
+            assets::locate_asset("Assets/shaders/ImmediateRenderer2D/sdf.vert"), assets::locate_asset("Assets/shaders/ImmediateRenderer2D/sdf.frag"), { "SDF_SHAPE_CIRCLE" });
+        SDF_shaders[static_cast<std::size_t>(SDFShape::Rectangle)] = OpenGL::CreateShader(
+            assets::locate_asset("Assets/shaders/ImmediateRenderer2D/sdf.vert"), assets::locate_asset("Assets/shaders/ImmediateRenderer2D/sdf.frag"), { "SDF_SHAPE_RECTANGLE" });
         const GLuint SDF_indices[] = { 0, 1, 2, 2, 3, 0 };
 
         const float SDF_vertices[] = 
@@ -155,7 +159,10 @@ namespace CS200
         GL::BindBufferBase(GL_UNIFORM_BUFFER, 0, camera_uniform_buffer);
         OpenGL::BindUniformBufferToShader(shader.Shader, 0, camera_uniform_buffer, "Camera");
 
-        OpenGL::BindUniformBufferToShader(SDF_shader.Shader, 0, camera_uniform_buffer, "Camera");
+        for (const auto& SDF_shader : SDF_shaders)
+        {
+            OpenGL::BindUniformBufferToShader(SDF_shader.Shader, 0, camera_uniform_buffer, "Camera");
+        }
 
         GL::BindBuffer(GL_UNIFORM_BUFFER, 0);
     }
@@ -201,8 +208,11 @@ namespace CS200
 
         OpenGL::DestroyShader(shader);
         shader = OpenGL::CompiledShader{};
-        OpenGL::DestroyShader(SDF_shader);
-        SDF_shader = OpenGL::CompiledShader{};
+        for (auto& SDF_shader : SDF_shaders)
+        {
+            OpenGL::DestroyShader(SDF_shader);
+            SDF_shader = OpenGL::CompiledShader{};
+        }
     }
 
 
@@ -276,6 +286,7 @@ namespace CS200
     }
     void ImmediateRenderer2D::DrawSDF(const Math::TransformationMatrix& transform, CS200::RGBA fill_color, CS200::RGBA line_color, double line_width, SDFShape sdf_shape)
     {
+        const auto& SDF_shader = SDF_shaders[static_cast<std::size_t>(sdf_shape)];
         GL::UseProgram(SDF_shader.Shader);
         
         SDF_transform = Renderer2DUtils::CalculateSDFTransform(transform,line_width);
@@ -299,10 +310,6 @@ namespace CS200
             auto c = unpack_color(line_color);
             GL::Uniform4f(SDF_shader.UniformLocations.at("outline_color"), c[0], c[1], c[2], c[3]);
         }
-        if (SDF_shader.UniformLocations.contains("shapetype"))
-        {
-            GL::Uniform1i(SDF_shader.UniformLocations.at("shapetype"),static_cast<GLint>(sdf_shape));
-        }
         if (SDF_shader.UniformLocations.contains("uLineWidth"))
         {
             GL::Uniform1f(SDF_shader.UniformLocations.at("uLineWidth"),static_cast<float>(line_width));
@@ -260,7 +260,7 @@ namespace CS200
         void DrawLine(Math::vec2 start_point, Math::vec2 end_point, CS200::RGBA line_color, double line_width) override;
 
     private:
-        // SDF Shape identifiers - must be kept in sync with sdf.frag shader
+        // SDF Shape identifiers - index into SDF_shaders, one sdf.frag variant per shape
         enum class SDFShape : uint8_t
         {
             Circle    = 0,
@@ -277,7 +277,7 @@ namespace CS200
          *
          * Implementation notes:
          * - Calculate SDF-specific transform using Renderer2DUtils::CalculateSDFTransform()
-         * - Set all SDF shader uniforms (model, colors, size, line width, shape type)
+         * - Pick the SDF shader variant compiled for sdf_shape and set its uniforms (model, colors, size, line width)
          * - Use SDF vertex array and draw triangles
          * - Shape rendering handled entirely in fragment shader
          */
@@ -294,7 +294,7 @@ namespace CS200
         // --- Cached view-projection matrix ---
         Math::TransformationMatrix view_projection;
         
-        OpenGL::CompiledShader SDF_shader;
+        std::array<OpenGL::CompiledShader, 2> SDF_shaders;
         GLuint SDF_vertex_array  = 0;
 
         GLuint SDF_buffer = 0;
@@ -0,0 +1,261 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "Ktx2.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <gsl/gsl>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    constexpr std::array<std::uint8_t, 12> Identifier = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+    // VkFormat values, KTX2 names formats the way Vulkan does
+    constexpr std::uint32_t VkFormatEtc2Rgb8  = 147; // VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+    constexpr std::uint32_t VkFormatEtc2Rgba8 = 151; // VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+
+    constexpr std::string_view OrientationKey = "KTXorientation";
+    constexpr std::string_view OrientationUp  = "ru";
+    constexpr std::string_view SourceKey      = "CS200sourceHash";
+
+    struct Header
+    {
+        std::uint8_t  Identifier[12];
+        std::uint32_t VkFormat;
+        std::uint32_t TypeSize;
+        std::uint32_t PixelWidth;
+        std::uint32_t PixelHeight;
+        std::uint32_t PixelDepth;
+        std::uint32_t LayerCount;
+        std::uint32_t FaceCount;
+        std::uint32_t LevelCount;
+        std::uint32_t SupercompressionScheme;
+        std::uint32_t DfdByteOffset;
+        std::uint32_t DfdByteLength;
+        std::uint32_t KvdByteOffset;
+        std::uint32_t KvdByteLength;
+        std::uint64_t SgdByteOffset;
+        std::uint64_t SgdByteLength;
+    };
+    static_assert(sizeof(Header) == 80);
+
+    struct LevelIndex
+    {
+        std::uint64_t ByteOffset;
+        std::uint64_t ByteLength;
+        std::uint64_t UncompressedByteLength;
+    };
+
+    std::uint32_t align_up(std::uint32_t value, std::uint32_t alignment) noexcept
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    void append_u32(std::vector<std::uint8_t>& out, std::uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+            out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+    }
+
+    // Khronos basic data format descriptor for the ETC2 color model
+    std::vector<std::uint8_t> make_dfd(CS200::Etc2Format format)
+    {
+        constexpr std::uint32_t ModelEtc2       = 161;
+        constexpr std::uint32_t PrimariesBt709  = 1;
+        constexpr std::uint32_t TransferLinear  = 1;
+        constexpr std::uint32_t ChannelColor    = 2;
+        constexpr std::uint32_t ChannelAlpha    = 15;
+        const bool              has_alpha       = format == CS200::Etc2Format::RGBA8;
+        const std::uint32_t     samples         = has_alpha ? 2 : 1;
+        const std::uint32_t     block_size      = 24 + 16 * samples;
+
+        std::vector<std::uint8_t> dfd;
+        append_u32(dfd, 4 + block_size);
+        append_u32(dfd, 0);                            // Khronos vendor, basic descriptor type
+        append_u32(dfd, 2 | (block_size << 16));       // version 1.3 of the descriptor block
+        append_u32(dfd, ModelEtc2 | (PrimariesBt709 << 8) | (TransferLinear << 16));
+        append_u32(dfd, 3 | (3 << 8));                 // 4x4 texel blocks
+        append_u32(dfd, static_cast<std::uint32_t>(CS200::Etc2BlockBytes(format)));
+        append_u32(dfd, 0);
+
+        const auto add_sample = [&](std::uint32_t bit_offset, std::uint32_t channel)
+        {
+            append_u32(dfd, bit_offset | (63u << 16) | (channel << 24));
+            append_u32(dfd, 0);
+            append_u32(dfd, 0);
+            append_u32(dfd, 0xFFFFFFFFu);
+        };
+        if (has_alpha)
+        {
+            add_sample(0, ChannelAlpha);
+            add_sample(64, ChannelColor);
+        }
+        else
+        {
+            add_sample(0, ChannelColor);
+        }
+        return dfd;
+    }
+
+    void append_key_value(std::vector<std::uint8_t>& out, std::string_view key, std::string_view value)
+    {
+        append_u32(out, static_cast<std::uint32_t>(key.size() + 1 + value.size() + 1));
+        out.insert(out.end(), key.begin(), key.end());
+        out.push_back(0);
+        out.insert(out.end(), value.begin(), value.end());
+        out.push_back(0);
+        while (out.size() % 4 != 0)
+            out.push_back(0);
+    }
+}
+
+namespace CS200
+{
+    bool WriteKtx2(const std::filesystem::path& path, const Ktx2Texture& texture)
+    {
+        const auto dfd = make_dfd(texture.Format);
+
+        // keys must be sorted by their byte values
+        std::vector<std::uint8_t> kvd;
+        append_key_value(kvd, SourceKey, std::to_string(texture.SourceHash));
+        append_key_value(kvd, OrientationKey, OrientationUp);
+
+        // level 0 first in the index, smallest level first in the file
+        std::vector<const std::vector<std::uint8_t>*> levels{ &texture.Data };
+        for (const auto& level : texture.MipLevels)
+            levels.push_back(&level);
+
+        Header header{};
+        std::memcpy(header.Identifier, Identifier.data(), Identifier.size());
+        header.VkFormat      = texture.Format == Etc2Format::RGB8 ? VkFormatEtc2Rgb8 : VkFormatEtc2Rgba8;
+        header.TypeSize      = 1;
+        header.PixelWidth    = static_cast<std::uint32_t>(texture.Size.x);
+        header.PixelHeight   = static_cast<std::uint32_t>(texture.Size.y);
+        header.FaceCount     = 1;
+        header.LevelCount    = static_cast<std::uint32_t>(levels.size());
+        header.DfdByteOffset = static_cast<std::uint32_t>(sizeof(Header) + sizeof(LevelIndex) * levels.size());
+        header.DfdByteLength = static_cast<std::uint32_t>(dfd.size());
+        header.KvdByteOffset = header.DfdByteOffset + header.DfdByteLength;
+        header.KvdByteLength = static_cast<std::uint32_t>(kvd.size());
+
+        // level data starts on a multiple of the block size
+        const auto              block_bytes = static_cast<std::uint32_t>(Etc2BlockBytes(texture.Format));
+        std::vector<LevelIndex> index(levels.size());
+        std::uint32_t           offset = header.KvdByteOffset + header.KvdByteLength;
+        for (std::size_t i = levels.size(); i-- > 0;)
+        {
+            offset   = align_up(offset, block_bytes);
+            index[i] = { offset, levels[i]->size(), levels[i]->size() };
+            offset += static_cast<std::uint32_t>(levels[i]->size());
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(sizeof(LevelIndex) * index.size()));
+        file.write(reinterpret_cast<const char*>(dfd.data()), static_cast<std::streamsize>(dfd.size()));
+        file.write(reinterpret_cast<const char*>(kvd.data()), static_cast<std::streamsize>(kvd.size()));
+        std::uint64_t written = header.KvdByteOffset + header.KvdByteLength;
+        for (std::size_t i = levels.size(); i-- > 0;)
+        {
+            const std::vector<char> padding(gsl::narrow<std::size_t>(index[i].ByteOffset - written), 0);
+            file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+            file.write(reinterpret_cast<const char*>(levels[i]->data()), static_cast<std::streamsize>(levels[i]->size()));
+            written = index[i].ByteOffset + index[i].ByteLength;
+        }
+        return static_cast<bool>(file);
+    }
+
+    std::optional<Ktx2Texture> ReadKtx2(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return std::nullopt;
+
+        Header header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || !std::equal(Identifier.begin(), Identifier.end(), header.Identifier))
+            return std::nullopt;
+        if (header.VkFormat != VkFormatEtc2Rgb8 && header.VkFormat != VkFormatEtc2Rgba8)
+            return std::nullopt;
+        if (header.PixelDepth != 0 || header.LayerCount > 1 || header.FaceCount != 1 || header.LevelCount > 15 || header.SupercompressionScheme != 0)
+            return std::nullopt;
+        if (header.PixelWidth == 0 || header.PixelHeight == 0 || header.PixelWidth > 16384 || header.PixelHeight > 16384)
+            return std::nullopt;
+
+        // a level count of 0 asks the loader to generate mipmaps, only level 0 is stored then
+        std::vector<LevelIndex> index(std::max(header.LevelCount, 1u));
+        file.read(reinterpret_cast<char*>(index.data()), static_cast<std::streamsize>(sizeof(LevelIndex) * index.size()));
+        if (!file)
+            return std::nullopt;
+
+        Ktx2Texture texture;
+        texture.Format = header.VkFormat == VkFormatEtc2Rgb8 ? Etc2Format::RGB8 : Etc2Format::RGBA8;
+        texture.Size   = { static_cast<int>(header.PixelWidth), static_cast<int>(header.PixelHeight) };
+        if (header.KvdByteLength > 65536)
+            return std::nullopt;
+        Math::ivec2 level_size = texture.Size;
+        for (const auto& level : index)
+        {
+            if (level.ByteLength != Etc2DataSize(level_size, texture.Format))
+                return std::nullopt;
+            level_size = { std::max(level_size.x / 2, 1), std::max(level_size.y / 2, 1) };
+        }
+
+        std::vector<char> kvd(header.KvdByteLength);
+        file.seekg(header.KvdByteOffset);
+        file.read(kvd.data(), static_cast<std::streamsize>(kvd.size()));
+        if (!file)
+            return std::nullopt;
+
+        bool        bottom_up = false;
+        std::size_t at        = 0;
+        while (at + 4 <= kvd.size())
+        {
+            std::uint32_t length = 0;
+            std::memcpy(&length, kvd.data() + at, 4);
+            at += 4;
+            if (length > kvd.size() - at)
+                return std::nullopt;
+
+            const std::string_view entry(kvd.data() + at, length);
+            const auto             split = entry.find('\0');
+            if (split != std::string_view::npos)
+            {
+                const auto key   = entry.substr(0, split);
+                auto       value = entry.substr(split + 1);
+                value            = value.substr(0, value.find('\0'));
+                if (key == OrientationKey)
+                    bottom_up = value.size() >= 2 && value[1] == 'u';
+                else if (key == SourceKey)
+                    std::from_chars(value.data(), value.data() + value.size(), texture.SourceHash);
+            }
+            at = align_up(static_cast<std::uint32_t>(at + length), 4);
+        }
+        if (!bottom_up)
+            return std::nullopt;
+
+        texture.MipLevels.resize(index.size() - 1);
+        for (std::size_t i = 0; i < index.size(); ++i)
+        {
+            auto& data = i == 0 ? texture.Data : texture.MipLevels[i - 1];
+            data.resize(gsl::narrow<std::size_t>(index[i].ByteLength));
+            file.seekg(static_cast<std::streamoff>(index[i].ByteOffset));
+            file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            if (!file)
+                return std::nullopt;
+        }
+        return texture;
+    }
+}
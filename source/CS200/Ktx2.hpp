@@ -0,0 +1,51 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Engine/Vec2.hpp"
+#include "Etc2.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace CS200
+{
+    /**
+     * \brief Compressed texture data as stored in a KTX2 file
+     *
+     * Only what the engine writes is supported: a single 2D image without
+     * supercompression, in one of the Etc2Format block formats, optionally
+     * with a full or partial mip chain cooked by the offline tool.
+     *
+     * The blocks are stored bottom row first, the order OpenGL expects, and
+     * the file says so with KTXorientation "ru". Compressed blocks cannot be
+     * flipped after the fact, so files with the default top-down orientation
+     * are rejected rather than shown upside down.
+     */
+    struct Ktx2Texture
+    {
+        Etc2Format                Format = Etc2Format::RGBA8;
+        Math::ivec2               Size{ 0, 0 };
+        std::uint64_t             SourceHash = 0; ///< assets::hash_bytes() of the png the data was made from, to detect stale files
+        std::vector<std::uint8_t> Data;                    ///< Level 0
+        std::vector<std::vector<std::uint8_t>> MipLevels; ///< Levels 1, 2, ... each half the size of the previous, empty without mipmaps
+    };
+
+    /**
+     * \brief Write a texture as a KTX2 file with a data format descriptor and orientation metadata
+     * \return False if the file cannot be written
+     */
+    bool WriteKtx2(const std::filesystem::path& path, const Ktx2Texture& texture);
+
+    /**
+     * \brief Read a KTX2 file written by WriteKtx2()
+     * \return Nothing if the file is missing, damaged, top-down, or uses a format or feature the engine does not load
+     */
+    [[nodiscard]] std::optional<Ktx2Texture> ReadKtx2(const std::filesystem::path& path);
+}
@@ -0,0 +1,90 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "MipChain.hpp"
+
+#include "ImageProcessing.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace CS200
+{
+    MipLevel DownsampleBox(std::span<const RGBA> texels, Math::ivec2 size)
+    {
+        MipLevel level;
+        level.Size = { std::max(size.x / 2, 1), std::max(size.y / 2, 1) };
+        level.Texels.resize(static_cast<std::size_t>(level.Size.x) * static_cast<std::size_t>(level.Size.y));
+
+        const auto* source = reinterpret_cast<const std::uint8_t*>(texels.data());
+        auto*       target = reinterpret_cast<std::uint8_t*>(level.Texels.data());
+        for (int y = 0; y < level.Size.y; ++y)
+        {
+            // a 1 texel wide or tall source repeats its only row or column
+            const int rows[2] = { std::min(y * 2, size.y - 1), std::min(y * 2 + 1, size.y - 1) };
+            for (int x = 0; x < level.Size.x; ++x)
+            {
+                const int    columns[2] = { std::min(x * 2, size.x - 1), std::min(x * 2 + 1, size.x - 1) };
+                unsigned int color[3]   = { 0, 0, 0 };
+                unsigned int plain[3]   = { 0, 0, 0 };
+                unsigned int alpha      = 0;
+                for (const int row : rows)
+                {
+                    for (const int column : columns)
+                    {
+                        const auto* texel = source + (static_cast<std::size_t>(row) * static_cast<std::size_t>(size.x) + static_cast<std::size_t>(column)) * 4;
+                        for (int c = 0; c < 3; ++c)
+                        {
+                            color[c] += texel[c] * texel[3];
+                            plain[c] += texel[c];
+                        }
+                        alpha += texel[3];
+                    }
+                }
+
+                auto* out = target + (static_cast<std::size_t>(y) * static_cast<std::size_t>(level.Size.x) + static_cast<std::size_t>(x)) * 4;
+                for (int c = 0; c < 3; ++c)
+                {
+                    // fully transparent boxes keep their plain average so the next level still has a color
+                    out[c] = static_cast<std::uint8_t>(alpha > 0 ? (color[c] + alpha / 2) / alpha : (plain[c] + 2) / 4);
+                }
+                out[3] = static_cast<std::uint8_t>((alpha + 2) / 4);
+            }
+        }
+        return level;
+    }
+
+    std::vector<MipLevel> BuildMipChain(std::span<const RGBA> texels, Math::ivec2 size)
+    {
+        // with every alpha 255 the weighted average is the plain one, which has a vector path; opaque levels stay opaque
+        const auto* bytes  = reinterpret_cast<const std::uint8_t*>(texels.data());
+        bool        opaque = true;
+        for (std::size_t i = 0; i < texels.size() && opaque; ++i)
+        {
+            opaque = bytes[i * 4 + 3] == 255;
+        }
+
+        std::vector<MipLevel> levels;
+        while (size.x > 1 || size.y > 1)
+        {
+            const auto source = levels.empty() ? texels : std::span<const RGBA>(levels.back().Texels);
+            if (opaque)
+            {
+                MipLevel level;
+                level.Texels.resize(static_cast<std::size_t>(std::max(size.x / 2, 1)) * static_cast<std::size_t>(std::max(size.y / 2, 1)));
+                level.Size = ImageProcessing::Downscale2x(source, size, level.Texels);
+                levels.push_back(std::move(level));
+            }
+            else
+            {
+                levels.push_back(DownsampleBox(source, size));
+            }
+            size = levels.back().Size;
+        }
+        return levels;
+    }
+}
@@ -0,0 +1,52 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Engine/Vec2.hpp"
+#include "RGBA.hpp"
+#include <span>
+#include <vector>
+
+namespace CS200
+{
+    /**
+     * \brief One level of a mip chain built on the CPU
+     */
+    struct MipLevel
+    {
+        Math::ivec2       Size{ 0, 0 };
+        std::vector<RGBA> Texels;
+    };
+
+    /**
+     * \brief Halve an image with a 2x2 box filter
+     * \param texels size.x * size.y texels in row major order
+     * \param size Size of the source image
+     * \return The image at max(size / 2, 1), the size OpenGL expects for the next mip level
+     *
+     * Colors are averaged weighted by alpha, so fully transparent texels,
+     * whose color is whatever the paint program left there, do not bleed a
+     * dark or colored fringe into the edges of sprites. On odd sizes the last
+     * row or column is dropped, the way the level sizes OpenGL expects round.
+     */
+    [[nodiscard]] MipLevel DownsampleBox(std::span<const RGBA> texels, Math::ivec2 size);
+
+    /**
+     * \brief Every level below the given one, down to 1x1
+     * \param texels Level 0 texels in row major order
+     * \param size Size of level 0
+     * \return Levels 1, 2, ... in order, empty for a 1x1 image
+     *
+     * For assets cooked offline, where the levels are compressed afterwards
+     * and glGenerateMipmap cannot be used. Textures uploaded as RGBA8 get their
+     * chain from OpenGL::GenerateMipmaps() instead. Fully opaque images are
+     * halved by ImageProcessing::Downscale2x(), the same bytes DownsampleBox()
+     * would give, only faster.
+     */
+    [[nodiscard]] std::vector<MipLevel> BuildMipChain(std::span<const RGBA> texels, Math::ivec2 size);
+}
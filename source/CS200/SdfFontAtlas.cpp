@@ -0,0 +1,243 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "SdfFontAtlas.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+    constexpr std::uint32_t SdfMagic   = 0x44535343; // "CSSD"
+    constexpr std::uint32_t SdfVersion = 2; // 1 stored the png's byte count
+
+    struct SdfFileHeader
+    {
+        std::uint32_t Magic;
+        std::uint32_t Version;
+        std::uint64_t SourceHash;
+        std::int32_t  Width;
+        std::int32_t  Height;
+        std::int32_t  Spread;
+        std::int32_t  GlyphCount;
+    };
+
+    struct GlyphRecord
+    {
+        std::int32_t X, Y, Width, Height;
+        std::int32_t SourceWidth, SourceHeight;
+    };
+
+    constexpr std::uint32_t MetricsMagic   = 0x4D465343; // "CSFM"
+    constexpr std::uint32_t MetricsVersion = 2; // 1 stored the png's byte count
+
+    struct MetricsHeader
+    {
+        std::uint32_t Magic;
+        std::uint32_t Version;
+        std::uint64_t SourceHash;
+        std::int32_t  GlyphCount;
+        std::int32_t  Reserved;
+    };
+}
+
+namespace CS200
+{
+    void ScanGlyphRects(const Image& font_image, std::span<Math::irect> glyph_rects)
+    {
+        const unsigned int white = 0xFFFFFFFF;
+        const RGBA*        row   = font_image.data();
+        const auto         size  = font_image.GetSize();
+
+        if (row == nullptr || *row != white)
+            throw std::runtime_error("font image must start with a white marker pixel");
+
+        unsigned int check_color = *row;
+        unsigned int next_color;
+
+        int height = size.y;
+        int x      = 1;
+
+        for (auto& rect : glyph_rects)
+        {
+            int width = 0;
+            do
+            {
+                width++;
+                if (x + width >= size.x)
+                    throw std::runtime_error("font image has fewer glyphs than expected");
+
+                next_color = *(row + x + width);
+            } while (check_color == next_color);
+
+            check_color = next_color;
+
+            rect.point_1 = { x, 1 };
+            rect.point_2 = { x + width - 1, height };
+            x += width;
+        }
+    }
+
+    bool WriteGlyphMetrics(const std::filesystem::path& path, std::span<const Math::irect> glyph_rects, std::uint64_t source_hash)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+
+        const MetricsHeader header{ MetricsMagic, MetricsVersion, source_hash, static_cast<std::int32_t>(glyph_rects.size()), 0 };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const auto& rect : glyph_rects)
+        {
+            const std::int32_t corners[4] = { rect.point_1.x, rect.point_1.y, rect.point_2.x, rect.point_2.y };
+            file.write(reinterpret_cast<const char*>(corners), sizeof(corners));
+        }
+        return static_cast<bool>(file);
+    }
+
+    bool ReadGlyphMetrics(std::span<const std::uint8_t> file_bytes, std::uint64_t source_hash, std::span<Math::irect> glyph_rects)
+    {
+        constexpr std::size_t corner_bytes = 4 * sizeof(std::int32_t);
+        MetricsHeader         header{};
+        if (file_bytes.size() < sizeof(header) + glyph_rects.size() * corner_bytes)
+            return false;
+        std::memcpy(&header, file_bytes.data(), sizeof(header));
+        if (header.Magic != MetricsMagic || header.Version != MetricsVersion || header.SourceHash != source_hash || header.GlyphCount != static_cast<std::int32_t>(glyph_rects.size()))
+            return false;
+
+        for (std::size_t index = 0; index < glyph_rects.size(); ++index)
+        {
+            std::int32_t corners[4] = {};
+            std::memcpy(corners, file_bytes.data() + sizeof(header) + index * corner_bytes, corner_bytes);
+            glyph_rects[index].point_1 = { corners[0], corners[1] };
+            glyph_rects[index].point_2 = { corners[2], corners[3] };
+        }
+        return true;
+    }
+
+    SdfFontAtlas GenerateSdfFontAtlas(const Image& font_image, std::span<const Math::irect> glyph_rects, int spread)
+    {
+        const auto  image_size = font_image.GetSize();
+        const auto* bytes      = reinterpret_cast<const std::uint8_t*>(font_image.data());
+
+        SdfFontAtlas atlas;
+        atlas.Spread = spread;
+        atlas.Glyphs.reserve(glyph_rects.size());
+        atlas.Source.reserve(glyph_rects.size());
+
+        for (const auto& rect : glyph_rects)
+        {
+            const auto glyph_size = rect.Size();
+            atlas.Glyphs.push_back({ { atlas.Size.x + spread, spread }, { atlas.Size.x + spread + glyph_size.x, spread + glyph_size.y } });
+            atlas.Source.push_back(glyph_size);
+            atlas.Size.x += glyph_size.x + 2 * spread;
+            atlas.Size.y = std::max(atlas.Size.y, glyph_size.y + 2 * spread);
+        }
+        atlas.Texels.assign(static_cast<std::size_t>(atlas.Size.x) * static_cast<std::size_t>(atlas.Size.y), 0);
+
+        for (std::size_t g = 0; g < glyph_rects.size(); ++g)
+        {
+            const auto& source = glyph_rects[g];
+            const int   left   = source.Left();
+            const int   top    = source.Bottom(); // smallest row, the image is stored top down
+            const int   width  = source.Size().x;
+            const int   height = source.Size().y;
+
+            // coverage of the glyph box only, neighbours in the source image must not bleed in
+            const auto inside = [&](int gx, int gy)
+            {
+                if (gx < 0 || gy < 0 || gx >= width || gy >= height || left + gx >= image_size.x || top + gy >= image_size.y)
+                    return false;
+                const auto texel = static_cast<std::size_t>(top + gy) * static_cast<std::size_t>(image_size.x) + static_cast<std::size_t>(left + gx);
+                return bytes[texel * 4 + 3] >= 128;
+            };
+
+            const int atlas_left = atlas.Glyphs[g].Left() - spread;
+            for (int py = 0; py < height + 2 * spread; ++py)
+            {
+                for (int px = 0; px < width + 2 * spread; ++px)
+                {
+                    const int  gx   = px - spread;
+                    const int  gy   = py - spread;
+                    const bool self = inside(gx, gy);
+
+                    int best = spread * spread * 2 + 1;
+                    for (int dy = -spread; dy <= spread; ++dy)
+                    {
+                        for (int dx = -spread; dx <= spread; ++dx)
+                        {
+                            const int d2 = dx * dx + dy * dy;
+                            if (d2 < best && inside(gx + dx, gy + dy) != self)
+                                best = d2;
+                        }
+                    }
+
+                    // the edge lies halfway between the two texel centers
+                    const double distance = std::min(std::sqrt(static_cast<double>(best)) - 0.5, static_cast<double>(spread));
+                    const double signed_d = self ? distance : -distance;
+                    const double value    = std::clamp(0.5 + signed_d / (2.0 * spread), 0.0, 1.0);
+
+                    atlas.Texels[static_cast<std::size_t>(py) * static_cast<std::size_t>(atlas.Size.x) + static_cast<std::size_t>(atlas_left + px)] = static_cast<std::uint8_t>(std::lround(value * 255.0));
+                }
+            }
+        }
+        return atlas;
+    }
+
+    bool WriteSdfFontAtlas(const std::filesystem::path& path, const SdfFontAtlas& atlas, std::uint64_t source_hash)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+
+        const SdfFileHeader header{ SdfMagic, SdfVersion, source_hash, atlas.Size.x, atlas.Size.y, atlas.Spread, static_cast<std::int32_t>(atlas.Glyphs.size()) };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (std::size_t g = 0; g < atlas.Glyphs.size(); ++g)
+        {
+            const auto&       glyph = atlas.Glyphs[g];
+            const GlyphRecord record{ glyph.Left(), glyph.Bottom(), glyph.Size().x, glyph.Size().y, atlas.Source[g].x, atlas.Source[g].y };
+            file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        }
+        file.write(reinterpret_cast<const char*>(atlas.Texels.data()), static_cast<std::streamsize>(atlas.Texels.size()));
+        return static_cast<bool>(file);
+    }
+
+    std::optional<SdfFontAtlas> ReadSdfFontAtlas(const std::filesystem::path& path, std::uint64_t source_hash)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return std::nullopt;
+
+        SdfFileHeader header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || header.Magic != SdfMagic || header.Version != SdfVersion || header.SourceHash != source_hash)
+            return std::nullopt;
+        if (header.Width <= 0 || header.Height <= 0 || header.Spread <= 0 || header.GlyphCount <= 0 || header.Width > 16384 || header.Height > 16384)
+            return std::nullopt;
+
+        SdfFontAtlas atlas;
+        atlas.Size   = { header.Width, header.Height };
+        atlas.Spread = header.Spread;
+        for (std::int32_t g = 0; g < header.GlyphCount; ++g)
+        {
+            GlyphRecord record{};
+            file.read(reinterpret_cast<char*>(&record), sizeof(record));
+            if (!file || record.X < 0 || record.Y < 0 || record.X + record.Width > header.Width || record.Y + record.Height > header.Height)
+                return std::nullopt;
+            atlas.Glyphs.push_back({ { record.X, record.Y }, { record.X + record.Width, record.Y + record.Height } });
+            atlas.Source.push_back({ record.SourceWidth, record.SourceHeight });
+        }
+
+        atlas.Texels.resize(static_cast<std::size_t>(header.Width) * static_cast<std::size_t>(header.Height));
+        file.read(reinterpret_cast<char*>(atlas.Texels.data()), static_cast<std::streamsize>(atlas.Texels.size()));
+        if (!file)
+            return std::nullopt;
+        return atlas;
+    }
+}
@@ -0,0 +1,111 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Engine/Rect.hpp"
+#include "Engine/Vec2.hpp"
+#include "Image.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace CS200
+{
+    /**
+     * \brief Characters in a CS230 bitmap font, ' ' through 'z'
+     */
+    inline constexpr int FontGlyphCount = 'z' - ' ' + 1;
+
+    /**
+     * \brief Spread of the .sdffont atlases the game and the tools make unless told otherwise
+     */
+    inline constexpr int DefaultSdfSpread = 6;
+
+    /**
+     * \brief Find the glyph rectangles of a CS230 bitmap font image
+     * \param font_image Font image loaded without vertical flip
+     * \param glyph_rects Output, one rectangle per character starting at ' '
+     *
+     * The first pixel of the top row must be white, and each color change
+     * along that row starts the next character. Rectangles are in texel
+     * coordinates with y growing downward; row 0 is the marker row and is not
+     * part of any glyph. Throws if the image is not a bitmap font.
+     */
+    void ScanGlyphRects(const Image& font_image, std::span<Math::irect> glyph_rects);
+
+    /**
+     * \brief Save glyph rectangles as a .fontmetrics file, so the image does not have to be scanned again
+     * \param path Destination file, by convention the font image with a .fontmetrics extension
+     * \param glyph_rects Rectangles from ScanGlyphRects()
+     * \param source_hash assets::hash_bytes() of the font image, stored to detect stale files
+     * \return False if the file could not be written
+     */
+    bool WriteGlyphMetrics(const std::filesystem::path& path, std::span<const Math::irect> glyph_rects, std::uint64_t source_hash);
+
+    /**
+     * \brief Parse the contents of a .fontmetrics file
+     * \param file_bytes The whole file, from disk or from the asset pack
+     * \param source_hash assets::hash_bytes() of the current font image, a mismatch means the file is stale
+     * \param glyph_rects Output, must have as many entries as the file holds
+     * \return False if the file is malformed, stale or for another glyph count; glyph_rects is then unchanged
+     */
+    [[nodiscard]] bool ReadGlyphMetrics(std::span<const std::uint8_t> file_bytes, std::uint64_t source_hash, std::span<Math::irect> glyph_rects);
+
+    /**
+     * \brief Single channel signed distance field atlas built from a bitmap font
+     *
+     * Each texel stores 0.5 on the glyph edge, rising toward 1 inside and
+     * falling toward 0 outside, reaching the extremes Spread texels away from
+     * the edge. Because the edge is found by thresholding a filtered distance
+     * rather than filtered coverage, the glyphs stay crisp at any scale and
+     * outlines or glows can be drawn from the same atlas in the shader.
+     *
+     * Glyphs sit side by side in one row, each padded by Spread texels on all
+     * sides. Rows are stored top to bottom like CS200::Image.
+     */
+    struct SdfFontAtlas
+    {
+        Math::ivec2                Size{ 0, 0 };
+        int                        Spread = 0;
+        std::vector<Math::irect>   Glyphs; ///< Unpadded glyph box in the atlas, same order as the source char rects
+        std::vector<Math::ivec2>   Source; ///< Glyph size in the source bitmap, used for layout
+        std::vector<std::uint8_t>  Texels;
+    };
+
+    /**
+     * \brief Convert the glyphs of a bitmap font into a distance field atlas
+     * \param font_image Bitmap font image, a texel is inside a glyph when its alpha is at least half
+     * \param glyph_rects Rectangles from ScanGlyphRects()
+     * \param spread Distance in texels that maps to the full 0..1 range
+     * \return The generated atlas
+     *
+     * Distances are exact Euclidean distances to the nearest texel of the
+     * opposite side within the spread, which is plenty fast for the small
+     * glyphs of the CS230 fonts.
+     */
+    [[nodiscard]] SdfFontAtlas GenerateSdfFontAtlas(const Image& font_image, std::span<const Math::irect> glyph_rects, int spread);
+
+    /**
+     * \brief Save an atlas as a .sdffont file
+     * \param path Destination file
+     * \param atlas Atlas to save
+     * \param source_hash assets::hash_bytes() of the bitmap font it was generated from, stored to detect stale files
+     * \return False if the file could not be written
+     */
+    bool WriteSdfFontAtlas(const std::filesystem::path& path, const SdfFontAtlas& atlas, std::uint64_t source_hash);
+
+    /**
+     * \brief Load a .sdffont file
+     * \param path File written by WriteSdfFontAtlas()
+     * \param source_hash assets::hash_bytes() of the current bitmap font, a mismatch means the file is stale
+     * \return The atlas, or nothing if the file is missing, malformed or stale
+     */
+    [[nodiscard]] std::optional<SdfFontAtlas> ReadSdfFontAtlas(const std::filesystem::path& path, std::uint64_t source_hash);
+}
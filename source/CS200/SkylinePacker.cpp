@@ -0,0 +1,117 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "SkylinePacker.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace CS200
+{
+    SkylinePacker::SkylinePacker(Math::ivec2 area_size) : size(area_size)
+    {
+        skyline.push_back({ 0, 0, size.x });
+    }
+
+    std::optional<Math::ivec2> SkylinePacker::Insert(Math::ivec2 rect_size)
+    {
+        if (rect_size.x <= 0 || rect_size.y <= 0)
+        {
+            return std::nullopt;
+        }
+
+        std::size_t best_index = skyline.size();
+        int         best_top   = std::numeric_limits<int>::max();
+        int         best_width = std::numeric_limits<int>::max();
+        for (std::size_t i = 0; i < skyline.size(); ++i)
+        {
+            const int y = fit(i, rect_size);
+            if (y < 0)
+            {
+                continue;
+            }
+            const int top = y + rect_size.y;
+            if (top < best_top || (top == best_top && skyline[i].Width < best_width))
+            {
+                best_index = i;
+                best_top   = top;
+                best_width = skyline[i].Width;
+            }
+        }
+        if (best_index == skyline.size())
+        {
+            return std::nullopt;
+        }
+
+        const Math::ivec2 position{ skyline[best_index].X, best_top - rect_size.y };
+        skyline.insert(skyline.begin() + static_cast<std::ptrdiff_t>(best_index), Segment{ position.x, best_top, rect_size.x });
+
+        // the new segment covers the start of the ones after it, trim or drop them
+        for (std::size_t i = best_index + 1; i < skyline.size();)
+        {
+            const auto& previous = skyline[i - 1];
+            const int   overlap  = previous.X + previous.Width - skyline[i].X;
+            if (overlap <= 0)
+            {
+                break;
+            }
+            skyline[i].X += overlap;
+            skyline[i].Width -= overlap;
+            if (skyline[i].Width > 0)
+            {
+                break;
+            }
+            skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+
+        // neighbours at the same height become one segment
+        for (std::size_t i = 0; i + 1 < skyline.size();)
+        {
+            if (skyline[i].Y == skyline[i + 1].Y)
+            {
+                skyline[i].Width += skyline[i + 1].Width;
+                skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        used_area += static_cast<long long>(rect_size.x) * rect_size.y;
+        return position;
+    }
+
+    double SkylinePacker::GetOccupancy() const noexcept
+    {
+        const auto area = static_cast<double>(size.x) * static_cast<double>(size.y);
+        return area > 0.0 ? static_cast<double>(used_area) / area : 0.0;
+    }
+
+    int SkylinePacker::fit(std::size_t index, Math::ivec2 rect_size) const noexcept
+    {
+        const int x = skyline[index].X;
+        if (x + rect_size.x > size.x)
+        {
+            return -1;
+        }
+
+        // the rectangle rests on the highest segment it spans
+        int y          = skyline[index].Y;
+        int width_left = rect_size.x;
+        for (std::size_t i = index; width_left > 0 && i < skyline.size(); ++i)
+        {
+            y = std::max(y, skyline[i].Y);
+            if (y + rect_size.y > size.y)
+            {
+                return -1;
+            }
+            width_left -= skyline[i].Width;
+        }
+        return y;
+    }
+}
@@ -0,0 +1,66 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Engine/Vec2.hpp"
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace CS200
+{
+    /**
+     * \brief Packs rectangles into a fixed size area with the skyline bottom left heuristic
+     *
+     * The packer only remembers the upper outline of everything placed so
+     * far, a list of horizontal segments. A new rectangle goes where its top
+     * edge ends up lowest, ties going to the narrowest segment, which keeps
+     * the outline flat and wastes little space for sprite sized images. Space
+     * under an overhang is never reused, which is the price for O(segments)
+     * inserts and no free list.
+     *
+     * Positions are in texels from the bottom left corner, y up, matching
+     * glTexSubImage2D offsets.
+     */
+    class SkylinePacker
+    {
+    public:
+        explicit SkylinePacker(Math::ivec2 area_size);
+
+        /**
+         * \brief Reserve space for a rectangle
+         * \param rect_size Width and height in texels, padding included
+         * \return Bottom left corner of the reserved space, or nothing if the area has no room left
+         */
+        std::optional<Math::ivec2> Insert(Math::ivec2 rect_size);
+
+        [[nodiscard]] Math::ivec2 GetSize() const noexcept
+        {
+            return size;
+        }
+
+        /**
+         * \brief Fraction of the area covered by inserted rectangles, 0 to 1
+         */
+        [[nodiscard]] double GetOccupancy() const noexcept;
+
+    private:
+        struct Segment
+        {
+            int X     = 0;
+            int Y     = 0;
+            int Width = 0;
+        };
+
+        int fit(std::size_t index, Math::ivec2 rect_size) const noexcept;
+
+        Math::ivec2          size;
+        std::vector<Segment> skyline;
+        long long            used_area = 0;
+    };
+}
@@ -15,11 +15,15 @@
 #include "Engine/Logger.hpp"
 #include "Engine/Matrix.hpp"
 #include "Engine/Window.hpp"
+#include "OpenGL/Environment.hpp"
 #include "OpenGL/GL.hpp"
+#include "OpenGL/ProgramCache.hpp"
+#include "OpenGL/UniformBlock.hpp"
 
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <imgui.h>
 #include <numeric>
 #include <sstream>
@@ -45,6 +49,88 @@ namespace
         out[8] = static_cast<float>(matrix[2][2]);
     }
 
+    constexpr GLuint     PerFrameBinding  = 1;
+    constexpr GLuint     PerViewBinding   = 2;
+    constexpr GLuint     PerPassBinding   = 3;
+    constexpr GLsizeiptr UniformRingBytes = 64 * 1024;
+
+    // std140 mirrors of the blocks in Assets/shaders/HW8/blocks.glsl
+    struct PerFrameBlock
+    {
+        float Time;
+        float Padding[3];
+    };
+
+    struct PerViewBlock
+    {
+        float ViewProjection[12]; // mat3 is three vec4 columns in std140
+        float Resolution[2];
+        float TexelSize[2];
+    };
+
+    struct PerPassBlock
+    {
+        float Strength;
+        float Intensity;
+        float Radius;
+        float Softness;
+        float GrainIntensity;
+        float ScanlineIntensity;
+        float Gamma;
+        float Padding;
+    };
+
+    static_assert(sizeof(PerFrameBlock) == 16 && sizeof(PerViewBlock) == 64 && sizeof(PerPassBlock) == 32);
+
+    void fill_std140_mat3(const Math::TransformationMatrix& matrix, float* out)
+    {
+        for (int column = 0; column < 3; ++column)
+        {
+            out[column * 4 + 0] = static_cast<float>(matrix[0][column]);
+            out[column * 4 + 1] = static_cast<float>(matrix[1][column]);
+            out[column * 4 + 2] = static_cast<float>(matrix[2][column]);
+            out[column * 4 + 3] = 0.0f;
+        }
+    }
+
+    // runs once per program, when the variant cache first hands it out
+    void setup_uniform_blocks(const OpenGL::CompiledShader& shader)
+    {
+        const auto program = shader.Shader;
+        if (OpenGL::SetUniformBlockBinding(program, "PerFrame", PerFrameBinding))
+        {
+            OpenGL::ValidateUniformBlock(OpenGL::ReflectUniformBlock(program, "PerFrame"), "PerFrame", sizeof(PerFrameBlock), { { "uTime", offsetof(PerFrameBlock, Time) } });
+        }
+        if (OpenGL::SetUniformBlockBinding(program, "PerView", PerViewBinding))
+        {
+            OpenGL::ValidateUniformBlock(OpenGL::ReflectUniformBlock(program, "PerView"), "PerView", sizeof(PerViewBlock),
+                                         { { "uViewProjection", offsetof(PerViewBlock, ViewProjection) },
+                                           { "uResolution", offsetof(PerViewBlock, Resolution) },
+                                           { "uTexelSize", offsetof(PerViewBlock, TexelSize) } });
+        }
+        if (OpenGL::SetUniformBlockBinding(program, "PerPass", PerPassBinding))
+        {
+            OpenGL::ValidateUniformBlock(OpenGL::ReflectUniformBlock(program, "PerPass"), "PerPass", sizeof(PerPassBlock),
+                                         { { "uStrength", offsetof(PerPassBlock, Strength) },
+                                           { "uIntensity", offsetof(PerPassBlock, Intensity) },
+                                           { "uRadius", offsetof(PerPassBlock, Radius) },
+                                           { "uSoftness", offsetof(PerPassBlock, Softness) },
+                                           { "uGrainIntensity", offsetof(PerPassBlock, GrainIntensity) },
+                                           { "uScanlineIntensity", offsetof(PerPassBlock, ScanlineIntensity) },
+                                           { "uGamma", offsetof(PerPassBlock, Gamma) } });
+        }
+    }
+
+    // Request() keeps returning null until the program is built, set the blocks up on the first non-null result
+    void acquire(const OpenGL::CompiledShader*& slot, const OpenGL::CompiledShader* requested)
+    {
+        if (slot == nullptr && requested != nullptr)
+        {
+            setup_uniform_blocks(*requested);
+        }
+        slot = requested;
+    }
+
     Math::TransformationMatrix build_transform(const Math::vec2& position, const Math::vec2& size, double rotation)
     {
         return Math::TranslationMatrix(position) * Math::RotationMatrix(rotation) * Math::ScaleMatrix(size);
@@ -58,22 +144,23 @@ void DemoDepthPost::Load()
     createQuad();
     createFullscreenTriangle();
     createWhiteTexture();
+    uniformRing.Create(UniformRingBytes);
 
-    spriteShader = OpenGL::CreateShader(std::filesystem::path{ "Assets/shaders/HW8/sprite.vert" },
-                                        std::filesystem::path{ "Assets/shaders/HW8/sprite.frag" });
-    chromaticShader = OpenGL::CreateShader(std::filesystem::path{ "Assets/shaders/HW8/fullscreen.vert" },
-                                           std::filesystem::path{ "Assets/shaders/HW8/chromatic.frag" });
-    vignetteShader = OpenGL::CreateShader(std::filesystem::path{ "Assets/shaders/HW8/fullscreen.vert" },
-                                          std::filesystem::path{ "Assets/shaders/HW8/vignette.frag" });
-    grainShader = OpenGL::CreateShader(std::filesystem::path{ "Assets/shaders/HW8/fullscreen.vert" },
-                                       std::filesystem::path{ "Assets/shaders/HW8/grain.frag" });
-    gammaShader = OpenGL::CreateShader(std::filesystem::path{ "Assets/shaders/HW8/fullscreen.vert" },
-                                       std::filesystem::path{ "Assets/shaders/HW8/gamma.frag" });
+    for (unsigned effects = 0; effects < PostPermutationCount; ++effects)
+    {
+        fusedDefines[effects] = postDefines(effects);
+    }
+    fusedFailed.fill(false);
+
+    // request every program up front so the driver can build them in parallel
+    acquireShaders();
+    shaderBuildSeconds = 0.0;
 
     viewportSize = Engine::GetWindow().GetSize();
     rebuildRenderTargets(viewportSize);
     buildScene(viewportSize);
     updateDrawOrder();
+    writeUniformBlocks();
 }
 
 void DemoDepthPost::Update()
@@ -81,6 +168,12 @@ void DemoDepthPost::Update()
     const auto& environment = Engine::GetWindowEnvironment();
     timeSeconds = static_cast<float>(environment.ElapsedTime);
 
+    if (shaderVariants.GetPendingCount() > 0)
+    {
+        shaderBuildSeconds += environment.DeltaTime;
+    }
+    acquireShaders();
+
     const auto current_size = Engine::GetWindow().GetSize();
     if (current_size != viewportSize)
     {
@@ -91,6 +184,7 @@ void DemoDepthPost::Update()
 
     updateAnimatedLayers();
     updateDrawOrder();
+    writeUniformBlocks();
 }
 
 void DemoDepthPost::Unload()
@@ -98,12 +192,15 @@ void DemoDepthPost::Unload()
     destroyRenderTargets();
     destroyGeometry();
     destroyWhiteTexture();
-
-    OpenGL::DestroyShader(spriteShader);
-    OpenGL::DestroyShader(chromaticShader);
-    OpenGL::DestroyShader(vignetteShader);
-    OpenGL::DestroyShader(grainShader);
-    OpenGL::DestroyShader(gammaShader);
+    uniformRing.Destroy();
+
+    shaderVariants.Clear();
+    spriteShader    = nullptr;
+    chromaticShader = nullptr;
+    vignetteShader  = nullptr;
+    grainShader     = nullptr;
+    gammaShader     = nullptr;
+    fusedShaders.fill(nullptr);
 }
 
 void DemoDepthPost::Draw() const
@@ -112,10 +209,27 @@ void DemoDepthPost::Draw() const
     {
         return;
     }
+    if (!sceneShadersReady())
+    {
+        // still compiling, keep showing the clear color; a failed build throws from acquireShaders() instead of waiting here
+        GL::BindFramebuffer(GL_FRAMEBUFFER, 0);
+        GL::Clear(GL_COLOR_BUFFER_BIT);
+        return;
+    }
 
+    bindUniformBlocks();
     renderSceneToMsaa();
     resolveMsaaToTexture();
-    runPostProcessing();
+
+    const unsigned effects = enabledPostEffects();
+    if (useFusedPost && fusedShaders[effects] != nullptr)
+    {
+        runFusedPostProcessing(effects);
+    }
+    else
+    {
+        runPostProcessing();
+    }
 }
 
 void DemoDepthPost::DrawImGui()
@@ -166,6 +280,40 @@ void DemoDepthPost::DrawImGui()
 
         ImGui::Checkbox("Gamma Correction", &enableGamma);
         ImGui::SliderFloat("Gamma", &gammaValue, 1.0f, 3.0f, "%.2f");
+
+        ImGui::SeparatorText("Post Chain");
+        ImGui::Checkbox("Fused Single Pass", &useFusedPost);
+        const unsigned effects = enabledPostEffects();
+        int            passes  = 1;
+        if (!useFusedPost)
+        {
+            passes += ((effects & PostChromatic) != 0) + ((effects & PostVignette) != 0) + ((effects & PostGrain) != 0);
+        }
+        const auto cached = std::count_if(fusedShaders.begin(), fusedShaders.end(), [](const OpenGL::CompiledShader* shader) { return shader != nullptr; });
+        ImGui::Text("Fullscreen passes: %d", passes);
+        ImGui::Text("Cached permutations: %d / %d", static_cast<int>(cached), static_cast<int>(PostPermutationCount));
+
+        if (const auto pending = shaderVariants.GetPendingCount(); pending > 0)
+        {
+            ImGui::Text("Compiling %d programs... (%.0f ms)", static_cast<int>(pending), shaderBuildSeconds * 1000.0);
+        }
+        else
+        {
+            ImGui::Text("Scene programs ready after %.0f ms", shaderBuildSeconds * 1000.0);
+        }
+        ImGui::Text("%d programs share %d compiled stages", static_cast<int>(shaderVariants.GetProgramCount()), static_cast<int>(shaderVariants.GetStageCount()));
+        ImGui::Text("Parallel shader compile: %s", OpenGL::SupportsParallelShaderCompile ? "yes" : "no");
+
+        const auto& program_cache = OpenGL::GetProgramCacheStats();
+        if (OpenGL::IsProgramCacheAvailable())
+        {
+            ImGui::Text("Program binary cache: %d hits, %d misses, %d rejected", program_cache.Hits, program_cache.Misses, program_cache.Rejected);
+            ImGui::Text("Startup time saved: %.1f ms", program_cache.SavedMilliseconds);
+        }
+        else
+        {
+            ImGui::TextUnformatted("Program binary cache: unavailable");
+        }
     }
     ImGui::End();
 }
@@ -380,18 +528,10 @@ void DemoDepthPost::renderSceneToMsaa() const
     GL::ClearColor(0.05f, 0.07f, 0.10f, 1.0f);
     GL::Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    const auto view_projection_matrix = CS200::build_ndc_matrix(viewportSize);
-    float view_projection[9] = {};
-    fill_mat3(view_projection_matrix, view_projection);
-
-    GL::UseProgram(spriteShader.Shader);
-    if (spriteShader.UniformLocations.contains("uViewProjection"))
+    GL::UseProgram(spriteShader->Shader);
+    if (spriteShader->UniformLocations.contains("uTexture"))
     {
-        GL::UniformMatrix3fv(spriteShader.UniformLocations.at("uViewProjection"), 1, GL_FALSE, view_projection);
-    }
-    if (spriteShader.UniformLocations.contains("uTexture"))
-    {
-        GL::Uniform1i(spriteShader.UniformLocations.at("uTexture"), 0);
+        GL::Uniform1i(spriteShader->UniformLocations.at("uTexture"), 0);
     }
 
     GL::BindVertexArray(quadVao);
@@ -437,12 +577,8 @@ void DemoDepthPost::runPostProcessing() const
         GL::Viewport(0, 0, viewportSize.x, viewportSize.y);
         GL::Clear(GL_COLOR_BUFFER_BIT);
 
-        GL::UseProgram(chromaticShader.Shader);
-        if (chromaticShader.UniformLocations.contains("uStrength"))
-        {
-            GL::Uniform1f(chromaticShader.UniformLocations.at("uStrength"), chromaticStrength);
-        }
-        drawFullscreenPass(chromaticShader, current);
+        GL::UseProgram(chromaticShader->Shader);
+        drawFullscreenPass(*chromaticShader, current);
         current = postTargets[ping].Texture;
         ping = 1 - ping;
     }
@@ -453,20 +589,8 @@ void DemoDepthPost::runPostProcessing() const
         GL::Viewport(0, 0, viewportSize.x, viewportSize.y);
         GL::Clear(GL_COLOR_BUFFER_BIT);
 
-        GL::UseProgram(vignetteShader.Shader);
-        if (vignetteShader.UniformLocations.contains("uIntensity"))
-        {
-            GL::Uniform1f(vignetteShader.UniformLocations.at("uIntensity"), vignetteIntensity);
-        }
-        if (vignetteShader.UniformLocations.contains("uRadius"))
-        {
-            GL::Uniform1f(vignetteShader.UniformLocations.at("uRadius"), vignetteRadius);
-        }
-        if (vignetteShader.UniformLocations.contains("uSoftness"))
-        {
-            GL::Uniform1f(vignetteShader.UniformLocations.at("uSoftness"), vignetteSoftness);
-        }
-        drawFullscreenPass(vignetteShader, current);
+        GL::UseProgram(vignetteShader->Shader);
+        drawFullscreenPass(*vignetteShader, current);
         current = postTargets[ping].Texture;
         ping = 1 - ping;
     }
@@ -477,16 +601,8 @@ void DemoDepthPost::runPostProcessing() const
         GL::Viewport(0, 0, viewportSize.x, viewportSize.y);
         GL::Clear(GL_COLOR_BUFFER_BIT);
 
-        GL::UseProgram(grainShader.Shader);
-        if (grainShader.UniformLocations.contains("uGrainIntensity"))
-        {
-            GL::Uniform1f(grainShader.UniformLocations.at("uGrainIntensity"), grainIntensity);
-        }
-        if (grainShader.UniformLocations.contains("uScanlineIntensity"))
-        {
-            GL::Uniform1f(grainShader.UniformLocations.at("uScanlineIntensity"), scanlineIntensity);
-        }
-        drawFullscreenPass(grainShader, current);
+        GL::UseProgram(grainShader->Shader);
+        drawFullscreenPass(*grainShader, current);
         current = postTargets[ping].Texture;
     }
 
@@ -494,18 +610,168 @@ void DemoDepthPost::runPostProcessing() const
     GL::Viewport(0, 0, viewportSize.x, viewportSize.y);
     GL::Clear(GL_COLOR_BUFFER_BIT);
 
-    GL::UseProgram(gammaShader.Shader);
-    if (gammaShader.UniformLocations.contains("uGamma"))
-    {
-        const float gamma = enableGamma ? gammaValue : 1.0f;
-        GL::Uniform1f(gammaShader.UniformLocations.at("uGamma"), gamma);
-    }
-    drawFullscreenPass(gammaShader, current);
+    GL::UseProgram(gammaShader->Shader);
+    drawFullscreenPass(*gammaShader, current);
 
     GL::BindVertexArray(0);
     GL::DepthMask(GL_TRUE);
 }
 
+void DemoDepthPost::runFusedPostProcessing(unsigned effects) const
+{
+    const auto& shader = *fusedShaders[effects];
+
+    GL::Disable(GL_DEPTH_TEST);
+    GL::DepthMask(GL_FALSE);
+    GL::Disable(GL_BLEND);
+    GL::BindVertexArray(fullscreenVao);
+
+    GL::BindFramebuffer(GL_FRAMEBUFFER, 0);
+    GL::Viewport(0, 0, viewportSize.x, viewportSize.y);
+    GL::Clear(GL_COLOR_BUFFER_BIT);
+
+    GL::UseProgram(shader.Shader);
+    drawFullscreenPass(shader, resolveTarget.Texture);
+
+    GL::BindVertexArray(0);
+    GL::DepthMask(GL_TRUE);
+}
+
+unsigned DemoDepthPost::enabledPostEffects() const
+{
+    unsigned effects = 0;
+    if (enableChromatic)
+    {
+        effects |= PostChromatic;
+    }
+    if (enableVignette)
+    {
+        effects |= PostVignette;
+    }
+    if (enableGrain)
+    {
+        effects |= PostGrain;
+    }
+    if (enableGamma)
+    {
+        effects |= PostGamma;
+    }
+    return effects;
+}
+
+void DemoDepthPost::acquireShaders()
+{
+    using namespace assets::literals;
+    // hashed by the compiler, this runs every frame until every variant is built
+    constexpr auto fullscreen_vert = "Assets/shaders/HW8/fullscreen.vert"_asset;
+
+    shaderVariants.Update();
+    if (!sceneShadersReady())
+    {
+        requestSceneShaders();
+        // with nothing left building a program that is still null failed, the cache logged why; the demo cannot draw without it
+        if (!sceneShadersReady() && shaderVariants.GetPendingCount() == 0)
+        {
+            throw std::runtime_error("DemoDepthPost scene shaders failed to build, see the log for the compiler output");
+        }
+    }
+
+    const unsigned effects = enabledPostEffects();
+    if (!useFusedPost || fusedShaders[effects] != nullptr || fusedFailed[effects])
+    {
+        return;
+    }
+
+    // the separate passes are drawn until this variant is ready, or for good if it failed to build
+    acquire(fusedShaders[effects], shaderVariants.Request(fullscreen_vert, "Assets/shaders/HW8/post_fused.frag"_asset, fusedDefines[effects]));
+    fusedFailed[effects] = fusedShaders[effects] == nullptr && shaderVariants.GetPendingCount() == 0;
+}
+
+void DemoDepthPost::requestSceneShaders()
+{
+    using namespace assets::literals;
+    constexpr auto fullscreen_vert = "Assets/shaders/HW8/fullscreen.vert"_asset;
+
+    if (spriteShader == nullptr)
+    {
+        acquire(spriteShader, shaderVariants.Request("Assets/shaders/HW8/sprite.vert"_asset, "Assets/shaders/HW8/sprite.frag"_asset));
+    }
+    if (chromaticShader == nullptr)
+    {
+        acquire(chromaticShader, shaderVariants.Request(fullscreen_vert, "Assets/shaders/HW8/chromatic.frag"_asset));
+    }
+    if (vignetteShader == nullptr)
+    {
+        acquire(vignetteShader, shaderVariants.Request(fullscreen_vert, "Assets/shaders/HW8/vignette.frag"_asset));
+    }
+    if (grainShader == nullptr)
+    {
+        acquire(grainShader, shaderVariants.Request(fullscreen_vert, "Assets/shaders/HW8/grain.frag"_asset));
+    }
+    if (gammaShader == nullptr)
+    {
+        acquire(gammaShader, shaderVariants.Request(fullscreen_vert, "Assets/shaders/HW8/gamma.frag"_asset));
+    }
+}
+
+std::vector<std::string> DemoDepthPost::postDefines(unsigned effects)
+{
+    std::vector<std::string> defines;
+    if ((effects & PostChromatic) != 0)
+    {
+        defines.emplace_back("POST_CHROMATIC");
+    }
+    if ((effects & PostVignette) != 0)
+    {
+        defines.emplace_back("POST_VIGNETTE");
+    }
+    if ((effects & PostGrain) != 0)
+    {
+        defines.emplace_back("POST_GRAIN");
+    }
+    if ((effects & PostGamma) != 0)
+    {
+        defines.emplace_back("POST_GAMMA");
+    }
+    return defines;
+}
+
+bool DemoDepthPost::sceneShadersReady() const
+{
+    return spriteShader != nullptr && chromaticShader != nullptr && vignetteShader != nullptr && grainShader != nullptr && gammaShader != nullptr;
+}
+
+void DemoDepthPost::writeUniformBlocks()
+{
+    if (viewportSize.x <= 0 || viewportSize.y <= 0)
+    {
+        return;
+    }
+
+    const PerFrameBlock per_frame{ timeSeconds, {} };
+    perFrameRange = uniformRing.Write(per_frame);
+
+    PerViewBlock per_view{};
+    fill_std140_mat3(CS200::build_ndc_matrix(viewportSize), per_view.ViewProjection);
+    per_view.Resolution[0] = static_cast<float>(viewportSize.x);
+    per_view.Resolution[1] = static_cast<float>(viewportSize.y);
+    per_view.TexelSize[0]  = 1.0f / static_cast<float>(viewportSize.x);
+    per_view.TexelSize[1]  = 1.0f / static_cast<float>(viewportSize.y);
+    perViewRange           = uniformRing.Write(per_view);
+
+    const PerPassBlock per_pass{
+        chromaticStrength, vignetteIntensity, vignetteRadius, vignetteSoftness, grainIntensity, scanlineIntensity, enableGamma ? gammaValue : 1.0f, 0.0f,
+    };
+    perPassRange = uniformRing.Write(per_pass);
+}
+
+void DemoDepthPost::bindUniformBlocks() const
+{
+    uniformRing.BindRange(PerFrameBinding, perFrameRange);
+    uniformRing.BindRange(PerViewBinding, perViewRange);
+    uniformRing.BindRange(PerPassBinding, perPassRange);
+}
+
 void DemoDepthPost::createQuad()
 {
     const float vertices[] = {
@@ -637,18 +903,18 @@ void DemoDepthPost::drawSprite(const RenderItem& item) const
     float      model[9] = {};
     fill_mat3(transform, model);
 
-    if (spriteShader.UniformLocations.contains("uModel"))
+    if (spriteShader->UniformLocations.contains("uModel"))
     {
-        GL::UniformMatrix3fv(spriteShader.UniformLocations.at("uModel"), 1, GL_FALSE, model);
+        GL::UniformMatrix3fv(spriteShader->UniformLocations.at("uModel"), 1, GL_FALSE, model);
     }
-    if (spriteShader.UniformLocations.contains("uDepth"))
+    if (spriteShader->UniformLocations.contains("uDepth"))
     {
-        GL::Uniform1f(spriteShader.UniformLocations.at("uDepth"), item.Depth);
+        GL::Uniform1f(spriteShader->UniformLocations.at("uDepth"), item.Depth);
     }
-    if (spriteShader.UniformLocations.contains("uTintColor"))
+    if (spriteShader->UniformLocations.contains("uTintColor"))
     {
         const auto color = CS200::unpack_color(item.Tint);
-        GL::Uniform4f(spriteShader.UniformLocations.at("uTintColor"), color[0], color[1], color[2], color[3]);
+        GL::Uniform4f(spriteShader->UniformLocations.at("uTintColor"), color[0], color[1], color[2], color[3]);
     }
 
     GL::ActiveTexture(GL_TEXTURE0);
@@ -658,22 +924,11 @@ void DemoDepthPost::drawSprite(const RenderItem& item) const
 
 void DemoDepthPost::setPostCommonUniforms(const OpenGL::CompiledShader& shader) const
 {
+    // everything else comes from the PerFrame, PerView and PerPass blocks
     if (shader.UniformLocations.contains("uInput"))
     {
         GL::Uniform1i(shader.UniformLocations.at("uInput"), 0);
     }
-    if (shader.UniformLocations.contains("uTexelSize"))
-    {
-        GL::Uniform2f(shader.UniformLocations.at("uTexelSize"), 1.0f / static_cast<float>(viewportSize.x), 1.0f / static_cast<float>(viewportSize.y));
-    }
-    if (shader.UniformLocations.contains("uResolution"))
-    {
-        GL::Uniform2f(shader.UniformLocations.at("uResolution"), static_cast<float>(viewportSize.x), static_cast<float>(viewportSize.y));
-    }
-    if (shader.UniformLocations.contains("uTime"))
-    {
-        GL::Uniform1f(shader.UniformLocations.at("uTime"), timeSeconds);
-    }
 }
 
 void DemoDepthPost::drawFullscreenPass(const OpenGL::CompiledShader& shader, OpenGL::TextureHandle input) const
@@ -14,9 +14,12 @@
 #include "OpenGL/Framebuffer.hpp"
 #include "OpenGL/Shader.hpp"
 #include "OpenGL/Texture.hpp"
+#include "OpenGL/UniformBlock.hpp"
 
+#include <array>
 #include <gsl/gsl>
 #include <random>
+#include <string>
 #include <vector>
 
 class DemoDepthPost final : public CS230::GameState
@@ -37,6 +40,16 @@ private:
         Random
     };
 
+    enum PostEffect : unsigned
+    {
+        PostChromatic = 1u << 0,
+        PostVignette  = 1u << 1,
+        PostGrain     = 1u << 2,
+        PostGamma     = 1u << 3
+    };
+
+    static constexpr std::size_t PostPermutationCount = 16;
+
     struct RenderItem
     {
         Math::vec2              Position;
@@ -81,6 +94,17 @@ private:
     void renderSceneToMsaa() const;
     void resolveMsaaToTexture() const;
     void runPostProcessing() const;
+    void runFusedPostProcessing(unsigned effects) const;
+
+    unsigned enabledPostEffects() const;
+    void     acquireShaders();
+    void     requestSceneShaders();
+    bool     sceneShadersReady() const;
+
+    static std::vector<std::string> postDefines(unsigned effects);
+
+    void writeUniformBlocks();
+    void bindUniformBlocks() const;
 
     void createQuad();
     void createFullscreenTriangle();
@@ -108,11 +132,25 @@ private:
 
     OpenGL::TextureHandle        whiteTexture = 0;
 
-    OpenGL::CompiledShader       spriteShader;
-    OpenGL::CompiledShader       chromaticShader;
-    OpenGL::CompiledShader       vignetteShader;
-    OpenGL::CompiledShader       grainShader;
-    OpenGL::CompiledShader       gammaShader;
+    // every program comes from the variant cache, these stay null until the driver has built them
+    OpenGL::ShaderVariantCache    shaderVariants;
+    const OpenGL::CompiledShader* spriteShader    = nullptr;
+    const OpenGL::CompiledShader* chromaticShader = nullptr;
+    const OpenGL::CompiledShader* vignetteShader  = nullptr;
+    const OpenGL::CompiledShader* grainShader     = nullptr;
+    const OpenGL::CompiledShader* gammaShader     = nullptr;
+
+    // one fused program per enabled-effect bitmask, requested on first use
+    std::array<const OpenGL::CompiledShader*, PostPermutationCount> fusedShaders{};
+    std::array<std::vector<std::string>, PostPermutationCount>      fusedDefines;  // built once in Load(), not every frame
+    std::array<bool, PostPermutationCount>                          fusedFailed{}; // not requested again, the separate passes stand in
+    double                                                           shaderBuildSeconds = 0.0;
+
+    // PerFrame, PerView and PerPass are written once per Update and shared by every program
+    OpenGL::UniformRingBuffer        uniformRing;
+    OpenGL::UniformRingBuffer::Range perFrameRange{};
+    OpenGL::UniformRingBuffer::Range perViewRange{};
+    OpenGL::UniformRingBuffer::Range perPassRange{};
 
     OpenGL::Handle               quadVao = 0;
     OpenGL::Handle               quadVbo = 0;
@@ -129,6 +167,7 @@ private:
     bool                         enableVignette = true;
     bool                         enableGrain = true;
     bool                         enableGamma = true;
+    bool                         useFusedPost = true;
 
     float                        chromaticStrength = 2.0f;
     float                        vignetteIntensity = 0.35f;
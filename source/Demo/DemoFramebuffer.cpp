@@ -16,13 +16,16 @@
 #include "DemoText.hpp"
 #include "Engine/Engine.hpp"
 #include "Engine/GameStateManager.hpp"
+#include "Engine/JobSystem.hpp"
 #include "Engine/Matrix.hpp"
-#include "Engine/Random.hpp"
 #include "Engine/Texture.hpp"
 #include "Engine/TextureManager.hpp"
 #include "Engine/Window.hpp"
 #include "OpenGL/GL.hpp"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cmath>
 #include <imgui.h>
 
@@ -32,11 +35,18 @@ void DemoFramebuffer::Load()
     const auto background_image_paths = { "Assets/images/DemoFramebuffer/Planets.png", "Assets/images/DemoFramebuffer/Ships.png", "Assets/images/DemoFramebuffer/Foreground.png" };
     for (const auto& path : background_image_paths)
     {
-        backgroundTextures.push_back(texture_manager.Load(path));
+        // sizes are known right away, the pixels show up over the next frames
+        backgroundTextures.push_back(texture_manager.Acquire(texture_manager.LoadAsync(path)));
     }
 
-    robotTexture = texture_manager.Load("Assets/images/DemoFramebuffer/Robot.png");
-    catTexture   = texture_manager.Load("Assets/images/DemoFramebuffer/Cat.png");
+    // the sprite sheets are small enough to share one atlas page and load in a blink
+    enabledAtlas = texture_manager.GetAtlas() == nullptr;
+    if (enabledAtlas)
+    {
+        texture_manager.EnableAtlas();
+    }
+    robotTexture = texture_manager.Acquire(texture_manager.Load("Assets/images/DemoFramebuffer/Robot.png"));
+    catTexture   = texture_manager.Acquire(texture_manager.Load("Assets/images/DemoFramebuffer/Cat.png"));
 
     initializeRobotAnimations();
     initializeCatAnimations();
@@ -64,7 +74,7 @@ void DemoFramebuffer::Load()
     walkingRobot.walkDirection = 1.0;   // 1 for right, -1 for left
     walkingRobot.walkSpeed     = 100.0; // pixels per second
 
-    initializeWindParticles();
+    windParticles = std::make_unique<CS230::ParticleEmitter>(windSettings(), static_cast<std::size_t>(particleCount));
 }
 
 template <typename T, typename FLOAT = double>
@@ -87,7 +97,7 @@ void DemoFramebuffer::Update()
     if (newParticleCount != particleCount)
     {
         particleCount = newParticleCount;
-        windParticles.resize(static_cast<size_t>(particleCount));
+        windParticles->SetCount(static_cast<std::size_t>(particleCount));
     }
 
     // Update idle cat
@@ -115,7 +125,11 @@ void DemoFramebuffer::Update()
         walkingRobot.faceRight     = false;
     }
 
-    updateWindParticles(delta_time);
+    // the sliders apply to particles as they respawn
+    windParticles->GetSettings() = windSettings();
+    const auto update_start      = std::chrono::steady_clock::now();
+    windParticles->Update(delta_time, &Engine::GetJobSystem());
+    windUpdateMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - update_start).count();
 }
 
 void DemoFramebuffer::Draw() const
@@ -145,9 +159,13 @@ void DemoFramebuffer::Draw() const
     renderer_2d.BeginScene(CS200::build_ndc_matrix(Engine::GetWindow().GetSize()));
 
     // Draw background
-    for (const auto& texture : backgroundTextures)
+    const auto& texture_manager = Engine::GetTextureManager();
+    for (const auto texture : backgroundTextures)
     {
-        texture->Draw(Math::TransformationMatrix{});
+        if (auto* background = texture_manager.Get(texture))
+        {
+            background->Draw(Math::TransformationMatrix{});
+        }
     }
 
     // Draw characters
@@ -155,6 +173,11 @@ void DemoFramebuffer::Draw() const
     drawCat(jumpingCat);
     drawRobot(walkingRobot);
 
+    if (minifyBenchmark)
+    {
+        drawMinifyBenchmark();
+    }
+
     // Conditionally draw scene texture overlay
     if (enableFramebufferOverlay)
     {
@@ -177,9 +200,103 @@ void DemoFramebuffer::DrawImGui()
     {
         ImGui::Checkbox("Enable Framebuffer Overlay", &enableFramebufferOverlay);
 
+        ImGui::SeparatorText("Texture Streaming");
+        auto& texture_manager = Engine::GetTextureManager();
+        int   budget_kib      = static_cast<int>(texture_manager.GetUploadBudget() / 1024);
+        if (ImGui::SliderInt("Upload Budget", &budget_kib, 64, 16384, "%d KiB/frame"))
+        {
+            texture_manager.SetUploadBudget(static_cast<std::size_t>(budget_kib) * 1024);
+        }
+        const auto upload_stats = texture_manager.GetUploadStats();
+        ImGui::Text("Pending: %zu textures, %.1f KiB queued, %.1f KiB last frame", texture_manager.GetPendingCount(), static_cast<double>(upload_stats.QueuedBytes) / 1024.0,
+                    static_cast<double>(upload_stats.BytesLastPump) / 1024.0);
+        const auto memory = texture_manager.GetMemoryStats();
+        ImGui::Text("VRAM: %.1f MiB (%.1f MiB as RGBA8), %zu of %zu textures ETC2", static_cast<double>(memory.GpuBytes) / 1048576.0, static_cast<double>(memory.Rgba8Bytes) / 1048576.0,
+                    memory.Compressed, memory.Textures);
+        if (memory.Rgba8Bytes > 0)
+        {
+            ImGui::Text("Sampling: %.1f bits per texel (RGBA8: 32)", 32.0 * static_cast<double>(memory.GpuBytes) / static_cast<double>(memory.Rgba8Bytes));
+        }
+        int budget_mib = static_cast<int>(texture_manager.GetMemoryBudget() / 1048576);
+        if (ImGui::SliderInt("VRAM Budget", &budget_mib, 0, 512, budget_mib == 0 ? "unlimited" : "%d MiB"))
+        {
+            texture_manager.SetMemoryBudget(static_cast<std::size_t>(budget_mib) * 1048576);
+        }
+        ImGui::Text("Evictable: %.1f MiB, evicted so far: %zu textures", static_cast<double>(memory.Evictable) / 1048576.0, memory.Evictions);
+        if (ImGui::TreeNode("Resident Textures"))
+        {
+            constexpr ImGuiTableFlags table_flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp;
+            if (ImGui::BeginTable("resident_textures", 5, table_flags))
+            {
+                ImGui::TableSetupColumn("Asset");
+                ImGui::TableSetupColumn("Size");
+                ImGui::TableSetupColumn("KiB");
+                ImGui::TableSetupColumn("Mips");
+                ImGui::TableSetupColumn("Idle");
+                ImGui::TableHeadersRow();
+                // least recently used first, the order they would be evicted in
+                for (const auto& resident : texture_manager.GetResidentTextures())
+                {
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(resident.Asset.c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%dx%d %s", resident.Size.x, resident.Size.y, resident.Compressed ? "ETC2" : (resident.InAtlas ? "atlas" : resident.Format));
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.1f", static_cast<double>(resident.GpuBytes) / 1024.0);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%d", resident.MipLevels);
+                    ImGui::TableNextColumn();
+                    if (resident.Referenced)
+                    {
+                        ImGui::TextUnformatted("in use");
+                    }
+                    else
+                    {
+                        ImGui::Text("%llu frames", static_cast<unsigned long long>(resident.FramesIdle));
+                    }
+                }
+                ImGui::EndTable();
+            }
+            ImGui::TreePop();
+        }
+        if (const auto* atlas = texture_manager.GetAtlas())
+        {
+            for (std::size_t i = 0; i < atlas->GetPages().size(); ++i)
+            {
+                const auto& page = *atlas->GetPages()[i];
+                ImGui::Text("Atlas page %zu: %d images, %.0f%% used", i, page.ImageCount, page.Packer.GetOccupancy() * 100.0);
+            }
+            const auto* robot = texture_manager.Get(robotTexture);
+            const auto* cat   = texture_manager.Get(catTexture);
+            ImGui::Text("Robot and cat share one texture: %s", robot != nullptr && cat != nullptr && robot->GetHandle() == cat->GetHandle() ? "yes" : "no");
+        }
+
+        ImGui::SeparatorText("Minification Benchmark");
+        ImGui::Checkbox("Draw Minified Copies", &minifyBenchmark);
+        ImGui::SliderInt("Copies", &minifyCopies, 1, 2048);
+        ImGui::SliderFloat("Scale", &minifyScale, 1.0f / 32.0f, 1.0f, "%.3f", ImGuiSliderFlags_Logarithmic);
+        constexpr std::array<OpenGL::Filtering, 4> filtering_modes = { OpenGL::Filtering::NearestPixel, OpenGL::Filtering::Linear, OpenGL::Filtering::LinearMipmapNearest,
+                                                                       OpenGL::Filtering::Trilinear };
+        auto* minified = backgroundTextures.empty() ? nullptr : texture_manager.Get(backgroundTextures.front());
+        if (ImGui::Combo("Filtering", &minifyFiltering, "Nearest\0Linear\0Linear, nearest mip\0Trilinear\0") && minified != nullptr)
+        {
+            minified->SetFiltering(filtering_modes[static_cast<std::size_t>(minifyFiltering)]);
+        }
+        if (minified != nullptr)
+        {
+            ImGui::Text("Mip levels: %d", minified->GetMipLevelCount());
+        }
+#if defined(__EMSCRIPTEN__)
+        ImGui::Text("Frame: %.2f ms (no GPU timer queries in WebGL2)", 1000.0 / static_cast<double>(ImGui::GetIO().Framerate));
+#else
+        ImGui::Text("GPU: %.3f ms for the copies, frame: %.2f ms", minifyGpuMs, 1000.0 / static_cast<double>(ImGui::GetIO().Framerate));
+#endif
+
         ImGui::SeparatorText("Wind Particle System Controls");
         ImGui::SliderAngle("Wind Direction", &targetWindDirection, 0.0f, 360.0f);
-        ImGui::SliderInt("Particle Count", &targetParticleCount, 0, 100);
+        ImGui::SliderInt("Particle Count", &targetParticleCount, 0, 200000, "%d", ImGuiSliderFlags_Logarithmic);
+        ImGui::Text("Simulated in %.2f ms on %u worker threads", static_cast<double>(windUpdateMs), Engine::GetJobSystem().GetWorkerCount());
 
         // Wind speed and direction controls
         ImGui::Text("Wind Speed Range:");
@@ -246,12 +363,36 @@ void DemoFramebuffer::DrawImGui()
 
 void DemoFramebuffer::Unload()
 {
+    auto& texture_manager = Engine::GetTextureManager();
+    for (const auto texture : backgroundTextures)
+    {
+        texture_manager.Release(texture);
+    }
+    backgroundTextures.clear();
+    texture_manager.Release(robotTexture);
+    texture_manager.Release(catTexture);
+    robotTexture = {};
+    catTexture   = {};
+    if (enabledAtlas)
+    {
+        // atlas mode was only for this state's sprites, later states load as usual
+        texture_manager.DisableAtlas();
+        enabledAtlas = false;
+    }
+    windParticles.reset();
+
     // Clean up stored framebuffer texture
     if (lastFramebufferTexture != 0)
     {
         GL::DeleteTextures(1, &lastFramebufferTexture);
         lastFramebufferTexture = 0;
     }
+    if (minifyQuery != 0)
+    {
+        GL::DeleteQueries(1, &minifyQuery);
+        minifyQuery        = 0;
+        minifyQueryPending = false;
+    }
 }
 
 gsl::czstring DemoFramebuffer::GetName() const
@@ -354,7 +495,10 @@ void DemoFramebuffer::drawCat(const CatState& character) const
     const auto translate = Math::TranslationMatrix(character.position);
     const auto transform = translate * scale * to_center;
     //Engine/texture member function ->
-    catTexture->Draw(transform, texel_base, frame_size);
+    if (auto* texture = Engine::GetTextureManager().Get(catTexture))
+    {
+        texture->Draw(transform, texel_base, frame_size);
+    }
 }
 
 void DemoFramebuffer::drawRobot(const RobotState& character) const
@@ -370,75 +514,103 @@ void DemoFramebuffer::drawRobot(const RobotState& character) const
     const auto translate = Math::TranslationMatrix(character.position);
     const auto transform = translate * scale * to_center;
 
-    robotTexture->Draw(transform, texel_base, frame_size);
-}
-
-void DemoFramebuffer::initializeWindParticles()
-{
-    windParticles.clear();
-    for (int i = 0; i < particleCount; ++i)
+    if (auto* texture = Engine::GetTextureManager().Get(robotTexture))
     {
-        WindParticle particle;
-        spawnWindParticle(particle);
-        windParticles.push_back(particle);
+        texture->Draw(transform, texel_base, frame_size);
     }
 }
 
-void DemoFramebuffer::spawnWindParticle(WindParticle& particle) const
+CS230::ParticleEmitter::Settings DemoFramebuffer::windSettings() const
 {
     const auto [width, height] = Engine::GetWindow().GetSize() / 2;
-    // Always spawn from left edge for left-to-right movement
-    particle.position          = Math::vec2{ -20.0, util::random(0.0, static_cast<double>(height)) };
-
-    // Calculate velocity for left-to-right movement
-    const double speed = util::random(static_cast<double>(windSpeedMin), static_cast<double>(windSpeedMax));
-    particle.velocity  = Math::vec2{
-        speed,                  // Horizontal movement (left to right)
-        util::random(-5.0, 5.0) // Small vertical variation
-    };
+    const double w             = static_cast<double>(width);
+    const double h             = static_cast<double>(height);
+
+    CS230::ParticleEmitter::Settings settings;
+    // Always spawn from left edge for left-to-right movement, with a small vertical variation
+    settings.SpawnArea   = { { -20.0, 0.0 }, { -20.0, h } };
+    settings.Bounds      = { { -40.0, -h }, { w + 20.0, 2.0 * h } };
+    settings.VelocityMin = { static_cast<double>(windSpeedMin), -5.0 };
+    settings.VelocityMax = { static_cast<double>(windSpeedMax), 5.0 };
+    settings.SizeMin     = static_cast<double>(particleSizeMin);
+    settings.SizeMax     = static_cast<double>(particleSizeMax);
+    settings.LifetimeMin = 3.0;
+    settings.LifetimeMax = 4.0 + 4.0 * w / 400.0;
+    settings.Sway        = 6.0; // the old per frame drift of 0.1 * size at 60 fps
+    settings.Color       = CS200::pack_color({ particleColor[0], particleColor[1], particleColor[2], 1.0f });
+    return settings;
+}
 
-    particle.size      = util::random(static_cast<double>(particleSizeMin), static_cast<double>(particleSizeMax));
-    particle.lifeTimer = 0.0;
-    particle.maxLife   = util::random(3.0, 4.0 + 4 * width / 400.0);
+void DemoFramebuffer::drawWindParticles() const
+{
+    windParticles->Draw();
 }
 
-void DemoFramebuffer::updateWindParticles(double delta_time)
+void DemoFramebuffer::drawMinifyBenchmark() const
 {
-    const auto [width, height] = Engine::GetWindow().GetSize() / 2;
+    auto* minified = backgroundTextures.empty() ? nullptr : Engine::GetTextureManager().Get(backgroundTextures.front());
+    if (minified == nullptr)
+    {
+        return;
+    }
 
-    for (auto& particle : windParticles)
+    auto&      renderer_2d     = Engine::GetRenderer2D();
+    const auto [width, height] = Engine::GetWindow().GetSize();
+    const auto ndc_matrix      = CS200::build_ndc_matrix(Engine::GetWindow().GetSize());
+    const auto& texture        = *minified;
+    const auto  scale          = static_cast<double>(minifyScale);
+    const auto  copy_size      = Math::vec2{ texture.GetSize().x * scale, texture.GetSize().y * scale };
+
+#if !defined(__EMSCRIPTEN__)
+    // read last frame's result when it is ready instead of stalling on it
+    if (minifyQueryPending)
     {
-        particle.position.x += particle.velocity.x * delta_time;
-        particle.position.y += particle.velocity.y * delta_time + std::sin(particle.lifeTimer * 3.1415) * 0.1 * particle.size;
-        particle.lifeTimer += delta_time;
-        const double life_ratio = particle.lifeTimer / particle.maxLife;
-        particle.alpha          = (1.0 - life_ratio);
-        if (particle.position.x > width + 20 || particle.lifeTimer >= particle.maxLife)
+        GLuint available = 0;
+        GL::GetQueryObjectuiv(minifyQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available != 0)
         {
-            spawnWindParticle(particle);
+            GLuint nanoseconds = 0;
+            GL::GetQueryObjectuiv(minifyQuery, GL_QUERY_RESULT, &nanoseconds);
+            minifyGpuMs        = static_cast<double>(nanoseconds) / 1'000'000.0;
+            minifyQueryPending = false;
         }
     }
-}
+    if (minifyQuery == 0)
+    {
+        GL::GenQueries(1, &minifyQuery);
+    }
+    const bool timed = !minifyQueryPending;
+#endif
 
-void DemoFramebuffer::drawWindParticles() const
-{
-    auto& renderer_2d = Engine::GetRenderer2D();
+    // flush what was drawn so far so the query only covers the copies
+    renderer_2d.EndScene();
+#if !defined(__EMSCRIPTEN__)
+    if (timed)
+    {
+        GL::BeginQuery(GL_TIME_ELAPSED, minifyQuery);
+    }
+#endif
+    renderer_2d.BeginScene(ndc_matrix);
 
-    for (const auto& particle : windParticles)
+    const int columns = std::max(1, static_cast<int>(static_cast<double>(width) / std::max(copy_size.x, 1.0)));
+    const int rows    = std::max(1, static_cast<int>(static_cast<double>(height) / std::max(copy_size.y, 1.0)));
+    for (int i = 0; i < minifyCopies; ++i)
     {
-        if (particle.alpha > 0.0)
-        {
-            // Create transform for particle
-            const auto        translate  = Math::TranslationMatrix(particle.position);
-            const auto        scale      = Math::ScaleMatrix({ particle.size, particle.size });
-            const auto        transform  = translate * scale;
-            // Set color with alpha using configurable color
-            const float       alpha      = static_cast<float>(particle.alpha);
-            const CS200::RGBA dust_color = CS200::pack_color({ particleColor[0], particleColor[1], particleColor[2], alpha });
-            // Draw particle as a small circle
-            renderer_2d.DrawCircle(transform, dust_color, CS200::CLEAR);
-        }
+        // tile the screen and start over on top once it is full, every copy costs the same fill
+        const int  cell     = i % (columns * rows);
+        const auto position = Math::vec2{ (cell % columns) * copy_size.x, (cell / columns) * copy_size.y };
+        minified->Draw(Math::TranslationMatrix(position) * Math::ScaleMatrix(scale));
     }
+
+    renderer_2d.EndScene();
+#if !defined(__EMSCRIPTEN__)
+    if (timed)
+    {
+        GL::EndQuery(GL_TIME_ELAPSED);
+        minifyQueryPending = true;
+    }
+#endif
+    renderer_2d.BeginScene(ndc_matrix);
 }
 
 DemoFramebuffer::RenderInfo DemoFramebuffer::beginOffscreenRendering() const
@@ -10,6 +10,8 @@
 #pragma once
 
 #include "Engine/GameState.hpp"
+#include "Engine/ParticleEmitter.hpp"
+#include "Engine/TextureRef.hpp"
 #include "Engine/Vec2.hpp"
 #include "OpenGL/Framebuffer.hpp"
 #include <array>
@@ -17,11 +19,6 @@
 #include <string>
 #include <vector>
 
-namespace CS230
-{
-    class Texture;
-}
-
 class DemoFramebuffer : public CS230::GameState
 {
 public:
@@ -87,9 +84,11 @@ private:
         Math::ivec2{ 512, 128 }  // Frame 9
     };
 
-    std::vector<std::shared_ptr<CS230::Texture>> backgroundTextures;
-    std::shared_ptr<CS230::Texture>              robotTexture = nullptr;
-    std::shared_ptr<CS230::Texture>              catTexture   = nullptr;
+    // held through the TextureManager, looked up with Get() when drawn
+    std::vector<CS230::TextureRef> backgroundTextures;
+    CS230::TextureRef              robotTexture;
+    CS230::TextureRef              catTexture;
+    bool                           enabledAtlas = false; // turned atlas mode on in Load(), so turns it off in Unload()
 
     // Animation data
     std::vector<Animation> robotAnimations;
@@ -127,17 +126,8 @@ private:
         std::array<GLint, 4>         Viewport{};
     };
 
-    struct WindParticle
-    {
-        Math::vec2 position{};
-        Math::vec2 velocity{};
-        double     size{};
-        double     alpha{};
-        double     lifeTimer{};
-        double     maxLife{};
-    };
-
-    std::vector<WindParticle> windParticles;
+    // created in Load(), it owns GL buffers
+    std::unique_ptr<CS230::ParticleEmitter> windParticles;
 
     // ImGui control variables
     bool enableFramebufferOverlay = true;
@@ -153,21 +143,30 @@ private:
     float particleColor[3]     = { 0.9f, 0.8f, 0.6f }; // RGB color
     float windDirection        = 0.0f;
     float targetWindDirection  = 0.0f;
+    float windUpdateMs         = 0.0f; // CPU time of the last particle update
 
     // Store the last rendered framebuffer texture for ImGui display
     mutable GLuint lastFramebufferTexture = 0;
 
+    // Minification benchmark: many scaled down copies of a background, timed on the GPU
+    bool           minifyBenchmark    = false;
+    int            minifyCopies       = 256;
+    float          minifyScale        = 0.125f;
+    int            minifyFiltering    = 0;
+    mutable GLuint minifyQuery        = 0;
+    mutable bool   minifyQueryPending = false;
+    mutable double minifyGpuMs        = 0.0;
+
 private:
-    void       initializeRobotAnimations();
-    void       initializeCatAnimations();
-    void       updateRobotAnimation(RobotState& character, double delta_time);
-    void       updateCatAnimation(CatState& character, double delta_time);
-    void       drawRobot(const RobotState& character) const;
-    void       drawCat(const CatState& character) const;
-    void       initializeWindParticles();
-    void       spawnWindParticle(WindParticle& particle) const;
-    void       updateWindParticles(double delta_time);
-    void       drawWindParticles() const;
-    RenderInfo beginOffscreenRendering() const;
-    GLuint     endOffscreenRendering(const RenderInfo& render_info) const;
+    void                             initializeRobotAnimations();
+    void                             initializeCatAnimations();
+    void                             updateRobotAnimation(RobotState& character, double delta_time);
+    void                             updateCatAnimation(CatState& character, double delta_time);
+    void                             drawRobot(const RobotState& character) const;
+    void                             drawCat(const CatState& character) const;
+    CS230::ParticleEmitter::Settings windSettings() const;
+    void                             drawWindParticles() const;
+    void                             drawMinifyBenchmark() const;
+    RenderInfo                       beginOffscreenRendering() const;
+    GLuint                           endOffscreenRendering(const RenderInfo& render_info) const;
 };
@@ -25,6 +25,10 @@ void DemoText::Load()
 
     simpleFont   = std::make_unique<CS230::Font>("Assets/fonts/Font_Simple.png");
     outlinedFont = std::make_unique<CS230::Font>("Assets/fonts/Font_Outlined.png");
+    sdfFont      = std::make_unique<CS230::SdfFont>("Assets/fonts/Font_Simple.png");
+
+    frequentLayout   = std::make_unique<CS230::TextLayout>(*simpleFont);
+    occasionalLayout = std::make_unique<CS230::TextLayout>(*simpleFont);
 
     updateCachedTextures();
 }
@@ -47,11 +51,17 @@ void DemoText::Update()
         frequentText = "Frequent: " + std::to_string(frequentCounter);
     }
 
+    frequentLayout->SetText(frequentText);
+    occasionalLayout->SetText(occasionalText);
+
     updateCachedTextures();
 }
 
 void DemoText::Unload()
 {
+    frequentLayout.reset();
+    occasionalLayout.reset();
+    sdfFont.reset();
 }
 
 void DemoText::Draw() const
@@ -78,24 +88,24 @@ void DemoText::Draw() const
     double max_width = 0.0;
 
     // Find the widest text among all displayed texts
+    const auto widest = [&](const CS230::Font& font)
+    {
+        for (const auto* text : { &frequentText, &occasionalText, &staticText })
+        {
+            max_width = std::max(max_width, static_cast<double>(font.MeasureText(*text).x) * settings.TextScale);
+        }
+    };
     if (settings.ShowSimpleFont)
     {
-        if (auto texture = simpleFont->PrintToTexture(frequentText, 0x00FFFFFF))
-            max_width = std::max(max_width, static_cast<double>(texture->GetSize().x) * settings.TextScale);
-        if (auto texture = simpleFont->PrintToTexture(occasionalText, 0xFF00FFFF))
-            max_width = std::max(max_width, static_cast<double>(texture->GetSize().x) * settings.TextScale);
-        if (auto texture = simpleFont->PrintToTexture(staticText, settings.TextColor))
-            max_width = std::max(max_width, static_cast<double>(texture->GetSize().x) * settings.TextScale);
+        widest(*simpleFont);
     }
-
     if (settings.ShowOutlinedFont)
     {
-        if (auto texture = outlinedFont->PrintToTexture(frequentText, 0xFF8000FF))
-            max_width = std::max(max_width, static_cast<double>(texture->GetSize().x) * settings.TextScale);
-        if (auto texture = outlinedFont->PrintToTexture(occasionalText, 0xFFFF00FF))
-            max_width = std::max(max_width, static_cast<double>(texture->GetSize().x) * settings.TextScale);
-        if (auto texture = outlinedFont->PrintToTexture(staticText, settings.TextColor))
-            max_width = std::max(max_width, static_cast<double>(texture->GetSize().x) * settings.TextScale);
+        widest(*outlinedFont);
+    }
+    if (settings.ShowSdfFont)
+    {
+        max_width = std::max(max_width, static_cast<double>(sdfFont->MeasureText(occasionalText).x) * settings.TextScale);
     }
 
     // Calculate the starting X position for center alignment
@@ -106,10 +116,25 @@ void DemoText::Draw() const
 
     if (settings.ShowSimpleFont)
     {
-        drawText(frequentText, Math::vec2{ center_x, current_y }, *simpleFont, 0x00FFFFFF);
+        const auto scale = Math::ScaleMatrix(Math::vec2{ settings.TextScale, settings.TextScale });
+        if (settings.UseTextLayout)
+        {
+            frequentLayout->Draw(Math::TranslationMatrix(Math::vec2{ center_x, current_y }) * scale, 0x00FFFFFF);
+        }
+        else
+        {
+            drawText(frequentText, Math::vec2{ center_x, current_y }, *simpleFont, 0x00FFFFFF, settings.DrawFrequentDirect);
+        }
         current_y += LINE_HEIGHT;
 
-        drawText(occasionalText, Math::vec2{ center_x, current_y }, *simpleFont, 0xFF00FFFF);
+        if (settings.UseTextLayout)
+        {
+            occasionalLayout->Draw(Math::TranslationMatrix(Math::vec2{ center_x, current_y }) * scale, 0xFF00FFFF);
+        }
+        else
+        {
+            drawText(occasionalText, Math::vec2{ center_x, current_y }, *simpleFont, 0xFF00FFFF);
+        }
         current_y += LINE_HEIGHT;
 
         drawText(staticText, Math::vec2{ center_x, current_y }, *simpleFont, settings.TextColor);
@@ -118,7 +143,7 @@ void DemoText::Draw() const
 
     if (settings.ShowOutlinedFont)
     {
-        drawText(frequentText, Math::vec2{ center_x, current_y }, *outlinedFont, 0xFF8000FF);
+        drawText(frequentText, Math::vec2{ center_x, current_y }, *outlinedFont, 0xFF8000FF, settings.DrawFrequentDirect);
         current_y += LINE_HEIGHT;
 
         drawText(occasionalText, Math::vec2{ center_x, current_y }, *outlinedFont, 0xFFFF00FF);
@@ -128,6 +153,20 @@ void DemoText::Draw() const
         current_y += LINE_HEIGHT;
     }
 
+    if (settings.ShowSdfFont)
+    {
+        // same strings from the distance field atlas, stays sharp at any Text Scale
+        const auto scale = Math::ScaleMatrix(Math::vec2{ settings.TextScale, settings.TextScale });
+        sdfFont->DrawText(Math::TranslationMatrix(Math::vec2{ center_x, current_y }) * scale, frequentText, 0x00FFFFFF, CS200::BLACK, settings.SdfOutlineWidth);
+        current_y += LINE_HEIGHT;
+
+        sdfFont->DrawText(Math::TranslationMatrix(Math::vec2{ center_x, current_y }) * scale, occasionalText, 0xFF00FFFF, CS200::BLACK, settings.SdfOutlineWidth);
+        current_y += LINE_HEIGHT;
+
+        sdfFont->DrawText(Math::TranslationMatrix(Math::vec2{ center_x, current_y }) * scale, staticText, settings.TextColor, CS200::BLACK, settings.SdfOutlineWidth);
+        current_y += LINE_HEIGHT;
+    }
+
     if (settings.ShowCacheAddresses)
     {
         drawCacheInfo(current_y, center_x);
@@ -143,6 +182,24 @@ void DemoText::DrawImGui()
         ImGui::Checkbox("Show Simple Font", &settings.ShowSimpleFont);
         ImGui::Checkbox("Show Outlined Font", &settings.ShowOutlinedFont);
         ImGui::Checkbox("Show Cache Addresses", &settings.ShowCacheAddresses);
+        ImGui::Checkbox("Draw Frequent Text Directly", &settings.DrawFrequentDirect);
+        if (ImGui::IsItemHovered())
+        {
+            ImGui::SetTooltip("Draw glyph quads from the font texture instead of rendering each new string to its own texture");
+        }
+        ImGui::Checkbox("Use Incremental Text Layout", &settings.UseTextLayout);
+        if (frequentLayout)
+        {
+            const auto& update = frequentLayout->GetLastUpdate();
+            ImGui::Text("Frequent layout: %zu of %zu glyphs rewritten, %zu bytes uploaded", update.GlyphsWritten, update.TotalGlyphs, update.BytesUploaded);
+        }
+        ImGui::Checkbox("Show SDF Font", &settings.ShowSdfFont);
+        ImGui::SliderFloat("SDF Outline Width", &settings.SdfOutlineWidth, 0.0f, static_cast<float>(CS230::SdfFont::DefaultSpread));
+        if (sdfFont)
+        {
+            const auto atlas = sdfFont->GetAtlasSize();
+            ImGui::Text("SDF atlas: %dx%d R8, %.1f KiB", atlas.x, atlas.y, static_cast<double>(sdfFont->GetAtlasBytes()) / 1024.0);
+        }
 
         ImGui::SeparatorText("Text Appearance");
 
@@ -177,6 +234,16 @@ void DemoText::DrawImGui()
         ImGui::Text("Frequent Text Address: %p", frequentTextAddress);
         ImGui::Text("Blinking Header Address: %p", blinkingHeaderAddress);
 
+        ImGui::SeparatorText("Text Texture Cache");
+        if (ImGui::SliderInt("Budget (KiB)", &settings.CacheBudgetKiB, 64, 32 * 1024))
+        {
+            const auto budget = static_cast<std::size_t>(settings.CacheBudgetKiB) * 1024;
+            simpleFont->SetCacheBudget(budget);
+            outlinedFont->SetCacheBudget(budget);
+        }
+        drawCacheStats("Simple", *simpleFont);
+        drawCacheStats("Outlined", *outlinedFont);
+
         ImGui::SeparatorText("Cache Analysis");
 
         if (staticTextAddress == lastStaticAddress && lastStaticAddress != nullptr)
@@ -230,13 +297,26 @@ void DemoText::updateCachedTextures()
         occasionalTextTexture = simpleFont->PrintToTexture(occasionalText, 0xFF00FFFF);
         occasionalTextAddress = occasionalTextTexture.get();
 
-        frequentTextTexture = simpleFont->PrintToTexture(frequentText, 0x00FFFFFF);
+        if (settings.DrawFrequentDirect)
+        {
+            // drawn glyph by glyph every frame, no texture to keep alive
+            frequentTextTexture.reset();
+        }
+        else
+        {
+            frequentTextTexture = simpleFont->PrintToTexture(frequentText, 0x00FFFFFF);
+        }
         frequentTextAddress = frequentTextTexture.get();
     }
 }
 
-void DemoText::drawText(const std::string& text, const Math::vec2& position, CS230::Font& font, CS200::RGBA color) const
+void DemoText::drawText(const std::string& text, const Math::vec2& position, CS230::Font& font, CS200::RGBA color, bool direct) const
 {
+    if (direct)
+    {
+        font.DrawText(Math::TranslationMatrix(position) * Math::ScaleMatrix(Math::vec2{ settings.TextScale, settings.TextScale }), text, color);
+        return;
+    }
     if (auto text_texture = font.PrintToTexture(text, color); text_texture)
     {
         const auto transform = Math::TranslationMatrix(position) * Math::ScaleMatrix(Math::vec2{ settings.TextScale, settings.TextScale });
@@ -244,6 +324,15 @@ void DemoText::drawText(const std::string& text, const Math::vec2& position, CS2
     }
 }
 
+void DemoText::drawCacheStats(const char* label, const CS230::Font& font) const
+{
+    const auto stats   = font.GetCacheStats();
+    const auto lookups = stats.Hits + stats.Misses;
+    ImGui::Text("%s: %zu entries, %.1f / %.1f KiB", label, stats.Entries, static_cast<double>(stats.Bytes) / 1024.0, static_cast<double>(stats.BudgetBytes) / 1024.0);
+    ImGui::Text("  hits %llu  misses %llu  evictions %llu  (%.1f%% hit rate)", static_cast<unsigned long long>(stats.Hits), static_cast<unsigned long long>(stats.Misses),
+                static_cast<unsigned long long>(stats.Evictions), lookups > 0 ? 100.0 * static_cast<double>(stats.Hits) / static_cast<double>(lookups) : 0.0);
+}
+
 void DemoText::drawCacheInfo(double start_y, double x_offset) const
 {
     if (!simpleFont)
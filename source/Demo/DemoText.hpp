@@ -11,6 +11,8 @@
 #include "CS200/RGBA.hpp"
 #include "Engine/Font.hpp"
 #include "Engine/GameState.hpp"
+#include "Engine/SdfFont.hpp"
+#include "Engine/TextLayout.hpp"
 #include "Engine/Vec2.hpp"
 #include <gsl/gsl>
 #include <memory>
@@ -28,6 +30,11 @@ public:
 private:
     std::unique_ptr<CS230::Font> simpleFont;
     std::unique_ptr<CS230::Font> outlinedFont;
+    std::unique_ptr<CS230::SdfFont> sdfFont;
+
+    // the simple font's frequent and occasional lines, patched in place when the counters change
+    std::unique_ptr<CS230::TextLayout> frequentLayout;
+    std::unique_ptr<CS230::TextLayout> occasionalLayout;
 
     double lastOccasionalTextUpdate = 0.0;
     double lastFrequentTextUpdate   = 0.0;
@@ -56,10 +63,15 @@ private:
         bool        ShowSimpleFont           = true;
         bool        ShowOutlinedFont         = true;
         bool        ShowCacheAddresses       = true;
+        bool        DrawFrequentDirect       = true;
+        bool        UseTextLayout            = true;
+        bool        ShowSdfFont              = true;
+        float       SdfOutlineWidth          = 2.0f;
         CS200::RGBA TextColor                = CS200::WHITE;
         double      TextScale                = 1.0;
         double      OccasionalUpdateInterval = 2.0;
         double      FrequentUpdateInterval   = 0.5;
+        int         CacheBudgetKiB           = 8 * 1024;
     } settings;
 
     static constexpr double   LEFT_MARGIN           = 50.0;
@@ -69,6 +81,7 @@ private:
 
 private:
     void updateCachedTextures();
-    void drawText(const std::string& text, const Math::vec2& position, CS230::Font& font, CS200::RGBA color = CS200::WHITE) const;
+    void drawText(const std::string& text, const Math::vec2& position, CS230::Font& font, CS200::RGBA color = CS200::WHITE, bool direct = false) const;
     void drawCacheInfo(double start_y, double x_offset) const;
+    void drawCacheStats(const char* label, const CS230::Font& font) const;
 };
@@ -0,0 +1,306 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "AssetPack.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <gsl/gsl>
+#include <stb_image.h>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace assets
+{
+    namespace
+    {
+        constexpr std::array<char, 8> Magic          = { 'C', 'S', '2', '0', '0', 'P', 'A', 'K' };
+        constexpr std::uint32_t       Version        = 1;
+        constexpr std::uint64_t       BlobAlignment  = 64; // a cache line, and enough for any SIMD load from a blob
+        constexpr std::uint32_t       FlagCompressed = 1;
+
+        struct PackHeader
+        {
+            char          Magic[8];
+            std::uint32_t Version;
+            std::uint32_t EntryCount;
+            std::uint64_t IndexOffset;
+            std::uint64_t NamesOffset;
+            std::uint64_t NamesBytes;
+            std::uint64_t FileBytes;
+        };
+        static_assert(sizeof(PackHeader) == 48);
+
+        std::uint64_t align_up(std::uint64_t value, std::uint64_t alignment) noexcept
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    struct AssetPack::IndexEntry
+    {
+        std::uint64_t Hash;
+        std::uint64_t DataOffset;
+        std::uint64_t StoredBytes;
+        std::uint64_t OriginalBytes;
+        std::uint32_t NameOffset;
+        std::uint32_t NameBytes;
+        std::uint32_t Flags;
+        std::uint32_t Reserved;
+    };
+
+    std::unique_ptr<AssetPack> AssetPack::Open(const std::filesystem::path& pack_path)
+    {
+        static_assert(sizeof(IndexEntry) == 48, "the index is read in place, no padding allowed");
+
+        std::unique_ptr<AssetPack> pack(new AssetPack());
+#if defined(_WIN32)
+        pack->fileHandle = CreateFileW(pack_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if (pack->fileHandle == INVALID_HANDLE_VALUE)
+        {
+            pack->fileHandle = nullptr;
+            throw std::runtime_error("Cannot open asset pack " + pack_path.string());
+        }
+        LARGE_INTEGER file_size{};
+        GetFileSizeEx(pack->fileHandle, &file_size);
+        pack->mappedBytes   = static_cast<std::size_t>(file_size.QuadPart);
+        pack->mappingHandle = CreateFileMappingW(pack->fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (pack->mappingHandle != nullptr)
+        {
+            pack->mapped = static_cast<const std::uint8_t*>(MapViewOfFile(pack->mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        }
+#elif defined(__EMSCRIPTEN__)
+        std::ifstream file(pack_path, std::ios::binary | std::ios::ate);
+        if (!file)
+        {
+            throw std::runtime_error("Cannot open asset pack " + pack_path.string());
+        }
+        pack->contents.resize(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(pack->contents.data()), static_cast<std::streamsize>(pack->contents.size()));
+        pack->mapped      = pack->contents.data();
+        pack->mappedBytes = pack->contents.size();
+#else
+        const int descriptor = ::open(pack_path.c_str(), O_RDONLY);
+        if (descriptor < 0)
+        {
+            throw std::runtime_error("Cannot open asset pack " + pack_path.string());
+        }
+        struct stat status{};
+        if (::fstat(descriptor, &status) == 0 && status.st_size > 0)
+        {
+            pack->mappedBytes = static_cast<std::size_t>(status.st_size);
+            void* view        = ::mmap(nullptr, pack->mappedBytes, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (view != MAP_FAILED)
+            {
+                pack->mapped = static_cast<const std::uint8_t*>(view);
+                // lookups jump around the index and the blobs
+                ::madvise(view, pack->mappedBytes, MADV_RANDOM);
+            }
+        }
+        ::close(descriptor); // the mapping keeps the file alive
+#endif
+        if (pack->mapped == nullptr || pack->mappedBytes < sizeof(PackHeader))
+        {
+            throw std::runtime_error("Cannot map asset pack " + pack_path.string());
+        }
+
+        PackHeader header{};
+        std::memcpy(&header, pack->mapped, sizeof(header));
+        const auto index_bytes = static_cast<std::uint64_t>(header.EntryCount) * sizeof(IndexEntry);
+        if (!std::equal(Magic.begin(), Magic.end(), header.Magic) || header.Version != Version || header.FileBytes != pack->mappedBytes ||
+            header.IndexOffset % alignof(IndexEntry) != 0 || header.IndexOffset + index_bytes > pack->mappedBytes || header.NamesOffset + header.NamesBytes > pack->mappedBytes)
+        {
+            throw std::runtime_error("Damaged or outdated asset pack " + pack_path.string());
+        }
+
+        // mappings are page aligned, so the index can be read in place
+        pack->entries    = reinterpret_cast<const IndexEntry*>(pack->mapped + header.IndexOffset);
+        pack->entryCount = header.EntryCount;
+        for (std::size_t i = 0; i < pack->entryCount; ++i)
+        {
+            const auto& entry = pack->entries[i];
+            if (entry.DataOffset + entry.StoredBytes > pack->mappedBytes || entry.NameOffset + static_cast<std::uint64_t>(entry.NameBytes) > header.NamesBytes)
+            {
+                throw std::runtime_error("Damaged asset pack " + pack_path.string());
+            }
+            if (i > 0 && pack->entries[i - 1].Hash > entry.Hash)
+            {
+                throw std::runtime_error("Unsorted asset pack index " + pack_path.string());
+            }
+        }
+        pack->names = reinterpret_cast<const char*>(pack->mapped + header.NamesOffset);
+        return pack;
+    }
+
+    AssetPack::~AssetPack()
+    {
+#if defined(_WIN32)
+        if (mapped != nullptr)
+        {
+            UnmapViewOfFile(mapped);
+        }
+        if (mappingHandle != nullptr)
+        {
+            CloseHandle(mappingHandle);
+        }
+        if (fileHandle != nullptr)
+        {
+            CloseHandle(fileHandle);
+        }
+#elif !defined(__EMSCRIPTEN__)
+        if (mapped != nullptr)
+        {
+            ::munmap(const_cast<std::uint8_t*>(mapped), mappedBytes);
+        }
+#endif
+    }
+
+    std::optional<std::span<const std::uint8_t>> AssetPack::Find(std::string_view key) const
+    {
+        const auto* entry = lookup(key);
+        if (entry == nullptr)
+        {
+            return std::nullopt;
+        }
+        if ((entry->Flags & FlagCompressed) != 0)
+        {
+            const auto bytes = inflate(*entry);
+            if (bytes.size() != entry->OriginalBytes)
+            {
+                return std::nullopt;
+            }
+            return bytes;
+        }
+        return std::span<const std::uint8_t>(mapped + entry->DataOffset, static_cast<std::size_t>(entry->StoredBytes));
+    }
+
+    bool AssetPack::Contains(std::string_view key) const noexcept
+    {
+        return lookup(key) != nullptr;
+    }
+
+    const AssetPack::IndexEntry* AssetPack::lookup(std::string_view key) const noexcept
+    {
+        const auto hash  = hash_pack_key(key);
+        const auto first = std::lower_bound(entries, entries + entryCount, hash, [](const IndexEntry& entry, std::uint64_t value) { return entry.Hash < value; });
+        for (auto it = first; it != entries + entryCount && it->Hash == hash; ++it)
+        {
+            if (std::string_view(names + it->NameOffset, it->NameBytes) == key)
+            {
+                return it;
+            }
+            // otherwise a hash collision, rare but possible
+        }
+        return nullptr;
+    }
+
+    std::span<const std::uint8_t> AssetPack::inflate(const IndexEntry& entry) const
+    {
+        std::scoped_lock lock(inflateMutex);
+        if (const auto it = inflated.find(&entry); it != inflated.end())
+        {
+            return it->second;
+        }
+
+        std::vector<std::uint8_t> bytes(static_cast<std::size_t>(entry.OriginalBytes));
+        const int                 written = stbi_zlib_decode_buffer(reinterpret_cast<char*>(bytes.data()), static_cast<int>(bytes.size()),
+                                                                    reinterpret_cast<const char*>(mapped + entry.DataOffset), static_cast<int>(entry.StoredBytes));
+        if (written != static_cast<int>(bytes.size()))
+        {
+            return {};
+        }
+        return inflated.emplace(&entry, std::move(bytes)).first->second;
+    }
+
+    bool AssetPack::Write(const std::filesystem::path& pack_path, std::vector<PackSource> sources)
+    {
+        std::sort(sources.begin(), sources.end(), [](const PackSource& a, const PackSource& b) { return hash_pack_key(a.Key) < hash_pack_key(b.Key); });
+
+        PackHeader header{};
+        std::memcpy(header.Magic, Magic.data(), Magic.size());
+        header.Version     = Version;
+        header.EntryCount  = static_cast<std::uint32_t>(sources.size());
+        header.IndexOffset = sizeof(PackHeader);
+        header.NamesOffset = header.IndexOffset + sources.size() * sizeof(IndexEntry);
+
+        std::string names;
+        for (const auto& source : sources)
+        {
+            names += source.Key;
+        }
+        header.NamesBytes = names.size();
+
+        std::vector<IndexEntry> index(sources.size());
+        std::uint64_t           offset      = header.NamesOffset + header.NamesBytes;
+        std::uint32_t           name_offset = 0;
+        for (std::size_t i = 0; i < sources.size(); ++i)
+        {
+            offset   = align_up(offset, BlobAlignment);
+            index[i] = { hash_pack_key(sources[i].Key),
+                         offset,
+                         sources[i].Stored.size(),
+                         sources[i].OriginalBytes,
+                         name_offset,
+                         static_cast<std::uint32_t>(sources[i].Key.size()),
+                         sources[i].Compressed ? FlagCompressed : 0u,
+                         0 };
+            offset += sources[i].Stored.size();
+            name_offset += static_cast<std::uint32_t>(sources[i].Key.size());
+        }
+        header.FileBytes = offset;
+
+        std::ofstream file(pack_path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size() * sizeof(IndexEntry)));
+        file.write(names.data(), static_cast<std::streamsize>(names.size()));
+        std::uint64_t written = header.NamesOffset + header.NamesBytes;
+        for (std::size_t i = 0; i < sources.size(); ++i)
+        {
+            const std::vector<char> padding(gsl::narrow<std::size_t>(index[i].DataOffset - written), 0);
+            file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+            file.write(reinterpret_cast<const char*>(sources[i].Stored.data()), static_cast<std::streamsize>(sources[i].Stored.size()));
+            written = index[i].DataOffset + index[i].StoredBytes;
+        }
+        return static_cast<bool>(file);
+    }
+
+    std::string pack_key(const std::filesystem::path& asset_path)
+    {
+        std::string key = asset_path.lexically_normal().generic_string();
+        // everything up to the Assets folder depends on where the game runs from
+        for (std::size_t at = key.find("Assets/"); at != std::string::npos; at = key.find("Assets/", at + 1))
+        {
+            if (at == 0 || key[at - 1] == '/')
+            {
+                key.erase(0, at);
+                break;
+            }
+        }
+        return key;
+    }
+}
@@ -0,0 +1,164 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace assets
+{
+    /**
+     * \brief One file to be written into a pack by AssetPack::Write()
+     */
+    struct PackSource
+    {
+        std::string               Key;               ///< See pack_key()
+        std::vector<std::uint8_t> Stored;            ///< The bytes as they go into the file
+        std::uint64_t             OriginalBytes = 0; ///< Size after inflating, equal to Stored.size() when not compressed
+        bool                      Compressed    = false;
+    };
+
+    /**
+     * \brief A read only, memory mapped .pak file holding a whole Assets folder
+     *
+     * Shipping every image and shader as its own file costs a directory walk
+     * and a few stat calls per lookup, then an open and a read per file. The
+     * pack is one file, mapped once at startup; a lookup hashes the path and
+     * binary searches a sorted index that lives in the mapping too, and the
+     * result is a view of the blob in place, no copy and no system call.
+     *
+     * Blobs start on 64 byte boundaries. Text assets such as shaders are
+     * stored zlib compressed when that saves space; they are inflated on
+     * first use into a buffer owned by the pack. Images are already
+     * compressed and always stored as is, so they stay zero copy.
+     *
+     * Views returned by Find() stay valid until the pack is destroyed. Find()
+     * may be called from several threads at once.
+     *
+     * Build packs with cs200_pack_assets, or the asset_pack CMake target.
+     */
+    class AssetPack
+    {
+    public:
+        /**
+         * \brief Map a pack file
+         * \throw std::runtime_error if the file cannot be mapped or is not a valid pack
+         */
+        [[nodiscard]] static std::unique_ptr<AssetPack> Open(const std::filesystem::path& pack_path);
+
+        /**
+         * \brief Bytes of an asset, in its original form
+         * \param key Path of the asset relative to the folder holding Assets, see pack_key()
+         * \return Nothing if the pack does not hold the asset or a compressed blob is damaged
+         */
+        [[nodiscard]] std::optional<std::span<const std::uint8_t>> Find(std::string_view key) const;
+
+        /**
+         * \brief Whether the pack holds an asset, answered from the index alone
+         *
+         * Unlike Find() this never inflates a compressed blob, so use it for
+         * existence checks.
+         */
+        [[nodiscard]] bool Contains(std::string_view key) const noexcept;
+
+        /**
+         * \brief Write a pack file that Open() can map
+         * \param pack_path File to create or overwrite
+         * \param sources Every asset, in any order
+         * \return False if the file cannot be written
+         */
+        static bool Write(const std::filesystem::path& pack_path, std::vector<PackSource> sources);
+
+        [[nodiscard]] std::size_t GetEntryCount() const noexcept
+        {
+            return entryCount;
+        }
+
+        [[nodiscard]] std::size_t GetMappedBytes() const noexcept
+        {
+            return mappedBytes;
+        }
+
+        ~AssetPack();
+
+        AssetPack(const AssetPack&)            = delete;
+        AssetPack& operator=(const AssetPack&) = delete;
+
+    private:
+        struct IndexEntry;
+
+        AssetPack() = default;
+
+        [[nodiscard]] const IndexEntry*             lookup(std::string_view key) const noexcept;
+        [[nodiscard]] std::span<const std::uint8_t> inflate(const IndexEntry& entry) const;
+
+        const std::uint8_t* mapped      = nullptr;
+        std::size_t         mappedBytes = 0;
+        const IndexEntry*   entries     = nullptr;
+        std::size_t         entryCount  = 0;
+        const char*         names       = nullptr;
+#if defined(_WIN32)
+        void* fileHandle    = nullptr;
+        void* mappingHandle = nullptr;
+#elif defined(__EMSCRIPTEN__)
+        std::vector<std::uint8_t> contents; // the web build's file system lives in memory already
+#endif
+
+        // compressed blobs, inflated on first use and kept until the pack closes
+        mutable std::mutex                                                     inflateMutex;
+        mutable std::unordered_map<const IndexEntry*, std::vector<std::uint8_t>> inflated;
+    };
+
+    /**
+     * \brief The name an asset has inside a pack
+     *
+     * The path from the Assets folder on, with forward slashes, so
+     * "Assets/shaders/quad.vert", "./Assets/shaders/quad.vert" and an
+     * absolute path into the Assets folder all name the same entry.
+     */
+    [[nodiscard]] std::string pack_key(const std::filesystem::path& asset_path);
+
+    inline constexpr std::uint64_t FnvOffsetBasis = 14695981039346656037ull;
+
+    /**
+     * \brief 64 bit FNV-1a hash of a pack key, what the index is sorted by
+     */
+    [[nodiscard]] constexpr std::uint64_t hash_pack_key(std::string_view key) noexcept
+    {
+        std::uint64_t hash = FnvOffsetBasis;
+        for (const char c : key)
+        {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /**
+     * \brief The same hash over file contents, what generated files store to notice their source changed
+     * \param hash Result of hashing the bytes before these, to hash a file in pieces
+     */
+    [[nodiscard]] constexpr std::uint64_t hash_bytes(std::span<const std::uint8_t> bytes, std::uint64_t hash = FnvOffsetBasis) noexcept
+    {
+        for (const std::uint8_t b : bytes)
+        {
+            hash ^= b;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+}
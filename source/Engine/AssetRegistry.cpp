@@ -0,0 +1,125 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "AssetRegistry.hpp"
+
+#include "Path.hpp"
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace
+{
+    struct AssetRecord
+    {
+        std::string                          Key;
+        std::filesystem::path                Source; // as first asked for, what the search starts from
+        std::optional<std::filesystem::path> Resolved;
+    };
+
+    // a deque so records never move while readers hold them, assets are never removed
+    std::shared_mutex                                registry_mutex;
+    std::deque<AssetRecord>                          records;
+    std::unordered_map<std::uint64_t, std::uint32_t> ids_by_hash;
+
+    assets::AssetId intern_key(std::string_view key, std::uint64_t hash, const std::filesystem::path& source)
+    {
+        const auto check = [key](std::uint32_t index)
+        {
+            if (records[index].Key != key)
+            {
+                throw std::runtime_error("Asset key hash collision: " + records[index].Key + " and " + std::string(key));
+            }
+            return assets::AssetId(index);
+        };
+
+        {
+            std::shared_lock lock(registry_mutex);
+            if (const auto found = ids_by_hash.find(hash); found != ids_by_hash.end())
+            {
+                return check(found->second);
+            }
+        }
+
+        std::unique_lock lock(registry_mutex);
+        if (const auto found = ids_by_hash.find(hash); found != ids_by_hash.end())
+        {
+            return check(found->second); // another thread interned it in between
+        }
+        const auto index = static_cast<std::uint32_t>(records.size());
+        records.push_back({ std::string(key), source, std::nullopt });
+        ids_by_hash.emplace(hash, index);
+        return assets::AssetId(index);
+    }
+
+    const AssetRecord& record_of(assets::AssetId id)
+    {
+        if (!id.IsValid() || id.GetIndex() >= records.size())
+        {
+            throw std::runtime_error("Unknown asset id " + std::to_string(id.GetIndex()));
+        }
+        return records[id.GetIndex()];
+    }
+}
+
+namespace assets
+{
+    AssetId intern_asset(const std::filesystem::path& asset_path)
+    {
+        const auto key = pack_key(asset_path);
+        return intern_key(key, hash_pack_key(key), asset_path);
+    }
+
+    AssetId intern_asset(AssetName name)
+    {
+        return intern_key(name.Key, name.Hash, std::filesystem::path(name.Key));
+    }
+
+    std::filesystem::path resolve_asset(AssetId id)
+    {
+        std::filesystem::path source;
+        {
+            std::shared_lock lock(registry_mutex);
+            const auto&      record = record_of(id);
+            if (record.Resolved)
+            {
+                return *record.Resolved;
+            }
+            source = record.Source;
+        }
+
+        // search without the lock, two threads may both search the first time and find the same file
+        auto resolved = search_asset(source);
+
+        std::unique_lock lock(registry_mutex);
+        records[id.GetIndex()].Resolved = resolved;
+        return resolved;
+    }
+
+    std::string asset_key(AssetId id)
+    {
+        std::shared_lock lock(registry_mutex);
+        return record_of(id).Key;
+    }
+
+    std::size_t interned_asset_count()
+    {
+        std::shared_lock lock(registry_mutex);
+        return records.size();
+    }
+
+    void forget_asset_locations()
+    {
+        std::unique_lock lock(registry_mutex);
+        for (auto& record : records)
+        {
+            record.Resolved.reset();
+        }
+    }
+}
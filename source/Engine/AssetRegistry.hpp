@@ -0,0 +1,142 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "AssetPack.hpp"
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace assets
+{
+    /**
+     * \brief Compact handle of an interned asset path
+     *
+     * Ids are dense indices handed out by intern_asset(), one per distinct
+     * pack_key(), so two spellings of the same asset share an id. They are
+     * cheap to hash and compare, which makes them the key of the texture and
+     * shader caches, and resolve_asset() turns one back into a file location
+     * without going to the file system again.
+     *
+     * Ids are only meaningful within one run of the program.
+     */
+    class AssetId
+    {
+    public:
+        constexpr AssetId() noexcept = default;
+
+        constexpr explicit AssetId(std::uint32_t interned_index) noexcept : index(interned_index)
+        {
+        }
+
+        [[nodiscard]] constexpr std::uint32_t GetIndex() const noexcept
+        {
+            return index;
+        }
+
+        [[nodiscard]] constexpr bool IsValid() const noexcept
+        {
+            return index != Invalid;
+        }
+
+        constexpr auto operator<=>(const AssetId&) const noexcept = default;
+
+    private:
+        static constexpr std::uint32_t Invalid = 0xFFFFFFFFu;
+        std::uint32_t                  index   = Invalid;
+    };
+
+    /**
+     * \brief An asset key spelled out in source code, hashed at compile time
+     *
+     * Made by the _asset literal. Interning one skips the path normalization
+     * and the hashing intern_asset() does for a std::filesystem::path, only
+     * the registry lookup is left.
+     */
+    struct AssetName
+    {
+        std::string_view Key;
+        std::uint64_t    Hash = 0;
+    };
+
+    /**
+     * \brief Intern an asset path, the first call per asset records it
+     *
+     * Only the path string is looked at; whether the file exists is found
+     * out by resolve_asset(). Safe to call from several threads.
+     */
+    [[nodiscard]] AssetId intern_asset(const std::filesystem::path& asset_path);
+    [[nodiscard]] AssetId intern_asset(AssetName name);
+
+    /**
+     * \brief Where the file of an interned asset is, found on first use and remembered
+     * \throw std::runtime_error if the asset cannot be found, failures are not remembered
+     *
+     * The search is the one locate_asset() always did, the pack first and
+     * then the loose folders; locate_asset() itself now goes through here.
+     */
+    [[nodiscard]] std::filesystem::path resolve_asset(AssetId id);
+
+    /**
+     * \brief The pack_key() an asset was interned with, for messages
+     */
+    [[nodiscard]] std::string asset_key(AssetId id);
+
+    /**
+     * \brief Number of distinct assets interned so far
+     */
+    [[nodiscard]] std::size_t interned_asset_count();
+
+    /**
+     * \brief Drop every remembered location, ids stay valid
+     *
+     * Called by mount_pack() and unmount_pack(), where assets move between
+     * the pack and the loose files.
+     */
+    void forget_asset_locations();
+
+    inline namespace literals
+    {
+        /**
+         * \brief "Assets/images/Cat.png"_asset, an AssetName hashed by the compiler
+         *
+         * The literal must already be a pack_key(): starting at the Assets
+         * folder, forward slashes, no "." or ".." parts. Anything else does
+         * not compile, since it would hash differently from the same path
+         * interned at run time.
+         */
+        consteval AssetName operator""_asset(const char* text, std::size_t length)
+        {
+            const std::string_view key(text, length);
+            if (!key.starts_with("Assets/") || key.ends_with('/'))
+            {
+                throw std::invalid_argument("asset literals start at the Assets folder and name a file");
+            }
+            if (key.find('\\') != std::string_view::npos || key.find("//") != std::string_view::npos || key.find("/./") != std::string_view::npos ||
+                key.find("/../") != std::string_view::npos)
+            {
+                throw std::invalid_argument("asset literals must be normalized with forward slashes");
+            }
+            return AssetName{ key, hash_pack_key(key) };
+        }
+    }
+}
+
+template <>
+struct std::hash<assets::AssetId>
+{
+    std::size_t operator()(const assets::AssetId& id) const noexcept
+    {
+        return std::hash<std::uint32_t>{}(id.GetIndex());
+    }
+};
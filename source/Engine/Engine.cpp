@@ -15,7 +15,9 @@
 #include "GameState.hpp"
 #include "GameStateManager.hpp"
 #include "Input.hpp"
+#include "JobSystem.hpp"
 #include "Logger.hpp"
+#include "Path.hpp"
 #include "TextureManager.hpp"
 #include "Timer.hpp"
 #include "Window.hpp"
@@ -48,6 +50,7 @@ public:
     CS230::GameStateManager    gameStateManager{};
     CS200::ImmediateRenderer2D renderer2D{};
     CS230::TextureManager      textureManager{};
+    CS230::JobSystem           jobSystem{}; // last, so the workers stop before anything a job could touch is destroyed
 };
 
 Engine& Engine::Instance()
@@ -91,6 +94,11 @@ CS230::TextureManager& Engine::GetTextureManager()
     return Instance().impl->textureManager;
 }
 
+CS230::JobSystem& Engine::GetJobSystem()
+{
+    return Instance().impl->jobSystem;
+}
+
 void Engine::Start(std::string_view window_title)
 {
     impl->logger.LogEvent("Engine Started");
@@ -99,6 +107,13 @@ void Engine::Start(std::string_view window_title)
 #endif
     impl->window.Start(window_title);
     auto& window = impl->window;
+    impl->logger.LogEvent("Job system running " + std::to_string(impl->jobSystem.GetWorkerCount()) + " worker threads");
+
+    // shipping builds read from one mapped file, development builds from the loose Assets folder
+    if (const auto pack_path = assets::mount_default_pack())
+    {
+        impl->logger.LogEvent("Mounted asset pack " + pack_path->string());
+    }
 
     const auto window_size = window.GetSize();
     impl->viewport         = { 0, 0, window_size.x, window_size.y };
@@ -112,9 +127,13 @@ void Engine::Start(std::string_view window_title)
 
 void Engine::Stop()
 {
+    // jobs may still hold textures or the renderer, let them finish before those go away
+    impl->jobSystem.WaitIdle();
+    impl->textureManager.Unload();
     impl->renderer2D.Shutdown();
     impl->gameStateManager.Clear();
     ImGuiHelper::Shutdown();
+    assets::unmount_pack();
     impl->logger.LogEvent("Engine Stopped");
 }
 
@@ -123,6 +142,8 @@ void Engine::Update()
     updateEnvironment();
     impl->window.Update();
     impl->input.Update();
+    impl->jobSystem.Update();
+    impl->textureManager.Update();
     auto& state_manager = impl->gameStateManager;
     state_manager.Update();
     const auto        viewport      = impl->viewport;
@@ -20,6 +20,7 @@ namespace CS230
     class Input;
     class GameState;
     class GameStateManager;
+    class JobSystem;
     class TextureManager;
 }
 
@@ -81,6 +82,7 @@ struct WindowEnvironment
  * - Renderer2D: High-level 2D graphics rendering system
  * - GameStateManager: State machine for different application screens/modes
  * - TextureManager: Resource management for texture assets
+ * - JobSystem: Worker threads for parallel work, with a queue back to the main thread
  * - Logger: Debug and event logging system
  *
  * Application Lifecycle:
@@ -236,6 +238,24 @@ public:
      */
     static CS230::TextureManager& GetTextureManager();
 
+    /**
+     * \brief Access the job system shared by the engine and game states
+     * \return Reference to JobSystem for running work on the worker threads
+     *
+     * Provides access to the work-stealing thread pool that the engine owns
+     * for its whole lifetime. Game states hand it simulation, sorting and
+     * asset preparation instead of starting threads of their own, and queue
+     * OpenGL work back to the main thread through it.
+     *
+     * Job system features:
+     * - Fork/join and parallel-for over index ranges
+     * - Jobs that start once the jobs they depend on finished
+     * - Main thread jobs, run at the start of every frame, for OpenGL calls
+     * - Waiting threads run pending jobs instead of sleeping
+     * - Runs everything on the main thread on the web build
+     */
+    static CS230::JobSystem& GetJobSystem();
+
 
 public:
     /**
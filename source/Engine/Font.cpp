@@ -10,17 +10,62 @@
 
 #include "Font.hpp"
 
+#include "AssetPack.hpp"
 #include "CS200/Image.hpp"
+#include "CS200/SdfFontAtlas.hpp"
 #include "Engine.hpp"
 #include "Error.hpp"
+#include "Logger.hpp"
 #include "Matrix.hpp"
+#include "Path.hpp"
 #include "TextureManager.hpp"
 #include <algorithm>
-#include <sstream>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
 
 namespace CS230
 {
+    namespace
+    {
+        std::filesystem::path metrics_path_for(const std::filesystem::path& png_path)
+        {
+            auto path = png_path;
+            return path.replace_extension(".fontmetrics");
+        }
+    }
+
     Font::Font(const std::filesystem::path& file_name)
+    {
+        // the glyph rects live in a small sidecar, so the png is only decoded once, by the texture
+        const auto png_path = assets::locate_asset(file_name);
+        const auto png_hash = assets::hash_asset(png_path);
+        // one next to the png comes from the cooker or the packer; the game writes its own to the cache, never into Assets
+        const auto shipped_path = metrics_path_for(png_path);
+        const auto cache_path   = assets::get_cache_path() / assets::pack_key(shipped_path);
+
+        const bool had_metrics = png_hash && (load_metrics(shipped_path, *png_hash) || load_metrics(cache_path, *png_hash));
+        if (!had_metrics)
+        {
+            find_char_rects(file_name);
+        }
+
+        font_texture = Engine::GetTextureManager().LoadMask(file_name); // R8 or RG8 instead of RGBA8
+
+        if (had_metrics && !rects_fit(font_texture->GetSize()))
+        {
+            Engine::GetLogger().LogDebug("Stale font metrics for " + png_path.string() + ", rescanning");
+            find_char_rects(file_name);
+            save_metrics(cache_path, *png_hash);
+        }
+        else if (!had_metrics && png_hash)
+        {
+            save_metrics(cache_path, *png_hash);
+        }
+    }
+
+    void Font::find_char_rects(const std::filesystem::path& file_name)
     {
         const unsigned int white = 0xFFFFFFFF;
         CS200::Image tempimage(file_name);
@@ -28,108 +73,161 @@ namespace CS230
         if (*(tempimage.data()) != white)
             throw std::runtime_error("failed to load font : " + file_name.string());
 
- 
-        unsigned int check_color = *(tempimage.data());
-        unsigned int next_color;
-
-        int height = tempimage.GetSize().y;
-        int x = 1; 
+        CS200::ScanGlyphRects(tempimage, char_rects);
+    }
 
-        for (int index = 0; index < num_chars; index++) 
+    bool Font::load_metrics(const std::filesystem::path& metrics_path, std::uint64_t png_hash)
+    {
+        if (const auto packed = assets::find_packed(metrics_path))
         {
-            int width = 0;
-            do 
-            {
-                width++;
-                
-                next_color = *(tempimage.data() + x + width);
-            } 
-            while (check_color == next_color);
-
-            check_color = next_color;
+            return CS200::ReadGlyphMetrics(*packed, png_hash, char_rects);
+        }
 
+        std::ifstream             file(metrics_path, std::ios::binary | std::ios::ate);
+        std::vector<std::uint8_t> bytes(file ? static_cast<std::size_t>(file.tellg()) : 0);
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return file && CS200::ReadGlyphMetrics(bytes, png_hash, char_rects);
+    }
 
-            char_rects[index].point_1 = { x, 1 };
-            char_rects[index].point_2 = { x + width - 1, height };
-            x += width;
+    void Font::save_metrics(const std::filesystem::path& metrics_path, std::uint64_t png_hash) const
+    {
+        // best effort, without a writable cache every load keeps paying for the scan
+        std::error_code ec;
+        std::filesystem::create_directories(metrics_path.parent_path(), ec);
+        if (!CS200::WriteGlyphMetrics(metrics_path, char_rects, png_hash))
+        {
+            Engine::GetLogger().LogDebug("Cannot write font metrics " + metrics_path.string());
         }
+    }
 
-        font_texture = Engine::GetTextureManager().Load(file_name);
+    bool Font::rects_fit(Math::ivec2 texture_size) const noexcept
+    {
+        return std::all_of(std::begin(char_rects), std::end(char_rects),
+                           [texture_size](const Math::irect& rect)
+                           { return rect.Left() >= 0 && rect.Bottom() >= 0 && rect.Right() < texture_size.x && rect.Top() <= texture_size.y && rect.Right() >= rect.Left(); });
     }
 
     std::shared_ptr<Texture> Font::PrintToTexture(const std::string& text, CS200::RGBA color)
     {
-      
-        std::ostringstream oss;
-        oss << text << "_0x" << std::hex << color;
-        std::string key = oss.str();
-
- 
-        auto it = font_cache.find(key);
-        if (it != font_cache.end())
+        if (auto it = font_cache.find(CacheKeyView{ text, color }); it != font_cache.end())
         {
-            it->second.used_time = Engine::GetWindowEnvironment().FrameCount;
+            ++stats.Hits;
+            lru_unlink(it->second);
+            lru_push_front(it->second);
             return it->second.texture;
         }
+        ++stats.Misses;
 
+        const Math::ivec2 text_size = MeasureText(text);
 
-        int text_width = 0;
-        int text_height = 0;
-
-        for (char c : text)
-        {
-            if (c < ' ' || c > 'z') continue; 
-
-            auto& rect = char_rects[c - ' '];
-            text_width += rect.point_2.x - rect.point_1.x + 1;
-            text_height = std::max(text_height, rect.point_2.y - rect.point_1.y + 1);
-        }
+        TextureManager::StartRenderTextureMode(text_size.x, text_size.y);
+        DrawText(Math::TransformationMatrix{}, text, color);
 
-        TextureManager::StartRenderTextureMode(text_width, text_height);
+        std::shared_ptr<Texture> rendered_texture = TextureManager::EndRenderTextureMode();
 
-        Math::vec2 pen{ 0.0, 0.0 };
+        const auto it    = font_cache.try_emplace(CacheKey{ text, color }).first;
+        Cache&     entry = it->second;
+        entry.texture    = rendered_texture;
+        entry.bytes      = static_cast<std::size_t>(text_size.x) * static_cast<std::size_t>(text_size.y) * 4;
+        entry.key        = &it->first;
+        cache_bytes += entry.bytes;
+        lru_push_front(entry);
 
-        for (char c : text)
-        {
-            if (c < ' ' || c > 'z') continue; 
+        evict_to_budget();
+        return rendered_texture;
+    }
 
-            auto& rect = char_rects[c - ' '];
-            int char_width = rect.point_2.x - rect.point_1.x + 1;
+    void Font::SetCacheBudget(std::size_t bytes)
+    {
+        cache_budget = bytes;
+        evict_to_budget();
+    }
 
-            //Math::TransformationMatrix transform = Math::TranslationMatrix(pen);
+    Font::CacheStats Font::GetCacheStats() const noexcept
+    {
+        CacheStats result  = stats;
+        result.Entries     = font_cache.size();
+        result.Bytes       = cache_bytes;
+        result.BudgetBytes = cache_budget;
+        return result;
+    }
 
-            Math::vec2 tex_bl{
-                rect.point_1.x / double(font_texture->GetSize().x),
-                1.0 - rect.point_2.y / double(font_texture->GetSize().y)
-            };
-            Math::vec2 tex_tr{
-                rect.point_2.x / double(font_texture->GetSize().x),
-                1.0 - rect.point_1.y / double(font_texture->GetSize().y)
-            };
+    std::size_t Font::CacheKeyHash::operator()(const CacheKeyView& key) const noexcept
+    {
+        const std::size_t text_hash = std::hash<std::string_view>{}(key.Text);
+        return text_hash ^ (std::hash<CS200::RGBA>{}(key.Color) + 0x9e3779b97f4a7c15ull + (text_hash << 6) + (text_hash >> 2));
+    }
 
-            Math::TransformationMatrix display_matrix = Math::TranslationMatrix{ pen };
+    void Font::lru_unlink(Cache& entry) noexcept
+    {
+        (entry.prev != nullptr ? entry.prev->next : lru_head) = entry.next;
+        (entry.next != nullptr ? entry.next->prev : lru_tail) = entry.prev;
+        entry.prev = entry.next = nullptr;
+    }
 
-            font_texture->Draw(display_matrix, { rect.Left(), rect.Bottom() }, rect.Size(), color);
+    void Font::lru_push_front(Cache& entry) noexcept
+    {
+        entry.prev = nullptr;
+        entry.next = lru_head;
+        if (lru_head != nullptr)
+            lru_head->prev = &entry;
+        lru_head = &entry;
+        if (lru_tail == nullptr)
+            lru_tail = &entry;
+    }
 
-            pen.x += char_width;
+    void Font::evict_to_budget()
+    {
+        // walk from the cold end, textures the caller still holds are pinned and skipped
+        Cache* entry = lru_tail;
+        while (cache_bytes > cache_budget && entry != nullptr)
+        {
+            Cache* const older = entry->prev;
+            if (entry->texture.use_count() == 1)
+            {
+                cache_bytes -= entry->bytes;
+                ++stats.Evictions;
+                lru_unlink(*entry);
+                font_cache.erase(font_cache.find(*entry->key));
+            }
+            entry = older;
         }
+    }
 
-        std::shared_ptr<Texture> rendered_texture = TextureManager::EndRenderTextureMode();
-
-  
-        font_cache[key] = { rendered_texture, Engine::GetWindowEnvironment().FrameCount };
+    void Font::DrawText(const Math::TransformationMatrix& display_matrix, std::string_view text, CS200::RGBA color) const
+    {
+        Math::vec2 pen{ 0.0, 0.0 };
+        for (char c : text)
+        {
+            if (c < ' ' || c > 'z')
+                continue;
 
+            const auto& rect = char_rects[c - ' '];
+            font_texture->Draw(display_matrix * Math::TranslationMatrix{ pen }, { rect.Left(), rect.Bottom() }, rect.Size(), color);
+            pen.x += rect.Size().x + 1;
+        }
+    }
 
-        auto current_frame = Engine::GetWindowEnvironment().FrameCount;
+    const Math::irect& Font::GetCharRect(char c) const noexcept
+    {
+        if (c < ' ' || c > 'z')
+            c = ' ';
+        return char_rects[c - ' '];
+    }
 
-        for (auto iter = font_cache.begin(); iter != font_cache.end(); )
+    Math::ivec2 Font::MeasureText(std::string_view text) const
+    {
+        Math::ivec2 size{ 0, 0 };
+        for (char c : text)
         {
-            if (current_frame - iter->second.used_time > 60 && iter->second.texture.use_count() == 1)
-                iter = font_cache.erase(iter);
-            else
-                ++iter;
-        }
+            if (c < ' ' || c > 'z')
+                continue;
 
-        return rendered_texture;
+            const auto& rect = char_rects[c - ' '];
+            size.x += rect.Size().x + 1;
+            size.y = std::max(size.y, rect.Size().y + 1);
+        }
+        return size;
     }
 }
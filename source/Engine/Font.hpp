@@ -12,11 +12,15 @@
 #include "Rect.hpp"
 #include "Texture.hpp"
 #include "Vec2.hpp"
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include "CS200/IRenderer2D.hpp"
+#include "CS200/SdfFontAtlas.hpp"
 namespace CS230
 {
     /**
@@ -79,6 +83,13 @@ namespace CS230
          * which indicate character boundaries. Each character's rectangular
          * region is calculated and stored for later use during text rendering.
          *
+         * The rectangles are then written to a ".fontmetrics" file in the user
+         * cache folder. Later loads read that file, or the one cs200_cook puts
+         * next to the image, instead, so the image is decoded only once, by the
+         * TextureManager, and the pixel scan is skipped. The file is ignored and
+         * rewritten when the image's contents change or its rectangles do not
+         * fit the loaded texture.
+         *
          * Error Handling:
          * If the font file is malformed (wrong format, missing characters, or
          * incorrect structure), the constructor will throw an error to indicate
@@ -100,31 +111,23 @@ namespace CS230
          * This approach enables text to be drawn with transformations, effects,
          * and blending modes just like sprite graphics.
          *
-         * Advanced Caching System:
-         * - Cache key: Combination of text string and color (format: "text_0xCOLOR")
-         * - Frame tracking: Each cached texture records when it was last accessed
-         * - Reference counting: Uses shared_ptr for automatic memory management
-         * - Intelligent cleanup: Removes old textures only when they have single reference and are older than 60 frames
-         * - Performance optimization: Eliminates redundant text rendering operations
-         *
-         * Caching Strategy:
-         * 1. Check cache using generated key (text + color combination)
-         * 2. If found: Update last-used frame timestamp and return cached texture
-         * 3. If not found: Create new texture, cache it, and return
-         * 4. Periodic cleanup: Remove textures older than 60 frames with reference count of 1
+         * Caching System:
+         * - Cache key: the text and the color, hashed directly from the string view so a hit allocates nothing
+         * - LRU order: every hit moves the entry to the front of an intrusive list, O(1)
+         * - Byte budget: the texture memory of all entries is kept under SetCacheBudget() bytes
+         * - Eviction: least recently used entries go first, skipping textures the caller still holds
          *
          * Rendering Process (for new textures):
          * 1. Measure total text dimensions to determine optimal texture size
          * 2. Create render target texture using TextureManager
          * 3. Render each character from font atlas to the target texture
-         * 4. Store in cache with current frame timestamp
+         * 4. Insert at the front of the LRU list and evict down to the budget
          * 5. Return shared_ptr for client use
          *
          * Memory Management Benefits:
          * - Shared ownership: Multiple objects can reference the same text texture
-         * - Automatic cleanup: Textures are removed when no longer referenced elsewhere
-         * - Frame-based aging: Prevents immediate removal of frequently used text
-         * - Cache efficiency: Only removes textures that are truly unused
+         * - Pinning: a texture still referenced outside the cache is never evicted
+         * - Bounded memory: the budget, not the number of strings, decides how much is kept
          *
          * Text-to-Texture Advantages:
          * - Caching eliminates redundant text rendering for repeated strings
@@ -141,24 +144,142 @@ namespace CS230
          */
         std::shared_ptr<Texture> PrintToTexture(const std::string& text, CS200::RGBA color = 0xFFFFFFFF);
 
+        /**
+         * \brief Draw text straight from the font texture, one quad per glyph
+         * \param display_matrix Transform of the bottom left corner of the text, in the same space as Texture::Draw()
+         * \param text String of text to draw, characters outside ' ' to 'z' are skipped
+         * \param color RGBA color value for the text (default: white)
+         *
+         * Unlike PrintToTexture() nothing is rendered off-screen and nothing is
+         * cached: every glyph is submitted to the 2D renderer as a quad that
+         * samples its char rect from the font texture. Text that changes every
+         * frame (FPS counters, scores, timers) therefore never allocates a
+         * framebuffer or a texture, it only costs the glyph quads.
+         *
+         * Must be called between IRenderer2D::BeginScene() and EndScene().
+         * Layout matches PrintToTexture() exactly, so both paths can be mixed.
+         */
+        void DrawText(const Math::TransformationMatrix& display_matrix, std::string_view text, CS200::RGBA color = 0xFFFFFFFF) const;
+
+        /**
+         * \brief Compute the size in texels the text occupies when drawn with this font
+         * \param text String of text to measure
+         * \return Width is the sum of the glyph widths, height is the tallest glyph
+         */
+        [[nodiscard]] Math::ivec2 MeasureText(std::string_view text) const;
+
+        /**
+         * \brief Counters for the PrintToTexture() cache, used to pick a budget that fits the UI
+         */
+        struct CacheStats
+        {
+            std::uint64_t Hits        = 0;
+            std::uint64_t Misses      = 0;
+            std::uint64_t Evictions   = 0;
+            std::size_t   Entries     = 0;
+            std::size_t   Bytes       = 0;
+            std::size_t   BudgetBytes = 0;
+        };
+
+        /**
+         * \brief Set how many bytes of text textures the cache may keep
+         * \param bytes Budget in bytes, counted as width * height * 4 per texture
+         *
+         * Shrinking the budget evicts immediately. Textures still held by the
+         * caller are pinned and may keep the cache above budget until released.
+         */
+        void SetCacheBudget(std::size_t bytes);
+
+        [[nodiscard]] CacheStats GetCacheStats() const noexcept;
+
+        /**
+         * \brief Texel rectangle of a character in the font texture
+         * \param c Character, anything outside ' ' to 'z' returns the rectangle of ' '
+         */
+        [[nodiscard]] const Math::irect& GetCharRect(char c) const noexcept;
+
+        [[nodiscard]] const std::shared_ptr<Texture>& GetTexture() const noexcept
+        {
+            return font_texture;
+        }
+
+        Font(const Font&)            = delete;
+        Font& operator=(const Font&) = delete;
+
     private:
-    Math::irect& GetCharRect(char c);
 
-    struct Cache
-    {
-        std::shared_ptr<Texture> texture;
-        uint64_t used_time;
-    };
+        void find_char_rects(const std::filesystem::path& file_name);
+        bool load_metrics(const std::filesystem::path& metrics_path, std::uint64_t png_hash);
+        void save_metrics(const std::filesystem::path& metrics_path, std::uint64_t png_hash) const;
+        bool rects_fit(Math::ivec2 texture_size) const noexcept;
+
+        struct CacheKey
+        {
+            std::string Text;
+            CS200::RGBA Color;
+        };
+
+        struct CacheKeyView
+        {
+            std::string_view Text;
+            CS200::RGBA      Color;
+        };
+
+        // transparent so lookups can use a CacheKeyView without building a std::string
+        struct CacheKeyHash
+        {
+            using is_transparent = void;
+            std::size_t operator()(const CacheKeyView& key) const noexcept;
+            std::size_t operator()(const CacheKey& key) const noexcept
+            {
+                return (*this)(CacheKeyView{ key.Text, key.Color });
+            }
+        };
+
+        struct CacheKeyEqual
+        {
+            using is_transparent = void;
+            static CacheKeyView view(const CacheKey& key) noexcept
+            {
+                return { key.Text, key.Color };
+            }
+            static CacheKeyView view(const CacheKeyView& key) noexcept
+            {
+                return key;
+            }
+            bool operator()(const auto& a, const auto& b) const noexcept
+            {
+                return view(a).Color == view(b).Color && view(a).Text == view(b).Text;
+            }
+        };
+
+        // map nodes never move, so the LRU list links straight through them
+        struct Cache
+        {
+            std::shared_ptr<Texture> texture;
+            std::size_t              bytes = 0;
+            const CacheKey*          key   = nullptr;
+            Cache*                   prev  = nullptr;
+            Cache*                   next  = nullptr;
+        };
+
+        void lru_unlink(Cache& entry) noexcept;
+        void lru_push_front(Cache& entry) noexcept;
+        void evict_to_budget();
 
-    std::shared_ptr<Texture> font_texture;
+        std::shared_ptr<Texture> font_texture;
 
-    static constexpr int num_chars = 'z' - ' ' + 1;
+        static constexpr int num_chars = CS200::FontGlyphCount;
 
-    
-    Math::irect char_rects[num_chars]; // filled with the texel width of chars that is recorded by find char rects
+        Math::irect char_rects[num_chars]; // filled with the texel width of chars that is recorded by find char rects
 
-    //container of textures with "key" or id that is a text and color combination.
-    std::unordered_map<std::string,Cache> font_cache;
+        //container of textures with "key" or id that is a text and color combination.
+        std::unordered_map<CacheKey, Cache, CacheKeyHash, CacheKeyEqual> font_cache;
 
+        Cache*      lru_head     = nullptr; // most recently used
+        Cache*      lru_tail     = nullptr; // least recently used
+        std::size_t cache_bytes  = 0;
+        std::size_t cache_budget = 8 * 1024 * 1024;
+        CacheStats  stats{};
     };
 }
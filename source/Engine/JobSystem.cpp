@@ -0,0 +1,346 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "JobSystem.hpp"
+
+struct CS230::JobHandle::Job
+{
+    std::function<void()>             Work{};
+    std::atomic<std::size_t>          Blockers{ 1 }; // unfinished dependencies, plus one held by schedule() while it adds them
+    std::atomic<bool>                 Done{ false };
+    std::mutex                        Mutex{};         // guards Continuations against Done flipping while a dependent registers
+    std::vector<std::shared_ptr<Job>> Continuations{}; // jobs that depend on this one
+    std::exception_ptr                Error{};
+    bool                              MainThreadOnly = false;
+};
+
+namespace
+{
+    // which job system the calling thread works for, and its deque there
+    thread_local const CS230::JobSystem* current_system = nullptr;
+    thread_local std::size_t             current_index  = 0;
+}
+
+namespace CS230
+{
+    bool JobHandle::IsDone() const noexcept
+    {
+        return job == nullptr || job->Done.load(std::memory_order_acquire);
+    }
+
+    JobSystem::JobSystem(unsigned worker_count) : main_thread(std::this_thread::get_id())
+    {
+#if defined(__EMSCRIPTEN__)
+        // no threads on the web build, the main thread runs everything
+        worker_count = 0;
+#else
+        if (worker_count == 0)
+        {
+            const unsigned hardware = std::thread::hardware_concurrency();
+            worker_count            = hardware > 1 ? hardware - 1 : 1;
+        }
+#endif
+        for (unsigned i = 0; i <= worker_count; ++i)
+        {
+            queues.push_back(std::make_unique<WorkerQueue>());
+        }
+        workers.reserve(worker_count);
+        for (std::size_t i = 0; i < worker_count; ++i)
+        {
+            workers.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::scoped_lock lock(sleep_mutex);
+            stopping = true;
+        }
+        work_ready.notify_all();
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    JobHandle JobSystem::Run(std::function<void()> work, std::span<const JobHandle> dependencies)
+    {
+        return schedule(std::move(work), dependencies, false);
+    }
+
+    JobHandle JobSystem::Run(std::function<void()> work, std::initializer_list<JobHandle> dependencies)
+    {
+        return schedule(std::move(work), std::span<const JobHandle>(dependencies.begin(), dependencies.size()), false);
+    }
+
+    JobHandle JobSystem::RunOnMainThread(std::function<void()> work, std::span<const JobHandle> dependencies)
+    {
+        return schedule(std::move(work), dependencies, true);
+    }
+
+    JobHandle JobSystem::RunOnMainThread(std::function<void()> work, std::initializer_list<JobHandle> dependencies)
+    {
+        return schedule(std::move(work), std::span<const JobHandle>(dependencies.begin(), dependencies.size()), true);
+    }
+
+    void JobSystem::Wait(const JobHandle& handle)
+    {
+        Wait(std::span<const JobHandle>(&handle, 1));
+    }
+
+    void JobSystem::Wait(std::span<const JobHandle> handles)
+    {
+        const bool on_main_thread = IsMainThread();
+        for (const auto& handle : handles)
+        {
+            while (!handle.IsDone())
+            {
+                if (!run_one(on_main_thread))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+        // only now, callers of ForkJoin and ParallelFor rely on every job having stopped touching their stack
+        for (const auto& handle : handles)
+        {
+            if (handle.job != nullptr && handle.job->Error)
+            {
+                std::rethrow_exception(handle.job->Error);
+            }
+        }
+    }
+
+    void JobSystem::WaitIdle()
+    {
+        while (outstanding_count.load(std::memory_order_acquire) > 0)
+        {
+            if (!run_one(true))
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void JobSystem::Update()
+    {
+        if (workers.empty())
+        {
+            // only what was queued before this frame, a job that keeps rescheduling itself must not hang it
+            for (std::size_t count = queued_count.load(); count > 0 && run_one(false); --count)
+            {
+            }
+        }
+
+        std::size_t count = 0;
+        {
+            std::scoped_lock lock(main_thread_mutex);
+            count = main_thread_jobs.size();
+        }
+        for (; count > 0; --count)
+        {
+            auto job = pop_main_thread_job();
+            if (job == nullptr)
+            {
+                break;
+            }
+            execute(job);
+        }
+    }
+
+    JobHandle JobSystem::schedule(std::function<void()> work, std::span<const JobHandle> dependencies, bool main_thread_only)
+    {
+        auto job            = std::make_shared<Job>();
+        job->Work           = std::move(work);
+        job->MainThreadOnly = main_thread_only;
+        outstanding_count.fetch_add(1, std::memory_order_relaxed);
+
+        for (const auto& dependency : dependencies)
+        {
+            if (dependency.job == nullptr)
+            {
+                continue;
+            }
+            std::scoped_lock lock(dependency.job->Mutex);
+            if (!dependency.job->Done.load(std::memory_order_relaxed))
+            {
+                job->Blockers.fetch_add(1, std::memory_order_relaxed);
+                dependency.job->Continuations.push_back(job);
+            }
+        }
+
+        JobHandle handle(job);
+        release(std::move(job));
+        return handle;
+    }
+
+    void JobSystem::release(std::shared_ptr<Job> job)
+    {
+        if (job->Blockers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            enqueue(std::move(job));
+        }
+    }
+
+    void JobSystem::enqueue(std::shared_ptr<Job> job)
+    {
+        if (job->MainThreadOnly)
+        {
+            std::scoped_lock lock(main_thread_mutex);
+            main_thread_jobs.push_back(std::move(job));
+            return;
+        }
+
+        auto& queue = *queues[current_queue()];
+        {
+            std::scoped_lock lock(queue.mutex);
+            queue.jobs.push_back(std::move(job));
+        }
+        queued_count.fetch_add(1, std::memory_order_release);
+        if (!workers.empty())
+        {
+            // a worker checks queued_count under sleep_mutex, taking it here means the notify cannot land between its check and its wait
+            {
+                std::scoped_lock lock(sleep_mutex);
+            }
+            work_ready.notify_one();
+        }
+    }
+
+    void JobSystem::execute(const std::shared_ptr<Job>& job)
+    {
+        try
+        {
+            job->Work();
+        }
+        catch (...)
+        {
+            job->Error = std::current_exception();
+        }
+        job->Work = nullptr; // drop the captures now, handles can outlive the job by a long time
+
+        std::vector<std::shared_ptr<Job>> continuations;
+        {
+            std::scoped_lock lock(job->Mutex);
+            job->Done.store(true, std::memory_order_release);
+            continuations.swap(job->Continuations);
+        }
+        for (auto& continuation : continuations)
+        {
+            release(std::move(continuation));
+        }
+        outstanding_count.fetch_sub(1, std::memory_order_release);
+    }
+
+    std::shared_ptr<JobSystem::Job> JobSystem::find_job(std::size_t own_queue)
+    {
+        const auto take = [this](WorkerQueue& queue, bool newest) -> std::shared_ptr<Job>
+        {
+            std::scoped_lock lock(queue.mutex);
+            if (queue.jobs.empty())
+            {
+                return nullptr;
+            }
+            std::shared_ptr<Job> job;
+            if (newest)
+            {
+                job = std::move(queue.jobs.back());
+                queue.jobs.pop_back();
+            }
+            else
+            {
+                job = std::move(queue.jobs.front());
+                queue.jobs.pop_front();
+            }
+            queued_count.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        };
+
+        // own work newest first, the shared queue oldest first, then steal the oldest job of the others
+        const std::size_t shared_queue = queues.size() - 1;
+        if (auto job = take(*queues[own_queue], own_queue != shared_queue))
+        {
+            return job;
+        }
+        if (own_queue != shared_queue)
+        {
+            if (auto job = take(*queues[shared_queue], false))
+            {
+                return job;
+            }
+        }
+        for (std::size_t i = 1; i < queues.size(); ++i)
+        {
+            const std::size_t victim = (own_queue + i) % queues.size();
+            if (victim == shared_queue)
+            {
+                continue;
+            }
+            if (auto job = take(*queues[victim], false))
+            {
+                return job;
+            }
+        }
+        return nullptr;
+    }
+
+    std::shared_ptr<JobSystem::Job> JobSystem::pop_main_thread_job()
+    {
+        std::scoped_lock lock(main_thread_mutex);
+        if (main_thread_jobs.empty())
+        {
+            return nullptr;
+        }
+        auto job = std::move(main_thread_jobs.front());
+        main_thread_jobs.pop_front();
+        return job;
+    }
+
+    std::size_t JobSystem::current_queue() const noexcept
+    {
+        return current_system == this ? current_index : queues.size() - 1;
+    }
+
+    bool JobSystem::run_one(bool allow_main_thread_jobs)
+    {
+        if (auto job = find_job(current_queue()))
+        {
+            execute(job);
+            return true;
+        }
+        if (allow_main_thread_jobs)
+        {
+            if (auto job = pop_main_thread_job())
+            {
+                execute(job);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void JobSystem::worker_loop(std::size_t index)
+    {
+        current_system = this;
+        current_index  = index;
+        while (true)
+        {
+            if (auto job = find_job(index))
+            {
+                execute(job);
+                continue;
+            }
+            std::unique_lock lock(sleep_mutex);
+            work_ready.wait(lock, [this] { return stopping.load() || queued_count.load(std::memory_order_acquire) > 0; });
+            if (stopping)
+            {
+                return;
+            }
+        }
+    }
+}
@@ -0,0 +1,288 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace CS230
+{
+    class JobSystem;
+
+    /**
+     * \brief Something to wait on or depend on for a scheduled job
+     *
+     * Copies refer to the same job. A default constructed handle counts as
+     * already done, so it can stand in for "no dependency".
+     */
+    class JobHandle
+    {
+    public:
+        JobHandle() = default;
+
+        /**
+         * \brief Check without blocking whether the job has run
+         * \return True once the job finished, whether it threw or not
+         */
+        [[nodiscard]] bool IsDone() const noexcept;
+
+    private:
+        friend class JobSystem;
+        struct Job;
+        explicit JobHandle(std::shared_ptr<Job> scheduled) noexcept : job(std::move(scheduled))
+        {
+        }
+
+        std::shared_ptr<Job> job{};
+    };
+
+    /**
+     * \brief Work-stealing thread pool shared by everything that runs in the engine
+     *
+     * Each worker owns a deque of jobs. A job scheduled from a worker goes on
+     * the back of that worker's deque and the worker pops from the back, so the
+     * most recently forked work, which is the work most likely still in cache,
+     * runs first. An idle worker steals from the front of the other deques,
+     * taking the oldest and usually biggest piece. Jobs scheduled from the main
+     * thread go through a shared queue the workers also pull from.
+     *
+     * A thread that waits for a job runs other jobs until it is done instead of
+     * sleeping, so nested fork/join from inside jobs cannot starve the pool, and
+     * the main thread counts as an extra worker while it waits.
+     *
+     * OpenGL calls are only valid on the main thread. RunOnMainThread queues a
+     * job that Engine runs at the start of the next frame (or sooner, if the
+     * main thread waits for it), so a worker can decode an asset and hand the
+     * upload back as a dependent main thread job.
+     *
+     * The web build has no threads: there are no workers and jobs run on the
+     * main thread when it waits for them or when the frame starts.
+     *
+     * An exception thrown by a job is kept and rethrown by Wait. Jobs that depend
+     * on a failed job still run.
+     */
+    class JobSystem
+    {
+    public:
+        /**
+         * \brief Start the worker threads
+         * \param worker_count Threads to start; zero means one less than the hardware threads, leaving a core for the main thread
+         */
+        explicit JobSystem(unsigned worker_count = 0);
+        ~JobSystem();
+
+        JobSystem(const JobSystem&)            = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+        JobSystem(JobSystem&&)                 = delete;
+        JobSystem& operator=(JobSystem&&)      = delete;
+
+        /**
+         * \brief Schedule a job on the workers
+         * \param work What to run; it may schedule and wait for more jobs
+         * \param dependencies Jobs that must finish before this one starts
+         * \return Handle to wait on or to pass as a dependency of later jobs
+         */
+        JobHandle Run(std::function<void()> work, std::span<const JobHandle> dependencies = {});
+        JobHandle Run(std::function<void()> work, std::initializer_list<JobHandle> dependencies);
+
+        /**
+         * \brief Schedule a job that only the main thread runs, for OpenGL and other main thread only work
+         * \param work What to run
+         * \param dependencies Jobs that must finish before this one starts
+         * \return Handle to wait on or to pass as a dependency of later jobs
+         */
+        JobHandle RunOnMainThread(std::function<void()> work, std::span<const JobHandle> dependencies = {});
+        JobHandle RunOnMainThread(std::function<void()> work, std::initializer_list<JobHandle> dependencies);
+
+        /**
+         * \brief Block until a job finished, running other jobs in the meantime
+         *
+         * Rethrows the exception the job threw, if any. Waiting from a worker on
+         * a main thread job is only safe if the main thread is not waiting on
+         * that worker.
+         */
+        void Wait(const JobHandle& handle);
+        void Wait(std::span<const JobHandle> handles);
+
+        /**
+         * \brief Block until every job scheduled so far, main thread jobs included, finished
+         *
+         * Only call this from the main thread. Engine does before it unloads
+         * resources that jobs might still use.
+         */
+        void WaitIdle();
+
+        /**
+         * \brief Run the main thread jobs that are ready; Engine calls this once per frame
+         *
+         * On the web build this also runs the jobs nobody waited for yet.
+         */
+        void Update();
+
+        /**
+         * \brief Run functions in parallel and return when all of them have
+         *
+         * The last function runs on the calling thread. If several throw, the
+         * first one's exception in argument order is rethrown.
+         */
+        template <typename... Functions>
+        void ForkJoin(Functions&&... functions);
+
+        /**
+         * \brief Split [0, count) into ranges of at least grain items and call body(begin, end) on each, in parallel
+         *
+         * Returns when every range is done. The calling thread takes a range
+         * too. Ranges are disjoint, so the body may write to its own items
+         * without locking.
+         * \param count Number of items
+         * \param grain Smallest range worth a job; below roughly a few microseconds of work the scheduling costs more than it saves
+         * \param body Callable as body(std::size_t begin, std::size_t end)
+         */
+        template <typename Body>
+        void ParallelFor(std::size_t count, std::size_t grain, Body&& body);
+
+        /**
+         * \brief Number of worker threads, not counting the main thread
+         */
+        [[nodiscard]] unsigned GetWorkerCount() const noexcept
+        {
+            return static_cast<unsigned>(workers.size());
+        }
+
+        /**
+         * \brief Whether the calling thread is the one that created the job system
+         */
+        [[nodiscard]] bool IsMainThread() const noexcept
+        {
+            return std::this_thread::get_id() == main_thread;
+        }
+
+    private:
+        using Job = JobHandle::Job;
+
+        struct WorkerQueue
+        {
+            std::mutex                       mutex{};
+            std::deque<std::shared_ptr<Job>> jobs{};
+        };
+
+        JobHandle schedule(std::function<void()> work, std::span<const JobHandle> dependencies, bool main_thread_only);
+        void      release(std::shared_ptr<Job> job);
+        void      enqueue(std::shared_ptr<Job> job);
+        void      execute(const std::shared_ptr<Job>& job);
+
+        std::shared_ptr<Job> find_job(std::size_t own_queue);
+        std::shared_ptr<Job> pop_main_thread_job();
+        std::size_t          current_queue() const noexcept;
+        bool                 run_one(bool allow_main_thread_jobs);
+        void                 worker_loop(std::size_t index);
+
+        std::thread::id main_thread;
+
+        // one deque per worker plus the shared one at index workers.size() for other threads
+        std::vector<std::unique_ptr<WorkerQueue>> queues{};
+        std::deque<std::shared_ptr<Job>>          main_thread_jobs{};
+        std::mutex                                main_thread_mutex{};
+
+        std::atomic<std::size_t> queued_count{ 0 };      // runnable jobs sitting in the worker queues
+        std::atomic<std::size_t> outstanding_count{ 0 }; // scheduled jobs that have not finished
+        std::atomic<bool>        stopping{ false };
+        std::mutex               sleep_mutex{};
+        std::condition_variable  work_ready{};
+
+        std::vector<std::thread> workers{};
+    };
+
+    template <typename... Functions>
+    void JobSystem::ForkJoin(Functions&&... functions)
+    {
+        static_assert(sizeof...(Functions) > 0);
+        std::vector<JobHandle> forked;
+        forked.reserve(sizeof...(Functions) - 1);
+
+        // the calling thread takes the last one, then helps until the rest are done
+        std::size_t        index = 0;
+        std::exception_ptr error;
+        const auto         fork_or_run = [&](auto& function)
+        {
+            if (++index < sizeof...(Functions))
+            {
+                forked.push_back(Run([&function] { function(); }));
+                return;
+            }
+            try
+            {
+                function();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+        };
+        (fork_or_run(functions), ...);
+        Wait(forked);
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    template <typename Body>
+    void JobSystem::ParallelFor(std::size_t count, std::size_t grain, Body&& body)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        grain = std::max<std::size_t>(grain, 1);
+
+        // a few ranges per thread so stealing can even out uneven items
+        const std::size_t threads = std::size_t{ GetWorkerCount() } + 1;
+        const std::size_t ranges  = std::clamp<std::size_t>(count / grain, 1, threads * 4);
+        if (ranges == 1)
+        {
+            body(std::size_t{ 0 }, count);
+            return;
+        }
+
+        const std::size_t      range_size = (count + ranges - 1) / ranges;
+        std::vector<JobHandle> forked;
+        forked.reserve(ranges - 1);
+        for (std::size_t begin = range_size; begin < count; begin += range_size)
+        {
+            const std::size_t end = std::min(begin + range_size, count);
+            forked.push_back(Run([&body, begin, end] { body(begin, end); }));
+        }
+
+        std::exception_ptr error;
+        try
+        {
+            body(std::size_t{ 0 }, std::min(range_size, count));
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        Wait(forked);
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
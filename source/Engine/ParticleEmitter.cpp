@@ -0,0 +1,334 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+#include "ParticleEmitter.hpp"
+
+#include "JobSystem.hpp"
+#include "OpenGL/GL.hpp"
+#include "OpenGL/UniformBlock.hpp"
+#include "Path.hpp"
+#include <algorithm>
+#include <array>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define CS230_PARTICLES_SSE2 1
+#    include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    define CS230_PARTICLES_NEON 1
+#    include <arm_neon.h>
+#endif
+
+namespace CS230
+{
+    namespace
+    {
+        constexpr std::size_t FloatsPerInstance = 4;
+        constexpr std::size_t ParallelThreshold = 16384; // below this the whole pool takes less than a job switch
+        constexpr std::size_t GroupsPerJob      = 1024;  // groups of four particles
+
+        constexpr std::size_t padded(std::size_t count) noexcept
+        {
+            return (count + 3) & ~std::size_t{ 3 };
+        }
+
+        // xorshift32, one state per simulated range so threads never share it
+        float random_unit(std::uint32_t& state) noexcept
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+        }
+
+        float random_between(std::uint32_t& state, double min, double max) noexcept
+        {
+            return static_cast<float>(min + (max - min) * static_cast<double>(random_unit(state)));
+        }
+
+#if !defined(CS230_PARTICLES_SSE2) && !defined(CS230_PARTICLES_NEON)
+        // sin(pi * t) for t >= 0: a parabola per half period, refined, off by at most 0.001
+        float sin_pi(float t) noexcept
+        {
+            const int   period   = static_cast<int>(t);
+            const float fraction = t - static_cast<float>(period);
+            float       y        = 4.0f * fraction * (1.0f - fraction);
+            y                    = y * (0.775f + 0.225f * y);
+            return (period & 1) != 0 ? -y : y;
+        }
+#endif
+
+        std::shared_ptr<OpenGL::CompiledShader> acquire_shader()
+        {
+            static std::weak_ptr<OpenGL::CompiledShader> shared;
+            if (auto existing = shared.lock())
+            {
+                return existing;
+            }
+
+            auto created = std::shared_ptr<OpenGL::CompiledShader>(
+                new OpenGL::CompiledShader(
+                    OpenGL::CreateShader(assets::locate_asset("Assets/shaders/Particles/particle.vert"), assets::locate_asset("Assets/shaders/Particles/particle.frag"))),
+                [](OpenGL::CompiledShader* compiled)
+                {
+                    OpenGL::DestroyShader(*compiled);
+                    delete compiled;
+                });
+            OpenGL::SetUniformBlockBinding(created->Shader, "Camera", 0);
+            shared = created;
+            return created;
+        }
+    }
+
+    ParticleEmitter::ParticleEmitter(const Settings& initial_settings, std::size_t initial_count) : settings(initial_settings), shader(acquire_shader())
+    {
+        GL::GenVertexArrays(1, &vao);
+        GL::GenBuffers(1, &quadBuffer);
+        GL::GenBuffers(1, &instanceBuffer);
+
+        // unit quad as a triangle strip, scaled and placed per instance in the vertex shader
+        constexpr std::array<float, 8> corners = { -0.5f, -0.5f, 0.5f, -0.5f, -0.5f, 0.5f, 0.5f, 0.5f };
+        GL::BindVertexArray(vao);
+        GL::BindBuffer(GL_ARRAY_BUFFER, quadBuffer);
+        GL::BufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(sizeof(corners)), corners.data(), GL_STATIC_DRAW);
+        GL::EnableVertexAttribArray(0);
+        GL::VertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), reinterpret_cast<void*>(0));
+        GL::BindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+        GL::EnableVertexAttribArray(1);
+        GL::VertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, FloatsPerInstance * sizeof(float), reinterpret_cast<void*>(0));
+        GL::VertexAttribDivisor(1, 1);
+        GL::BindVertexArray(0);
+        GL::BindBuffer(GL_ARRAY_BUFFER, 0);
+
+        SetCount(initial_count);
+    }
+
+    ParticleEmitter::~ParticleEmitter()
+    {
+        GL::DeleteBuffers(1, &instanceBuffer);
+        GL::DeleteBuffers(1, &quadBuffer);
+        GL::DeleteVertexArrays(1, &vao);
+    }
+
+    void ParticleEmitter::SetCount(std::size_t new_count)
+    {
+        const std::size_t old_count = count;
+        const std::size_t storage   = padded(new_count);
+        for (auto* array : { &positionX, &positionY, &velocityX, &velocityY, &sizes, &ages, &inverseLifetimes })
+        {
+            array->resize(storage);
+        }
+        instances.resize(storage * FloatsPerInstance);
+        count = new_count;
+
+        // the padding lanes get real particles too, the kernel runs over them even though they are not drawn
+        std::uint32_t random_state = (++frame * 0x9E3779B9u) | 1u;
+        for (std::size_t i = old_count; i < storage; ++i)
+        {
+            spawn(i, random_state);
+        }
+    }
+
+    void ParticleEmitter::Update(double delta_time, JobSystem* jobs)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        const float         dt     = static_cast<float>(delta_time);
+        const std::uint32_t seed   = ++frame * 0x9E3779B9u;
+        const std::size_t   groups = padded(count) / 4;
+        const auto          run    = [this, dt, seed](std::size_t first_group, std::size_t last_group)
+        { simulate(first_group * 4, last_group * 4, dt, seed ^ static_cast<std::uint32_t>(first_group * 0x85EBCA6Bu)); };
+
+        if (jobs != nullptr && count >= ParallelThreshold)
+        {
+            jobs->ParallelFor(groups, GroupsPerJob, run);
+        }
+        else
+        {
+            run(0, groups);
+        }
+    }
+
+    void ParticleEmitter::Draw(const Math::TransformationMatrix& display_matrix) const
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        // orphan the old storage each frame so the driver never waits on last frame's draw
+        const auto bytes = static_cast<GLsizeiptr>(count * FloatsPerInstance * sizeof(float));
+        GL::BindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+        bufferCapacity = std::max(bufferCapacity, count);
+        GL::BufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bufferCapacity * FloatsPerInstance * sizeof(float)), nullptr, GL_STREAM_DRAW);
+        GL::BufferSubData(GL_ARRAY_BUFFER, 0, bytes, instances.data());
+        GL::BindBuffer(GL_ARRAY_BUFFER, 0);
+
+        GL::UseProgram(shader->Shader);
+        const float model[9] = {
+            static_cast<float>(display_matrix[0][0]), static_cast<float>(display_matrix[1][0]), static_cast<float>(display_matrix[2][0]),
+            static_cast<float>(display_matrix[0][1]), static_cast<float>(display_matrix[1][1]), static_cast<float>(display_matrix[2][1]),
+            static_cast<float>(display_matrix[0][2]), static_cast<float>(display_matrix[1][2]), static_cast<float>(display_matrix[2][2]),
+        };
+        if (shader->UniformLocations.contains("uModel"))
+            GL::UniformMatrix3fv(shader->UniformLocations.at("uModel"), 1, GL_FALSE, model);
+        if (shader->UniformLocations.contains("uColor"))
+        {
+            const auto c = CS200::unpack_color(settings.Color);
+            GL::Uniform4f(shader->UniformLocations.at("uColor"), c[0], c[1], c[2], c[3]);
+        }
+
+        GL::BindVertexArray(vao);
+        GL::DrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(count));
+        GL::BindVertexArray(0);
+    }
+
+    void ParticleEmitter::simulate(std::size_t begin, std::size_t end, float dt, std::uint32_t seed)
+    {
+        std::uint32_t random_state = seed | 1u;
+        const float   ax           = static_cast<float>(settings.Acceleration.x) * dt;
+        const float   ay           = static_cast<float>(settings.Acceleration.y) * dt;
+        const float   sway         = static_cast<float>(settings.Sway) * dt;
+        const float   left         = static_cast<float>(settings.Bounds.Left());
+        const float   right        = static_cast<float>(settings.Bounds.Right());
+        const float   bottom       = static_cast<float>(settings.Bounds.Bottom());
+        const float   top          = static_cast<float>(settings.Bounds.Top());
+
+        float* const x        = positionX.data();
+        float* const y        = positionY.data();
+        float* const vx       = velocityX.data();
+        float* const vy       = velocityY.data();
+        float* const size     = sizes.data();
+        float* const age      = ages.data();
+        float* const inv_life = inverseLifetimes.data();
+        float* const instance = instances.data();
+
+        for (std::size_t i = begin; i < end; i += 4)
+        {
+            unsigned dead = 0; // bit per lane
+#if defined(CS230_PARTICLES_SSE2)
+            // sin(pi * age) with the same parabola as sin_pi(), the period's parity flips the sign bit
+            const __m128  t      = _mm_loadu_ps(age + i);
+            const __m128i period = _mm_cvttps_epi32(t);
+            const __m128  f      = _mm_sub_ps(t, _mm_cvtepi32_ps(period));
+            __m128        wave   = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(4.0f), f), _mm_sub_ps(_mm_set1_ps(1.0f), f));
+            wave                 = _mm_mul_ps(wave, _mm_add_ps(_mm_set1_ps(0.775f), _mm_mul_ps(_mm_set1_ps(0.225f), wave)));
+            wave                 = _mm_xor_ps(wave, _mm_castsi128_ps(_mm_slli_epi32(period, 31)));
+
+            const __m128 step = _mm_set1_ps(dt);
+            const __m128 s    = _mm_loadu_ps(size + i);
+            const __m128 vx4  = _mm_add_ps(_mm_loadu_ps(vx + i), _mm_set1_ps(ax));
+            const __m128 vy4  = _mm_add_ps(_mm_loadu_ps(vy + i), _mm_set1_ps(ay));
+            const __m128 x4   = _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(vx4, step));
+            const __m128 y4   = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(vy4, step)), _mm_mul_ps(_mm_mul_ps(wave, s), _mm_set1_ps(sway)));
+            const __m128 aged = _mm_add_ps(t, step);
+            const __m128 fade = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(aged, _mm_loadu_ps(inv_life + i)));
+
+            __m128 gone = _mm_cmple_ps(fade, _mm_setzero_ps());
+            gone        = _mm_or_ps(gone, _mm_or_ps(_mm_cmplt_ps(x4, _mm_set1_ps(left)), _mm_cmpgt_ps(x4, _mm_set1_ps(right))));
+            gone        = _mm_or_ps(gone, _mm_or_ps(_mm_cmplt_ps(y4, _mm_set1_ps(bottom)), _mm_cmpgt_ps(y4, _mm_set1_ps(top))));
+            dead        = static_cast<unsigned>(_mm_movemask_ps(gone));
+
+            _mm_storeu_ps(vx + i, vx4);
+            _mm_storeu_ps(vy + i, vy4);
+            _mm_storeu_ps(x + i, x4);
+            _mm_storeu_ps(y + i, y4);
+            _mm_storeu_ps(age + i, aged);
+
+            // rows of x, y, size, alpha become one instance per particle
+            __m128 r0 = x4, r1 = y4, r2 = s, r3 = _mm_max_ps(fade, _mm_setzero_ps());
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            float* const out = instance + i * FloatsPerInstance;
+            _mm_storeu_ps(out, r0);
+            _mm_storeu_ps(out + 4, r1);
+            _mm_storeu_ps(out + 8, r2);
+            _mm_storeu_ps(out + 12, r3);
+#elif defined(CS230_PARTICLES_NEON)
+            const float32x4_t t      = vld1q_f32(age + i);
+            const int32x4_t   period = vcvtq_s32_f32(t);
+            const float32x4_t f      = vsubq_f32(t, vcvtq_f32_s32(period));
+            float32x4_t       wave   = vmulq_f32(vmulq_n_f32(f, 4.0f), vsubq_f32(vdupq_n_f32(1.0f), f));
+            wave                     = vmulq_f32(wave, vmlaq_n_f32(vdupq_n_f32(0.775f), wave, 0.225f));
+            wave = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(wave), vshlq_n_u32(vreinterpretq_u32_s32(period), 31)));
+
+            const float32x4_t s    = vld1q_f32(size + i);
+            const float32x4_t vx4  = vaddq_f32(vld1q_f32(vx + i), vdupq_n_f32(ax));
+            const float32x4_t vy4  = vaddq_f32(vld1q_f32(vy + i), vdupq_n_f32(ay));
+            const float32x4_t x4   = vmlaq_n_f32(vld1q_f32(x + i), vx4, dt);
+            const float32x4_t y4   = vmlaq_n_f32(vmlaq_n_f32(vld1q_f32(y + i), vy4, dt), vmulq_f32(wave, s), sway);
+            const float32x4_t aged = vaddq_f32(t, vdupq_n_f32(dt));
+            const float32x4_t fade = vmlsq_f32(vdupq_n_f32(1.0f), aged, vld1q_f32(inv_life + i));
+
+            uint32x4_t gone = vcleq_f32(fade, vdupq_n_f32(0.0f));
+            gone            = vorrq_u32(gone, vorrq_u32(vcltq_f32(x4, vdupq_n_f32(left)), vcgtq_f32(x4, vdupq_n_f32(right))));
+            gone            = vorrq_u32(gone, vorrq_u32(vcltq_f32(y4, vdupq_n_f32(bottom)), vcgtq_f32(y4, vdupq_n_f32(top))));
+            std::array<std::uint32_t, 4> lanes{};
+            vst1q_u32(lanes.data(), gone);
+            for (unsigned lane = 0; lane < 4; ++lane)
+            {
+                dead |= (lanes[lane] & 1u) << lane;
+            }
+
+            vst1q_f32(vx + i, vx4);
+            vst1q_f32(vy + i, vy4);
+            vst1q_f32(x + i, x4);
+            vst1q_f32(y + i, y4);
+            vst1q_f32(age + i, aged);
+            vst4q_f32(instance + i * FloatsPerInstance, (float32x4x4_t{ { x4, y4, s, vmaxq_f32(fade, vdupq_n_f32(0.0f)) } }));
+#else
+            for (std::size_t lane = 0; lane < 4; ++lane)
+            {
+                const std::size_t p    = i + lane;
+                const float       wave = sin_pi(age[p]);
+                vx[p] += ax;
+                vy[p] += ay;
+                x[p] += vx[p] * dt;
+                y[p] += vy[p] * dt + wave * size[p] * sway;
+                age[p] += dt;
+                const float fade = 1.0f - age[p] * inv_life[p];
+                if (fade <= 0.0f || x[p] < left || x[p] > right || y[p] < bottom || y[p] > top)
+                {
+                    dead |= 1u << lane;
+                }
+                float* const out = instance + p * FloatsPerInstance;
+                out[0]           = x[p];
+                out[1]           = y[p];
+                out[2]           = size[p];
+                out[3]           = std::max(fade, 0.0f);
+            }
+#endif
+            // rare compared to the moves, so done one particle at a time
+            for (std::size_t lane = 0; dead != 0; ++lane, dead >>= 1)
+            {
+                if ((dead & 1u) != 0)
+                {
+                    spawn(i + lane, random_state);
+                }
+            }
+        }
+    }
+
+    void ParticleEmitter::spawn(std::size_t index, std::uint32_t& random_state)
+    {
+        const auto& area        = settings.SpawnArea;
+        positionX[index]        = random_between(random_state, area.Left(), area.Right());
+        positionY[index]        = random_between(random_state, area.Bottom(), area.Top());
+        velocityX[index]        = random_between(random_state, settings.VelocityMin.x, settings.VelocityMax.x);
+        velocityY[index]        = random_between(random_state, settings.VelocityMin.y, settings.VelocityMax.y);
+        sizes[index]            = random_between(random_state, settings.SizeMin, settings.SizeMax);
+        ages[index]             = 0.0f;
+        inverseLifetimes[index] = 1.0f / std::max(random_between(random_state, settings.LifetimeMin, settings.LifetimeMax), 1e-3f);
+
+        float* const out = instances.data() + index * FloatsPerInstance;
+        out[0]           = positionX[index];
+        out[1]           = positionY[index];
+        out[2]           = sizes[index];
+        out[3]           = 1.0f;
+    }
+}
@@ -0,0 +1,128 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+#pragma once
+#include "CS200/RGBA.hpp"
+#include "Matrix.hpp"
+#include "OpenGL/Handle.hpp"
+#include "OpenGL/Shader.hpp"
+#include "Rect.hpp"
+#include "Vec2.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace CS230
+{
+    class JobSystem;
+
+    /**
+     * \brief A pool of round particles simulated in structure-of-arrays form and drawn with one instanced call
+     *
+     * Every particle attribute lives in its own float array, so Update() reads
+     * and writes them four particles at a time with SSE2 or NEON (plain floats
+     * elsewhere) and writes the per-instance data (center, size, alpha) the
+     * vertex shader needs in the same pass. Large emitters split the work over
+     * the JobSystem. A particle that outlives its lifetime or leaves the
+     * bounds is respawned in place, so the count stays what SetCount() asked.
+     *
+     * Draw() uploads the instance data into one stream buffer and draws every
+     * particle with a single glDrawArraysInstanced of a unit quad, the circle
+     * is cut out in the fragment shader. Wind, sparks and fog differ only in
+     * their Settings.
+     *
+     * Needs a current OpenGL context.
+     */
+    class ParticleEmitter
+    {
+    public:
+        /**
+         * \brief How particles spawn and move; can change every frame, respawned particles pick up the new values
+         */
+        struct Settings
+        {
+            Math::rect  SpawnArea{};                ///< Particles start at a uniformly random point inside
+            Math::rect  Bounds{};                   ///< Particles leaving it respawn
+            Math::vec2  VelocityMin{ 0.0, 0.0 };    ///< Start velocity range, per component, in pixels per second
+            Math::vec2  VelocityMax{ 0.0, 0.0 };
+            Math::vec2  Acceleration{ 0.0, 0.0 };   ///< Gravity or wind push, pixels per second squared
+            double      SizeMin     = 1.0;          ///< Diameter range in pixels
+            double      SizeMax     = 1.0;
+            double      LifetimeMin = 1.0;          ///< Seconds until a particle fades out and respawns
+            double      LifetimeMax = 1.0;
+            double      Sway        = 0.0;          ///< Vertical drift of sin(pi * age) * Sway * size pixels per second
+            CS200::RGBA Color       = CS200::WHITE; ///< Alpha is further scaled by 1 - age / lifetime
+        };
+
+        explicit ParticleEmitter(const Settings& settings, std::size_t count = 0);
+        ~ParticleEmitter();
+
+        ParticleEmitter(const ParticleEmitter&)            = delete;
+        ParticleEmitter& operator=(const ParticleEmitter&) = delete;
+
+        /**
+         * \brief Grow or shrink the pool; new particles spawn right away
+         */
+        void SetCount(std::size_t count);
+
+        [[nodiscard]] std::size_t GetCount() const noexcept
+        {
+            return count;
+        }
+
+        [[nodiscard]] Settings& GetSettings() noexcept
+        {
+            return settings;
+        }
+
+        [[nodiscard]] const Settings& GetSettings() const noexcept
+        {
+            return settings;
+        }
+
+        /**
+         * \brief Move, age and respawn every particle
+         * \param delta_time Seconds since the last update
+         * \param jobs When given and the pool is large, the particles are split into ranges run by the job system
+         */
+        void Update(double delta_time, JobSystem* jobs = nullptr);
+
+        /**
+         * \brief Draw every particle in one instanced call
+         * \param display_matrix Transform applied to the particle positions
+         *
+         * Must be called between IRenderer2D::BeginScene() and EndScene().
+         */
+        void Draw(const Math::TransformationMatrix& display_matrix = {}) const;
+
+    private:
+        void simulate(std::size_t begin, std::size_t end, float delta_time, std::uint32_t seed);
+        void spawn(std::size_t index, std::uint32_t& random_state);
+
+        Settings      settings;
+        std::size_t   count = 0;
+        std::uint32_t frame = 0; // seeds the respawn randomness so ranges run on different threads stay independent
+
+        // one array per attribute, padded to a multiple of four particles
+        std::vector<float> positionX;
+        std::vector<float> positionY;
+        std::vector<float> velocityX;
+        std::vector<float> velocityY;
+        std::vector<float> sizes;
+        std::vector<float> ages;
+        std::vector<float> inverseLifetimes;
+        std::vector<float> instances; // x, y, size, alpha per particle, the layout of the instance buffer
+
+        std::shared_ptr<OpenGL::CompiledShader> shader;
+        OpenGL::Handle                          vao            = 0;
+        OpenGL::Handle                          quadBuffer     = 0;
+        OpenGL::Handle                          instanceBuffer = 0;
+        mutable std::size_t                     bufferCapacity = 0; // particles the instance buffer holds
+    };
+}
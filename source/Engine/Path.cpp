@@ -7,11 +7,19 @@
  */
 #include "Path.hpp"
 
+#include "AssetPack.hpp"
+#include "AssetRegistry.hpp"
 #include <SDL.h>
+#include <array>
+#include <fstream>
+#include <memory>
 #include <optional>
+#include <vector>
 
 namespace
 {
+    std::unique_ptr<assets::AssetPack> mounted_pack;
+
     std::optional<std::filesystem::path> try_get_asset_path(const std::filesystem::path& starting_directory)
     {
         namespace fs                 = std::filesystem;
@@ -58,6 +66,15 @@ namespace assets
 
     std::filesystem::path locate_asset(const std::filesystem::path& asset_path)
     {
+        return resolve_asset(intern_asset(asset_path));
+    }
+
+    std::filesystem::path search_asset(const std::filesystem::path& asset_path)
+    {
+        if (is_packed(asset_path))
+        {
+            return asset_path;
+        }
         auto asset_filepath = asset_path;
         if (!std::filesystem::exists(asset_filepath))
         {
@@ -70,4 +87,101 @@ namespace assets
         }
         return asset_filepath;
     }
+
+    std::filesystem::path get_cache_path()
+    {
+        namespace fs                 = std::filesystem;
+        static fs::path cache_folder = []()
+        {
+            // per-user writable folder, the assets folder may be read only once installed
+            fs::path   result;
+            const auto pref_path = SDL_GetPrefPath("DigiPen", "cs200_fun");
+            if (pref_path != nullptr)
+            {
+                result = fs::path(pref_path) / "cache";
+                SDL_free(pref_path);
+            }
+            else
+            {
+                result = fs::temp_directory_path() / "cs200_fun" / "cache";
+            }
+            std::error_code ec;
+            fs::create_directories(result, ec);
+            return result;
+        }();
+        return cache_folder;
+    }
+
+    void mount_pack(const std::filesystem::path& pack_path)
+    {
+        mounted_pack = AssetPack::Open(pack_path);
+        forget_asset_locations();
+    }
+
+    void unmount_pack()
+    {
+        mounted_pack.reset();
+        forget_asset_locations();
+    }
+
+    std::optional<std::filesystem::path> mount_default_pack()
+    {
+        namespace fs = std::filesystem;
+        std::vector<fs::path> candidates{ fs::current_path() / "assets.pak" };
+        if (const auto base_path = SDL_GetBasePath(); base_path != nullptr)
+        {
+            candidates.push_back(fs::path(base_path) / "assets.pak");
+            SDL_free(base_path);
+        }
+        for (const auto& candidate : candidates)
+        {
+            std::error_code ec;
+            if (fs::is_regular_file(candidate, ec))
+            {
+                mount_pack(candidate);
+                return candidate;
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::optional<std::span<const std::uint8_t>> find_packed(const std::filesystem::path& asset_path)
+    {
+        if (!mounted_pack)
+        {
+            return std::nullopt;
+        }
+        return mounted_pack->Find(pack_key(asset_path));
+    }
+
+    bool is_packed(const std::filesystem::path& asset_path)
+    {
+        return mounted_pack && mounted_pack->Contains(pack_key(asset_path));
+    }
+
+    std::optional<std::uint64_t> hash_asset(const std::filesystem::path& asset_path)
+    {
+        if (const auto packed = find_packed(asset_path))
+        {
+            return hash_bytes(*packed);
+        }
+        std::ifstream file(asset_path, std::ios::binary);
+        if (!file)
+        {
+            return std::nullopt;
+        }
+        std::array<char, 64 * 1024> buffer{};
+        std::uint64_t               hash = FnvOffsetBasis;
+        do
+        {
+            file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            const auto read = static_cast<std::size_t>(file.gcount());
+            hash            = hash_bytes(std::span(reinterpret_cast<const std::uint8_t*>(buffer.data()), read), hash);
+        } while (file);
+        if (file.bad())
+        {
+            return std::nullopt;
+        }
+        return hash;
+    }
 }
@@ -7,11 +7,66 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
+#include <optional>
+#include <span>
 
 namespace assets
 {
 
     std::filesystem::path get_base_path();
+
+    /**
+     * \brief Find the file for an asset path
+     *
+     * With a pack mounted and holding the asset this returns the path as
+     * given without touching the file system; loaders then read it through
+     * find_packed(). Otherwise the loose file is searched for as before.
+     *
+     * The path is interned in the asset registry and the answer remembered,
+     * so asking again for the same asset costs a hash lookup, not a stat.
+     */
     std::filesystem::path locate_asset(const std::filesystem::path& asset_path);
+
+    /**
+     * \brief The search behind locate_asset(), done again on every call
+     * \throw std::runtime_error if the asset is neither packed nor a loose file
+     */
+    std::filesystem::path search_asset(const std::filesystem::path& asset_path);
+    std::filesystem::path get_cache_path();
+
+    /**
+     * \brief Map an asset pack that locate_asset() and the loaders check before loose files
+     * \throw std::runtime_error if the file is not a valid pack
+     *
+     * Call at startup before anything loads, and unmount_pack() after
+     * everything stopped loading; lookups themselves are thread safe.
+     */
+    void mount_pack(const std::filesystem::path& pack_path);
+    void unmount_pack();
+
+    /**
+     * \brief Mount assets.pak from the working directory or the executable's folder, if there is one
+     * \return The pack mounted, nothing when running from loose files
+     */
+    std::optional<std::filesystem::path> mount_default_pack();
+
+    /**
+     * \brief Bytes of an asset in the mounted pack, valid until unmount_pack()
+     * \return Nothing without a pack or when the pack does not hold the asset
+     */
+    std::optional<std::span<const std::uint8_t>> find_packed(const std::filesystem::path& asset_path);
+
+    /**
+     * \brief Whether the mounted pack holds an asset, without reading or inflating it
+     */
+    bool is_packed(const std::filesystem::path& asset_path);
+
+    /**
+     * \brief hash_bytes() of an asset, read from the mounted pack or the file
+     * \param asset_path A path locate_asset() returned
+     * \return Nothing if the asset cannot be read
+     */
+    std::optional<std::uint64_t> hash_asset(const std::filesystem::path& asset_path);
 }
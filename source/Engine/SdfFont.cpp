@@ -0,0 +1,208 @@
+/**
+ * \file
+ * \author Junseok lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+#include "SdfFont.hpp"
+
+#include "AssetPack.hpp"
+#include "CS200/Image.hpp"
+#include "CS200/SdfFontAtlas.hpp"
+#include "Engine.hpp"
+#include "Logger.hpp"
+#include "OpenGL/GL.hpp"
+#include "OpenGL/UniformBlock.hpp"
+#include "Path.hpp"
+#include "Timer.hpp"
+#include <algorithm>
+#include <array>
+#include <iomanip>
+#include <sstream>
+
+namespace CS230
+{
+    namespace
+    {
+        constexpr int FloatsPerVertex = 4;
+        constexpr int FloatsPerGlyph  = 6 * FloatsPerVertex;
+
+        CS200::SdfFontAtlas load_or_generate(const std::filesystem::path& bitmap_font_path, int spread, int glyph_count)
+        {
+            const auto png_path     = assets::locate_asset(bitmap_font_path);
+            auto       sidecar_path = png_path;
+            const auto png_hash     = assets::hash_asset(png_path).value_or(0);
+            sidecar_path.replace_extension(".sdffont");
+            // one next to the png comes from cs200_cook or cs200_sdf_font; the game writes its own to the cache, never into Assets
+            const auto cache_path = assets::get_cache_path() / assets::pack_key(sidecar_path);
+
+            for (const auto& candidate : { sidecar_path, cache_path })
+            {
+                if (auto atlas = CS200::ReadSdfFontAtlas(candidate, png_hash); atlas && atlas->Spread == spread && static_cast<int>(atlas->Glyphs.size()) == glyph_count)
+                {
+                    return std::move(*atlas);
+                }
+            }
+
+            util::Timer              timer;
+            const CS200::Image       image(bitmap_font_path);
+            std::vector<Math::irect> rects(static_cast<std::size_t>(glyph_count));
+            CS200::ScanGlyphRects(image, rects);
+            auto atlas = CS200::GenerateSdfFontAtlas(image, rects, spread);
+
+            std::ostringstream message;
+            message << std::fixed << std::setprecision(1) << "Generated SDF atlas for " << png_path.filename().string() << " (" << atlas.Size.x << 'x' << atlas.Size.y << ") in "
+                    << timer.GetElapsedSeconds() * 1000.0 << " ms";
+            Engine::GetLogger().LogEvent(message.str());
+
+            std::error_code ec;
+            std::filesystem::create_directories(cache_path.parent_path(), ec);
+            if (!CS200::WriteSdfFontAtlas(cache_path, atlas, png_hash))
+            {
+                Engine::GetLogger().LogDebug("Cannot save SDF atlas for " + png_path.string());
+            }
+            return atlas;
+        }
+
+        std::array<float, 4> to_floats(CS200::RGBA color)
+        {
+            const auto c = CS200::unpack_color(color);
+            return { c[0], c[1], c[2], c[3] };
+        }
+    }
+
+    SdfFont::SdfFont(const std::filesystem::path& bitmap_font_path, int spread_in_texels) : spread(spread_in_texels)
+    {
+        auto atlas = load_or_generate(bitmap_font_path, spread, num_chars);
+        atlas_size = atlas.Size;
+        glyphs     = std::move(atlas.Glyphs);
+        advances   = std::move(atlas.Source);
+
+        GL::GenTextures(1, &atlas_texture);
+        GL::BindTexture(GL_TEXTURE_2D, atlas_texture);
+        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        // rows of an R8 texture are not 4 byte aligned
+        GL::PixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        GL::TexImage2D(GL_TEXTURE_2D, 0, GL_R8, atlas_size.x, atlas_size.y, 0, GL_RED, GL_UNSIGNED_BYTE, atlas.Texels.data());
+        GL::PixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        GL::BindTexture(GL_TEXTURE_2D, 0);
+
+        shader = OpenGL::CreateShader(std::filesystem::path{ "Assets/shaders/Text/sdf_text.vert" }, std::filesystem::path{ "Assets/shaders/Text/sdf_text.frag" });
+        OpenGL::SetUniformBlockBinding(shader.Shader, "Camera", 0);
+
+        GL::GenVertexArrays(1, &vao);
+        GL::BindVertexArray(vao);
+        GL::GenBuffers(1, &vbo);
+        GL::BindBuffer(GL_ARRAY_BUFFER, vbo);
+        GL::EnableVertexAttribArray(0);
+        GL::VertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, FloatsPerVertex * sizeof(float), reinterpret_cast<void*>(0));
+        GL::EnableVertexAttribArray(1);
+        GL::VertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, FloatsPerVertex * sizeof(float), reinterpret_cast<void*>(2 * sizeof(float)));
+        GL::BindVertexArray(0);
+    }
+
+    SdfFont::~SdfFont()
+    {
+        OpenGL::DestroyShader(shader);
+        GL::DeleteBuffers(1, &vbo);
+        GL::DeleteVertexArrays(1, &vao);
+        GL::DeleteTextures(1, &atlas_texture);
+    }
+
+    void SdfFont::DrawText(const Math::TransformationMatrix& display_matrix, std::string_view text, CS200::RGBA fill_color, CS200::RGBA outline_color, double outline_width) const
+    {
+        vertices.clear();
+        vertices.reserve(text.size() * FloatsPerGlyph);
+
+        const double pad = static_cast<double>(spread);
+        const auto   w   = static_cast<double>(atlas_size.x);
+        const auto   h   = static_cast<double>(atlas_size.y);
+        double       pen = 0.0;
+        for (char c : text)
+        {
+            if (c < ' ' || c > 'z')
+                continue;
+
+            const auto& glyph = glyphs[static_cast<std::size_t>(c - ' ')];
+            const auto  size  = glyph.Size();
+
+            // the quad covers the padding too, so outlines are not cut off at the glyph box
+            const float x0 = static_cast<float>(pen - pad);
+            const float x1 = static_cast<float>(pen + size.x + pad);
+            const float y0 = static_cast<float>(-pad);
+            const float y1 = static_cast<float>(size.y + pad);
+            const float u0 = static_cast<float>((glyph.Left() - pad) / w);
+            const float u1 = static_cast<float>((glyph.Right() + pad) / w);
+            // atlas rows are stored top down, so the top of the glyph has the smaller v
+            const float v_top    = static_cast<float>((glyph.Bottom() - pad) / h);
+            const float v_bottom = static_cast<float>((glyph.Top() + pad) / h);
+
+            const float quad[FloatsPerGlyph] = {
+                x0, y0, u0, v_bottom, x1, y0, u1, v_bottom, x1, y1, u1, v_top,
+                x1, y1, u1, v_top,    x0, y1, u0, v_top,    x0, y0, u0, v_bottom,
+            };
+            vertices.insert(vertices.end(), std::begin(quad), std::end(quad));
+
+            pen += advances[static_cast<std::size_t>(c - ' ')].x + 1;
+        }
+        if (vertices.empty())
+            return;
+
+        GL::UseProgram(shader.Shader);
+
+        const float model[9] = {
+            static_cast<float>(display_matrix[0][0]), static_cast<float>(display_matrix[1][0]), static_cast<float>(display_matrix[2][0]),
+            static_cast<float>(display_matrix[0][1]), static_cast<float>(display_matrix[1][1]), static_cast<float>(display_matrix[2][1]),
+            static_cast<float>(display_matrix[0][2]), static_cast<float>(display_matrix[1][2]), static_cast<float>(display_matrix[2][2]),
+        };
+        if (shader.UniformLocations.contains("uModel"))
+            GL::UniformMatrix3fv(shader.UniformLocations.at("uModel"), 1, GL_FALSE, model);
+        if (shader.UniformLocations.contains("uFillColor"))
+        {
+            const auto c = to_floats(fill_color);
+            GL::Uniform4f(shader.UniformLocations.at("uFillColor"), c[0], c[1], c[2], c[3]);
+        }
+        if (shader.UniformLocations.contains("uOutlineColor"))
+        {
+            const auto c = to_floats(outline_color);
+            GL::Uniform4f(shader.UniformLocations.at("uOutlineColor"), c[0], c[1], c[2], c[3]);
+        }
+        if (shader.UniformLocations.contains("uOutlineWidth"))
+        {
+            // the field maps spread texels to 0.5, convert the outline to the same units
+            const double width = std::clamp(outline_width, 0.0, pad) / (2.0 * pad);
+            GL::Uniform1f(shader.UniformLocations.at("uOutlineWidth"), static_cast<float>(width));
+        }
+        if (shader.UniformLocations.contains("uAtlas"))
+            GL::Uniform1i(shader.UniformLocations.at("uAtlas"), 0);
+
+        GL::ActiveTexture(GL_TEXTURE0);
+        GL::BindTexture(GL_TEXTURE_2D, atlas_texture);
+
+        GL::BindVertexArray(vao);
+        GL::BindBuffer(GL_ARRAY_BUFFER, vbo);
+        GL::BufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertices.size() * sizeof(float)), vertices.data(), GL_STREAM_DRAW);
+        GL::DrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size() / FloatsPerVertex));
+        GL::BindVertexArray(0);
+    }
+
+    Math::ivec2 SdfFont::MeasureText(std::string_view text) const
+    {
+        Math::ivec2 size{ 0, 0 };
+        for (char c : text)
+        {
+            if (c < ' ' || c > 'z')
+                continue;
+
+            const auto& advance = advances[static_cast<std::size_t>(c - ' ')];
+            size.x += advance.x + 1;
+            size.y = std::max(size.y, advance.y + 1);
+        }
+        return size;
+    }
+}
@@ -0,0 +1,98 @@
+/**
+ * \file
+ * \author Junseok lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+#pragma once
+#include "CS200/RGBA.hpp"
+#include "CS200/SdfFontAtlas.hpp"
+#include "Matrix.hpp"
+#include "OpenGL/Handle.hpp"
+#include "OpenGL/Shader.hpp"
+#include "OpenGL/Texture.hpp"
+#include "Rect.hpp"
+#include "Vec2.hpp"
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace CS230
+{
+    /**
+     * \brief Scale independent text drawn from a signed distance field atlas
+     *
+     * Built from the same bitmap fonts as CS230::Font. On first use the glyphs
+     * are converted into a single channel distance field (see
+     * CS200::GenerateSdfFontAtlas) and saved as a ".sdffont" file in the user
+     * cache folder. The cs200_sdf_font tool and cs200_cook produce the same
+     * file offline, next to the png, where it is looked for first.
+     *
+     * The text shader thresholds the distance instead of the coverage, so
+     * edges stay sharp when the text is scaled up, and an outline of any width
+     * comes from the same atlas. One R8 atlas therefore replaces both the
+     * Font_Simple and Font_Outlined RGBA textures.
+     *
+     * All glyphs of a DrawText() call go out in one draw. Layout and advance
+     * match CS230::Font, so the two can be swapped without moving text around.
+     */
+    class SdfFont
+    {
+    public:
+        static constexpr int DefaultSpread = CS200::DefaultSdfSpread;
+
+        /**
+         * \brief Load or generate the distance field atlas for a bitmap font
+         * \param bitmap_font_path Path to a CS230 bitmap font png, like "Assets/fonts/Font_Simple.png"
+         * \param spread Distance in texels covered by the field, bounds the widest outline
+         */
+        explicit SdfFont(const std::filesystem::path& bitmap_font_path, int spread = DefaultSpread);
+        ~SdfFont();
+
+        SdfFont(const SdfFont&)            = delete;
+        SdfFont& operator=(const SdfFont&) = delete;
+
+        /**
+         * \brief Draw text with an optional outline
+         * \param display_matrix Transform of the bottom left corner of the text
+         * \param text Characters outside ' ' to 'z' are skipped
+         * \param fill_color Color inside the glyphs
+         * \param outline_color Color of the outline
+         * \param outline_width Outline thickness in source texels, clamped to the spread
+         *
+         * Must be called between IRenderer2D::BeginScene() and EndScene(); the
+         * view projection comes from the renderer's Camera uniform block.
+         */
+        void DrawText(const Math::TransformationMatrix& display_matrix, std::string_view text, CS200::RGBA fill_color = CS200::WHITE, CS200::RGBA outline_color = CS200::BLACK, double outline_width = 0.0) const;
+
+        [[nodiscard]] Math::ivec2 MeasureText(std::string_view text) const;
+
+        [[nodiscard]] Math::ivec2 GetAtlasSize() const noexcept
+        {
+            return atlas_size;
+        }
+
+        [[nodiscard]] std::size_t GetAtlasBytes() const noexcept
+        {
+            return static_cast<std::size_t>(atlas_size.x) * static_cast<std::size_t>(atlas_size.y);
+        }
+
+    private:
+        static constexpr int num_chars = CS200::FontGlyphCount;
+
+        std::vector<Math::irect> glyphs;
+        std::vector<Math::ivec2> advances;
+        Math::ivec2              atlas_size{ 0, 0 };
+        int                      spread = 0;
+
+        OpenGL::TextureHandle  atlas_texture = 0;
+        OpenGL::CompiledShader shader{};
+        OpenGL::Handle         vao = 0;
+        OpenGL::Handle         vbo = 0;
+
+        mutable std::vector<float> vertices;
+    };
+}
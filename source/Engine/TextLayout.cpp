@@ -0,0 +1,212 @@
+/**
+ * \file
+ * \author Junseok lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+#include "TextLayout.hpp"
+
+#include "OpenGL/GL.hpp"
+#include "OpenGL/UniformBlock.hpp"
+#include "Texture.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace CS230
+{
+    namespace
+    {
+        constexpr std::size_t FloatsPerVertex = 4;
+        constexpr std::size_t FloatsPerQuad   = 4 * FloatsPerVertex;
+        constexpr std::size_t BytesPerQuad    = FloatsPerQuad * sizeof(float);
+
+        bool is_drawable(char c) noexcept
+        {
+            return c >= ' ' && c <= 'z';
+        }
+
+        // one program shared by every layout, destroyed with the last of them
+        std::shared_ptr<OpenGL::CompiledShader> acquire_shader()
+        {
+            static std::weak_ptr<OpenGL::CompiledShader> shared;
+            if (auto existing = shared.lock())
+            {
+                return existing;
+            }
+
+            auto created = std::shared_ptr<OpenGL::CompiledShader>(
+                new OpenGL::CompiledShader(OpenGL::CreateShader(std::filesystem::path{ "Assets/shaders/Text/glyph_batch.vert" }, std::filesystem::path{ "Assets/shaders/Text/glyph_batch.frag" })),
+                [](OpenGL::CompiledShader* shader)
+                {
+                    OpenGL::DestroyShader(*shader);
+                    delete shader;
+                });
+            OpenGL::SetUniformBlockBinding(created->Shader, "Camera", 0);
+            shared = created;
+            return created;
+        }
+    }
+
+    TextLayout::TextLayout(const Font& the_font, std::size_t initial_capacity) : font(&the_font), shader(acquire_shader())
+    {
+        GL::GenVertexArrays(1, &vao);
+        GL::GenBuffers(1, &vbo);
+        GL::GenBuffers(1, &ebo);
+        grow(std::max<std::size_t>(initial_capacity, 1));
+    }
+
+    TextLayout::~TextLayout()
+    {
+        GL::DeleteBuffers(1, &ebo);
+        GL::DeleteBuffers(1, &vbo);
+        GL::DeleteVertexArrays(1, &vao);
+    }
+
+    void TextLayout::SetText(std::string_view new_text)
+    {
+        if (new_text == text)
+        {
+            return;
+        }
+        last_update = { 0, 0, new_text.size() };
+
+        bool full_upload = false;
+        if (new_text.size() > capacity)
+        {
+            grow(std::max(new_text.size(), capacity * 2));
+            full_upload = true;
+        }
+
+        // the shared prefix keeps its quads, start laying out where the strings first differ
+        const auto        mismatch = std::mismatch(text.begin(), text.end(), new_text.begin(), new_text.end());
+        const std::size_t first    = full_upload ? 0 : static_cast<std::size_t>(mismatch.first - text.begin());
+        int               pen      = full_upload ? 0 : (first < slots.size() ? slots[first].PenX : size.x);
+
+        std::size_t dirty_first = std::numeric_limits<std::size_t>::max();
+        std::size_t dirty_last  = 0;
+        slots.resize(new_text.size());
+        for (std::size_t i = first; i < new_text.size(); ++i)
+        {
+            const Slot slot{ new_text[i], pen };
+            if (full_upload || i >= text.size() || slots[i].Character != slot.Character || slots[i].PenX != slot.PenX)
+            {
+                write_slot(i, slot);
+                dirty_first = std::min(dirty_first, i);
+                dirty_last  = i;
+                ++last_update.GlyphsWritten;
+            }
+            if (is_drawable(slot.Character))
+            {
+                pen += font->GetCharRect(slot.Character).Size().x + 1;
+            }
+        }
+
+        text   = new_text;
+        size.x = pen;
+        size.y = 0;
+        for (const char c : text)
+        {
+            if (is_drawable(c))
+            {
+                size.y = font->GetCharRect(c).Size().y + 1;
+                break; // every glyph of a CS230 bitmap font has the same height
+            }
+        }
+
+        if (dirty_first <= dirty_last && dirty_last < slots.size())
+        {
+            const std::size_t count = dirty_last - dirty_first + 1;
+            last_update.BytesUploaded = count * BytesPerQuad;
+            GL::BindBuffer(GL_ARRAY_BUFFER, vbo);
+            GL::BufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(dirty_first * BytesPerQuad), static_cast<GLsizeiptr>(last_update.BytesUploaded), vertices.data() + dirty_first * FloatsPerQuad);
+            GL::BindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+    }
+
+    void TextLayout::Draw(const Math::TransformationMatrix& display_matrix, CS200::RGBA color) const
+    {
+        if (slots.empty())
+        {
+            return;
+        }
+
+        GL::UseProgram(shader->Shader);
+        const float model[9] = {
+            static_cast<float>(display_matrix[0][0]), static_cast<float>(display_matrix[1][0]), static_cast<float>(display_matrix[2][0]),
+            static_cast<float>(display_matrix[0][1]), static_cast<float>(display_matrix[1][1]), static_cast<float>(display_matrix[2][1]),
+            static_cast<float>(display_matrix[0][2]), static_cast<float>(display_matrix[1][2]), static_cast<float>(display_matrix[2][2]),
+        };
+        if (shader->UniformLocations.contains("uModel"))
+            GL::UniformMatrix3fv(shader->UniformLocations.at("uModel"), 1, GL_FALSE, model);
+        if (shader->UniformLocations.contains("uTintColor"))
+        {
+            const auto c = CS200::unpack_color(color);
+            GL::Uniform4f(shader->UniformLocations.at("uTintColor"), c[0], c[1], c[2], c[3]);
+        }
+        if (shader->UniformLocations.contains("uTex2d"))
+            GL::Uniform1i(shader->UniformLocations.at("uTex2d"), 0);
+
+        GL::ActiveTexture(GL_TEXTURE0);
+        GL::BindTexture(GL_TEXTURE_2D, font->GetTexture()->GetHandle());
+        GL::BindVertexArray(vao);
+        GL::DrawElements(GL_TRIANGLES, static_cast<GLsizei>(slots.size() * 6), GL_UNSIGNED_INT, nullptr);
+        GL::BindVertexArray(0);
+    }
+
+    void TextLayout::grow(std::size_t glyph_count)
+    {
+        capacity = glyph_count;
+        vertices.assign(capacity * FloatsPerQuad, 0.0f);
+
+        std::vector<GLuint> indices(capacity * 6);
+        for (std::size_t q = 0; q < capacity; ++q)
+        {
+            const auto   base   = static_cast<GLuint>(q * 4);
+            const GLuint quad[] = { base, base + 1, base + 2, base + 2, base + 3, base };
+            std::copy(std::begin(quad), std::end(quad), indices.begin() + static_cast<std::ptrdiff_t>(q * 6));
+        }
+
+        GL::BindVertexArray(vao);
+        GL::BindBuffer(GL_ARRAY_BUFFER, vbo);
+        GL::BufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(capacity * BytesPerQuad), nullptr, GL_DYNAMIC_DRAW);
+        GL::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+        GL::BufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(GLuint)), indices.data(), GL_STATIC_DRAW);
+        GL::EnableVertexAttribArray(0);
+        GL::VertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, FloatsPerVertex * sizeof(float), reinterpret_cast<void*>(0));
+        GL::EnableVertexAttribArray(1);
+        GL::VertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, FloatsPerVertex * sizeof(float), reinterpret_cast<void*>(2 * sizeof(float)));
+        GL::BindVertexArray(0);
+        GL::BindBuffer(GL_ARRAY_BUFFER, 0);
+
+        // the old contents are gone with the reallocation, every slot gets rewritten
+        slots.clear();
+    }
+
+    void TextLayout::write_slot(std::size_t index, Slot slot)
+    {
+        slots[index] = slot;
+        float* quad  = vertices.data() + index * FloatsPerQuad;
+        if (!is_drawable(slot.Character))
+        {
+            std::fill(quad, quad + FloatsPerQuad, 0.0f);
+            return;
+        }
+
+        // same texel to uv mapping as Texture::Draw(), the font texture is stored bottom up
+        const auto& rect  = font->GetCharRect(slot.Character);
+        const auto  frame = rect.Size();
+        const auto  tex   = font->GetTexture()->GetSize();
+        const float x0    = static_cast<float>(slot.PenX);
+        const float x1    = static_cast<float>(slot.PenX + frame.x);
+        const float y1    = static_cast<float>(frame.y);
+        const float u0    = static_cast<float>(rect.Left()) / static_cast<float>(tex.x);
+        const float u1    = static_cast<float>(rect.Left() + frame.x) / static_cast<float>(tex.x);
+        const float v0    = static_cast<float>(tex.y - rect.Bottom() - frame.y) / static_cast<float>(tex.y);
+        const float v1    = static_cast<float>(tex.y - rect.Bottom()) / static_cast<float>(tex.y);
+
+        const float corners[FloatsPerQuad] = { x0, 0.0f, u0, v0, x1, 0.0f, u1, v0, x1, y1, u1, v1, x0, y1, u0, v1 };
+        std::copy(std::begin(corners), std::end(corners), quad);
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ * \file
+ * \author Junseok lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+#pragma once
+#include "CS200/RGBA.hpp"
+#include "Font.hpp"
+#include "Matrix.hpp"
+#include "OpenGL/Handle.hpp"
+#include "OpenGL/Shader.hpp"
+#include "Vec2.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CS230
+{
+    /**
+     * \brief A line of bitmap font text kept in a persistent vertex buffer and patched in place
+     *
+     * Meant for text that changes often but mostly keeps its characters:
+     * timers, counters, coordinates. Every character owns one quad slot in
+     * the buffer. SetText() skips the prefix shared with the previous string,
+     * lays out only the rest, and rewrites only the slots whose character or
+     * position actually changed, uploading that one dirty range with
+     * glBufferSubData. "Frequent: 41" to "Frequent: 42" touches one quad.
+     *
+     * The quads use Font::GetCharRect() and sample the font texture directly,
+     * so the result looks exactly like Font::DrawText() and PrintToTexture(),
+     * and the whole line is one draw call.
+     *
+     * Needs a current OpenGL context. The Font must outlive the layout.
+     */
+    class TextLayout
+    {
+    public:
+        /**
+         * \brief What the last SetText() that changed the text had to do, for profiling overlays
+         */
+        struct UpdateStats
+        {
+            std::size_t GlyphsWritten = 0;
+            std::size_t BytesUploaded = 0;
+            std::size_t TotalGlyphs   = 0;
+        };
+
+        explicit TextLayout(const Font& font, std::size_t initial_capacity = 32);
+        ~TextLayout();
+
+        TextLayout(const TextLayout&)            = delete;
+        TextLayout& operator=(const TextLayout&) = delete;
+
+        /**
+         * \brief Replace the text, re-laying out and uploading only what changed
+         * \param new_text Characters outside ' ' to 'z' keep their slot but draw nothing
+         */
+        void SetText(std::string_view new_text);
+
+        /**
+         * \brief Draw the whole line in one call
+         * \param display_matrix Transform of the bottom left corner of the text
+         * \param color Tint applied to the font texture
+         *
+         * Must be called between IRenderer2D::BeginScene() and EndScene().
+         */
+        void Draw(const Math::TransformationMatrix& display_matrix, CS200::RGBA color = CS200::WHITE) const;
+
+        [[nodiscard]] const std::string& GetText() const noexcept
+        {
+            return text;
+        }
+
+        [[nodiscard]] Math::ivec2 GetSize() const noexcept
+        {
+            return size;
+        }
+
+        [[nodiscard]] const UpdateStats& GetLastUpdate() const noexcept
+        {
+            return last_update;
+        }
+
+    private:
+        struct Slot
+        {
+            char Character = 0;
+            int  PenX      = 0;
+        };
+
+        void grow(std::size_t glyph_count);
+        void write_slot(std::size_t index, Slot slot);
+
+        const Font*                             font;
+        std::shared_ptr<OpenGL::CompiledShader> shader;
+
+        std::string        text;
+        std::vector<Slot>  slots;
+        std::vector<float> vertices; // CPU copy of the buffer, capacity quads
+        std::size_t        capacity = 0;
+        Math::ivec2        size{ 0, 0 };
+        UpdateStats        last_update{};
+
+        OpenGL::Handle vao = 0;
+        OpenGL::Handle vbo = 0;
+        OpenGL::Handle ebo = 0;
+    };
+}
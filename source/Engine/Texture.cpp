@@ -17,6 +17,13 @@
 
 namespace CS230
 {
+    namespace
+    {
+        std::size_t rgba8_bytes(Math::ivec2 size) noexcept
+        {
+            return static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) * 4;
+        }
+    }
 
     void CS230::Texture::Draw(const Math::TransformationMatrix& display_matrix, unsigned int color)
     {
@@ -30,7 +37,9 @@ namespace CS230
         // transform: out quad vertices have the center at 0 and extents 0.5 to either side. to make this fit with the texture coordinate system,
         // we need to pass a transformation matrix that shifts and scales it so that they perfectly overlap eachother.
 
-        renderer2D.DrawQuad(transform, textureHandle, { 0.0, 0.0 }, { 1.0,  1.0 }, color);
+        Math::vec2 Bottom_Left, Top_Right;
+        GetUVRect({ 0, 0 }, size, Bottom_Left, Top_Right);
+        renderer2D.DrawQuad(transform, textureHandle, Bottom_Left, Top_Right, color);
 
         
     }
@@ -45,8 +54,8 @@ namespace CS230
 
         auto transform = display_matrix * scale * shift;
 
-        Math::vec2 Bottom_Left  = { static_cast<double>(texel_position.x) / static_cast<double>(size.x), static_cast<double>(size.y - texel_position.y - frame_size.y) / static_cast<double>(size.y) };// given texel position should 
-        Math::vec2 Top_Right    = { static_cast<double>(texel_position.x + frame_size.x) / static_cast<double>(size.x), static_cast<double>(size.y - texel_position.y) / static_cast<double>(size.y) };
+        Math::vec2 Bottom_Left, Top_Right;
+        GetUVRect(texel_position, frame_size, Bottom_Left, Top_Right);
         renderer2D.DrawQuad(transform, textureHandle, Bottom_Left, Top_Right , color);
         //
 
@@ -58,9 +67,35 @@ namespace CS230
         return size;
     }
 
+    void Texture::GetUVRect(Math::ivec2 texel_position, Math::ivec2 frame_size, Math::vec2& bottom_left, Math::vec2& top_right) const noexcept
+    {
+        // texel_position counts rows from the top of the image, the GL texture from the bottom;
+        // inside an atlas the image starts at atlasOffset of a larger page
+        const double page_w = static_cast<double>(pageSize.x);
+        const double page_h = static_cast<double>(pageSize.y);
+        bottom_left = { static_cast<double>(atlasOffset.x + texel_position.x) / page_w, static_cast<double>(atlasOffset.y + size.y - texel_position.y - frame_size.y) / page_h };
+        top_right   = { static_cast<double>(atlasOffset.x + texel_position.x + frame_size.x) / page_w, static_cast<double>(atlasOffset.y + size.y - texel_position.y) / page_h };
+    }
+
+    void Texture::SetFiltering(OpenGL::Filtering new_filtering)
+    {
+        filtering = new_filtering;
+        if (textureHandle == 0 || atlasPage != nullptr || placeholder)
+        {
+            return;
+        }
+        if (OpenGL::UsesMipmaps(filtering) && mipLevels == 1 && !compressed)
+        {
+            OpenGL::GenerateMipmaps(textureHandle);
+            mipLevels = OpenGL::MipLevelCount(pageSize);
+            gpuBytes += gpuBytes / 3; // 1/4 + 1/16 + ... of level 0
+        }
+        OpenGL::SetFiltering(textureHandle, filtering);
+    }
+
     Texture::~Texture()
     {
-         if (textureHandle != 0)
+         if (textureHandle != 0 && atlasPage == nullptr)
         {
             GL::DeleteTextures(1, &textureHandle);
         }
@@ -72,12 +107,34 @@ namespace CS230
         CS200::Image   image(file_name, flip_image);
 
         size = image.GetSize();
+        pageSize = size;
+        gpuBytes = rgba8_bytes(size);
 
         textureHandle = OpenGL::CreateTextureFromImage(image);
     }
 
 
-     Texture::Texture(OpenGL::TextureHandle given_texture, Math::ivec2 the_size) : textureHandle(given_texture), size(the_size)
+     Texture::Texture(OpenGL::TextureHandle given_texture, Math::ivec2 the_size) : Texture(given_texture, the_size, rgba8_bytes(the_size))
+    {
+    }
+
+    Texture::Texture(OpenGL::TextureHandle given_texture, Math::ivec2 the_size, std::size_t gpu_bytes)
+        : textureHandle(given_texture), size(the_size), pageSize(the_size), gpuBytes(gpu_bytes)
+    {
+    }
+
+    Texture::Texture(OpenGL::TextureHandle given_texture, const CS200::Ktx2Texture& source)
+        : textureHandle(given_texture), size(source.Size), pageSize(source.Size), gpuBytes(source.Data.size()), mipLevels(1 + static_cast<int>(source.MipLevels.size())), compressed(true)
+    {
+        for (const auto& level : source.MipLevels)
+        {
+            gpuBytes += level.size();
+        }
+    }
+
+    Texture::Texture(TextureAtlas::Placement placement, Math::ivec2 the_size)
+        : textureHandle(placement.OnPage->Handle), size(the_size), atlasPage(std::move(placement.OnPage)), atlasOffset(placement.Offset), pageSize(atlasPage->Packer.GetSize()),
+          gpuBytes(rgba8_bytes(the_size))
     {
     }
 
@@ -86,15 +143,34 @@ namespace CS230
         // return value optimization and shi....
         textureHandle = temporary.textureHandle;
         size = temporary.size;
+        atlasPage     = std::move(temporary.atlasPage);
+        atlasOffset   = temporary.atlasOffset;
+        pageSize      = temporary.pageSize;
+        gpuBytes      = temporary.gpuBytes;
+        filtering     = temporary.filtering;
+        mipLevels     = temporary.mipLevels;
+        compressed    = temporary.compressed;
+        placeholder   = temporary.placeholder;
+        format        = temporary.format;
 
         temporary.textureHandle = 0;
         temporary.size          = { 0, 0 };
+        temporary.pageSize      = { 0, 0 };
     }
 
     Texture& Texture::operator=(Texture&& temporary) noexcept
     {
         std::swap(textureHandle, temporary.textureHandle);
         std::swap(size, temporary.size);
+        std::swap(atlasPage, temporary.atlasPage);
+        std::swap(atlasOffset, temporary.atlasOffset);
+        std::swap(pageSize, temporary.pageSize);
+        std::swap(gpuBytes, temporary.gpuBytes);
+        std::swap(filtering, temporary.filtering);
+        std::swap(mipLevels, temporary.mipLevels);
+        std::swap(compressed, temporary.compressed);
+        std::swap(placeholder, temporary.placeholder);
+        std::swap(format, temporary.format);
         return *this;
     }
 }
\ No newline at end of file
@@ -9,10 +9,14 @@
  */
 
 #pragma once
+#include "CS200/Ktx2.hpp"
 #include "Matrix.hpp"
 #include "OpenGL/Texture.hpp"
+#include "TextureAtlas.hpp"
 #include "Vec2.hpp"
+#include <cstddef>
 #include <filesystem>
+#include <memory>
 
 namespace CS230
 {
@@ -182,6 +186,79 @@ namespace CS230
             return textureHandle;
         }
 
+        /**
+         * \brief Whether this texture is a sub-rectangle of a shared atlas page
+         *
+         * For atlas textures GetHandle() returns the page, which holds other
+         * images too. Draw() maps its texel coordinates into the page by itself;
+         * code sampling the handle directly has to use GetUVRect() as well.
+         */
+        [[nodiscard]] bool IsInAtlas() const noexcept
+        {
+            return atlasPage != nullptr;
+        }
+
+        /**
+         * \brief Texture coordinates of a texel rectangle, in the texture the handle refers to
+         * \param texel_position Top-left corner in pixel coordinates within this texture's image
+         * \param frame_size Size of the region in pixels
+         * \param bottom_left Output, uv of the bottom left corner
+         * \param top_right Output, uv of the top right corner
+         */
+        void GetUVRect(Math::ivec2 texel_position, Math::ivec2 frame_size, Math::vec2& bottom_left, Math::vec2& top_right) const noexcept;
+
+        /**
+         * \brief Video memory taken by this texture's texels
+         *
+         * width * height * 4 for RGBA8 textures, including atlas sub-rectangles,
+         * or the size of the compressed blocks for textures loaded from KTX2.
+         * A mip chain adds about a third on top.
+         */
+        [[nodiscard]] std::size_t GetMemoryBytes() const noexcept
+        {
+            return gpuBytes;
+        }
+
+        /**
+         * \brief How the texels are stored, RGBA8 unless loaded by TextureManager::LoadMask()
+         */
+        [[nodiscard]] OpenGL::TextureFormat GetFormat() const noexcept
+        {
+            return format;
+        }
+
+        /**
+         * \brief Change how this texture is sampled, the per-texture opt-in for mipmaps
+         * \param filtering New filtering mode
+         *
+         * Textures are created with NearestPixel. Sprites and backgrounds that
+         * are drawn smaller than their native size, under a zoomed out camera
+         * or a scale below 1, should use Trilinear: the first mipmapped mode
+         * builds the mip chain of an RGBA8 texture on the GPU, after which
+         * minified draws read from a level close to the size on screen.
+         *
+         * Compressed textures use the levels cooked into their KTX2 file, see
+         * cs200_compress_textures --mips, and sample level 0 only without
+         * them. Atlas textures share their page with other images and keep
+         * its filtering; the request is only remembered. A texture still
+         * loading through TextureManager::LoadAsync() applies the mode once
+         * its pixels arrive.
+         */
+        void SetFiltering(OpenGL::Filtering filtering);
+
+        [[nodiscard]] OpenGL::Filtering GetFiltering() const noexcept
+        {
+            return filtering;
+        }
+
+        /**
+         * \brief Levels in the texture's mip chain, 1 without mipmaps
+         */
+        [[nodiscard]] int GetMipLevelCount() const noexcept
+        {
+            return mipLevels;
+        }
+
     private:
         // Private constructors - textures can only be created through TextureManager or Font
         // This ensures proper resource management and prevents accidental texture duplication
@@ -190,6 +267,15 @@ namespace CS230
         
         Texture(OpenGL::TextureHandle given_texture, Math::ivec2 the_size);
 
+        // compressed or other non RGBA8 storage, gpu_bytes is what the texels take in video memory
+        Texture(OpenGL::TextureHandle given_texture, Math::ivec2 the_size, std::size_t gpu_bytes);
+
+        // made by OpenGL::CreateCompressedTexture() from a KTX2 file, with its cooked mip levels if any
+        Texture(OpenGL::TextureHandle given_texture, const CS200::Ktx2Texture& compressed);
+
+        // a sub-rectangle of an atlas page, the page keeps ownership of the GL texture
+        explicit Texture(TextureAtlas::Placement placement, Math::ivec2 the_size);
+
     public:
         /**
          * \brief Deleted copy constructor and assignment operator
@@ -237,5 +323,14 @@ namespace CS230
     private:
     OpenGL::TextureHandle textureHandle;
     Math::ivec2 size;
+    std::shared_ptr<TextureAtlas::Page> atlasPage;        // null when the texture owns textureHandle
+    Math::ivec2                         atlasOffset{ 0, 0 };
+    Math::ivec2                         pageSize{ 0, 0 };  // size of the GL texture, equal to size outside an atlas
+    std::size_t                         gpuBytes = 0;
+    OpenGL::Filtering                   filtering   = OpenGL::Filtering::NearestPixel;
+    int                                 mipLevels   = 1;
+    bool                                compressed  = false; // glGenerateMipmap cannot write compressed formats
+    bool                                placeholder = false; // LoadAsync() stand-in, its GL texture is 2x2 whatever size says
+    OpenGL::TextureFormat               format      = OpenGL::TextureFormat::RGBA8; // of uncompressed textures
     };
 }
@@ -0,0 +1,91 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "TextureAtlas.hpp"
+
+#include "Engine.hpp"
+#include "Logger.hpp"
+#include "OpenGL/GL.hpp"
+#include <algorithm>
+
+namespace CS230
+{
+    TextureAtlas::Page::Page(Math::ivec2 page_size) : Packer(page_size)
+    {
+        // start fully transparent, padding texels are sampled by linear filtering
+        const std::vector<CS200::RGBA> clear(static_cast<std::size_t>(page_size.x) * static_cast<std::size_t>(page_size.y), 0u);
+        Handle = OpenGL::CreateTextureFromMemory(page_size, clear);
+    }
+
+    TextureAtlas::Page::~Page()
+    {
+        if (Handle != 0)
+        {
+            GL::DeleteTextures(1, &Handle);
+        }
+    }
+
+    TextureAtlas::TextureAtlas(Settings atlas_settings) : settings(atlas_settings)
+    {
+    }
+
+    std::optional<TextureAtlas::Placement> TextureAtlas::Add(const CS200::Image& image)
+    {
+        const auto size = image.GetSize();
+        if (size.x > settings.MaxImageSize || size.y > settings.MaxImageSize)
+        {
+            return std::nullopt;
+        }
+
+        const int         border = settings.Extrude;
+        const Math::ivec2 block{ size.x + 2 * border, size.y + 2 * border };
+        const Math::ivec2 reserved{ block.x + settings.Padding, block.y + settings.Padding };
+
+        std::shared_ptr<Page>      page;
+        std::optional<Math::ivec2> corner;
+        for (const auto& candidate : pages)
+        {
+            if ((corner = candidate->Packer.Insert(reserved)))
+            {
+                page = candidate;
+                break;
+            }
+        }
+        if (!page)
+        {
+            page   = std::make_shared<Page>(Math::ivec2{ settings.PageSize, settings.PageSize });
+            corner = page->Packer.Insert(reserved);
+            if (!corner)
+            {
+                return std::nullopt; // MaxImageSize is larger than a page
+            }
+            pages.push_back(page);
+            Engine::GetLogger().LogDebug("Created texture atlas page " + std::to_string(pages.size()));
+        }
+
+        // the block is the image with its border texels repeated outward
+        std::vector<CS200::RGBA> texels(static_cast<std::size_t>(block.x) * static_cast<std::size_t>(block.y));
+        const CS200::RGBA*       source = image.data();
+        for (int y = 0; y < block.y; ++y)
+        {
+            const int source_y = std::clamp(y - border, 0, size.y - 1);
+            for (int x = 0; x < block.x; ++x)
+            {
+                const int source_x = std::clamp(x - border, 0, size.x - 1);
+                texels[static_cast<std::size_t>(y) * static_cast<std::size_t>(block.x) + static_cast<std::size_t>(x)] =
+                    source[static_cast<std::size_t>(source_y) * static_cast<std::size_t>(size.x) + static_cast<std::size_t>(source_x)];
+            }
+        }
+
+        GL::BindTexture(GL_TEXTURE_2D, page->Handle);
+        GL::TexSubImage2D(GL_TEXTURE_2D, 0, corner->x, corner->y, block.x, block.y, GL_RGBA, GL_UNSIGNED_BYTE, texels.data());
+        GL::BindTexture(GL_TEXTURE_2D, 0);
+
+        ++page->ImageCount;
+        return Placement{ page, Math::ivec2{ corner->x + border, corner->y + border } };
+    }
+}
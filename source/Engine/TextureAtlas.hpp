@@ -0,0 +1,86 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+#include "CS200/Image.hpp"
+#include "CS200/SkylinePacker.hpp"
+#include "OpenGL/Texture.hpp"
+#include "Vec2.hpp"
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace CS230
+{
+    struct TextureAtlasSettings
+    {
+        int PageSize     = 2048;
+        int MaxImageSize = 1024; ///< Larger images keep a texture of their own
+        int Padding      = 1;
+        int Extrude      = 1;
+    };
+
+    /**
+     * \brief Shared GPU pages that small images are packed into
+     *
+     * Every image added gets a sub-rectangle of a page found by a
+     * CS200::SkylinePacker. Around each image the packer reserves Extrude
+     * texels, filled with copies of the image's border texels, plus Padding
+     * texels left empty. With linear filtering or scaling, samples near the
+     * edge of a sprite then read its own border instead of the neighbour.
+     *
+     * When a page is full a new one is created. Pages are reference counted
+     * and stay alive while any Texture placed on them does.
+     */
+    class TextureAtlas
+    {
+    public:
+        using Settings = TextureAtlasSettings;
+
+        struct Page
+        {
+            OpenGL::TextureHandle Handle = 0;
+            CS200::SkylinePacker  Packer;
+            int                   ImageCount = 0;
+
+            explicit Page(Math::ivec2 page_size);
+            ~Page();
+
+            Page(const Page&)            = delete;
+            Page& operator=(const Page&) = delete;
+        };
+
+        struct Placement
+        {
+            std::shared_ptr<Page> OnPage;
+            Math::ivec2           Offset{ 0, 0 }; ///< Bottom left texel of the image inside the page
+        };
+
+        explicit TextureAtlas(Settings atlas_settings = {});
+
+        /**
+         * \brief Copy an image into a page
+         * \param image Image loaded with flip_vertical, so its first row is the bottom one
+         * \return Where the image went, or nothing if it is larger than Settings::MaxImageSize
+         */
+        std::optional<Placement> Add(const CS200::Image& image);
+
+        [[nodiscard]] const Settings& GetSettings() const noexcept
+        {
+            return settings;
+        }
+
+        [[nodiscard]] const std::vector<std::shared_ptr<Page>>& GetPages() const noexcept
+        {
+            return pages;
+        }
+
+    private:
+        Settings                           settings;
+        std::vector<std::shared_ptr<Page>> pages;
+    };
+}
@@ -9,47 +9,646 @@
  */
 
 #include "TextureManager.hpp"
+#include "CS200/CookedTexture.hpp"
 #include "CS200/IRenderer2D.hpp"
 #include "CS200/NDC.hpp"
 #include "Engine.hpp"
 #include "Logger.hpp"
 #include "OpenGL/GL.hpp"
+#include "Path.hpp"
 #include "Texture.hpp"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <span>
 
 namespace CS230
 {
+    namespace
+    {
+        OpenGL::TextureHandle create_placeholder()
+        {
+            constexpr std::array<CS200::RGBA, 4> checker = { 0x3B4252FF, 0x4C566AFF, 0x4C566AFF, 0x3B4252FF };
+            return OpenGL::CreateTextureFromMemory({ 2, 2 }, checker);
+        }
+
+        std::size_t page_bytes(const TextureAtlas::Page& page) noexcept
+        {
+            const auto size = page.Packer.GetSize();
+            return static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) * 4;
+        }
+
+        GLenum gl_format(CS200::Etc2Format format) noexcept
+        {
+            return format == CS200::Etc2Format::RGB8 ? GL_COMPRESSED_RGB8_ETC2 : GL_COMPRESSED_RGBA8_ETC2_EAC;
+        }
+
+        // every level in the file goes up, smaller ones only exist when the tool was run with --mips
+        OpenGL::TextureHandle create_compressed(const CS200::Ktx2Texture& compressed)
+        {
+            std::vector<std::span<const std::uint8_t>> levels{ compressed.Data };
+            levels.insert(levels.end(), compressed.MipLevels.begin(), compressed.MipLevels.end());
+            return OpenGL::CreateCompressedTexture(compressed.Size, gl_format(compressed.Format), levels);
+        }
+
+        bool etc2_supported() noexcept
+        {
+            return OpenGL::IsCompressedFormatSupported(GL_COMPRESSED_RGB8_ETC2) && OpenGL::IsCompressedFormatSupported(GL_COMPRESSED_RGBA8_ETC2_EAC);
+        }
+
+        // a .ktx2 made by cs200_compress_textures next to the png, if it is still up to date
+        std::optional<CS200::Ktx2Texture> read_compressed(const std::filesystem::path& file_name)
+        {
+            std::error_code ec;
+            const auto      png_path = assets::locate_asset(file_name);
+            auto            ktx_path = png_path;
+            ktx_path.replace_extension(".ktx2");
+            if (!std::filesystem::exists(ktx_path, ec))
+            {
+                return std::nullopt;
+            }
+            auto compressed = CS200::ReadKtx2(ktx_path);
+            if (!compressed || compressed->SourceHash != assets::hash_asset(png_path))
+            {
+                return std::nullopt;
+            }
+            return compressed;
+        }
+
+        // texels cooked by cs200_cook, from the pack or next to the png; premultiplied ones do not suit the straight alpha blending here
+        std::optional<CS200::CookedTexture> read_cooked(const std::filesystem::path& file_name)
+        {
+            auto ctex_name = file_name;
+            ctex_name.replace_extension(".ctex");
+
+            std::optional<CS200::CookedTexture> cooked;
+            std::optional<std::uint64_t>        png_hash;
+            if (const auto packed = assets::find_packed(ctex_name))
+            {
+                png_hash = assets::hash_asset(file_name);
+                cooked   = CS200::ReadCookedTexture(*packed);
+            }
+            else
+            {
+                std::error_code ec;
+                const auto      png_path  = assets::locate_asset(file_name);
+                auto            ctex_path = png_path;
+                ctex_path.replace_extension(".ctex");
+                if (!std::filesystem::exists(ctex_path, ec))
+                {
+                    return std::nullopt;
+                }
+                png_hash = assets::hash_asset(png_path);
+
+                std::ifstream             file(ctex_path, std::ios::binary | std::ios::ate);
+                std::vector<std::uint8_t> bytes(file ? static_cast<std::size_t>(file.tellg()) : 0);
+                file.seekg(0);
+                file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+                if (file)
+                {
+                    cooked = CS200::ReadCookedTexture(bytes);
+                }
+            }
+            if (!cooked || cooked->SourceHash != png_hash || cooked->Premultiplied)
+            {
+                return std::nullopt;
+            }
+            return cooked;
+        }
+    }
+
+    std::size_t TextureManager::CacheKeyHash::operator()(const CacheKey& key) const noexcept
+    {
+        return std::hash<assets::AssetId>{}(key.Asset) * 2 + (key.Mask ? 1 : 0);
+    }
+
+    TextureManager::~TextureManager()
+    {
+        stop_workers();
+    }
     std::shared_ptr<Texture> TextureManager::Load(const std::filesystem::path& file_name)
     {
+        return Load(assets::intern_asset(file_name));
+    }
 
-        auto it = texture_cache.find(file_name);
+    std::shared_ptr<Texture> TextureManager::Load(assets::AssetName asset)
+    {
+        return Load(assets::intern_asset(asset));
+    }
+
+    std::shared_ptr<Texture> TextureManager::Load(assets::AssetId asset)
+    {
+
+        auto it = texture_cache.find({ asset, false });
 
         if (it != texture_cache.end())
         {
-            return it->second;
+            it->second.LastUsedFrame = frame_number;
+            return it->second.Resident;
         }
         else 
         {
+            const auto file_name = assets::resolve_asset(asset);
+
+            std::shared_ptr<Texture> newtexture;
+            if (auto compressed = etc2_supported() ? read_compressed(file_name) : std::nullopt)
+            {
+                newtexture.reset(new Texture(create_compressed(*compressed), *compressed));
+            }
+            else if (atlas)
+            {
+                constexpr bool     flip_image = true; // same orientation as Texture(file_name)
+                const CS200::Image image(file_name, flip_image);
+                if (auto placement = atlas->Add(image))
+                {
+                    newtexture.reset(new Texture(std::move(*placement), image.GetSize()));
+                }
+                else
+                {
+                    newtexture.reset(new Texture(OpenGL::CreateTextureFromImage(image), image.GetSize()));
+                }
+            }
+            else if (const auto cooked = read_cooked(file_name))
+            {
+                // already decoded and flipped, straight to the GPU
+                newtexture.reset(new Texture(OpenGL::CreateTextureFromMemory(cooked->Size, cooked->Texels), cooked->Size));
+            }
+            else
+            {
+                newtexture.reset(new Texture(file_name)); // calls the constructor with the arguement
+            }
+
+            texture_cache[{ asset, false }] = { newtexture, frame_number };
+
+            Engine::GetLogger().LogDebug("Loaded texture for first time : " + assets::asset_key(asset));
+            return newtexture;
+        }
+
+    }
 
-            std::shared_ptr<Texture> newtexture(new Texture(file_name)); // calls the constructor with the arguement
+    std::shared_ptr<Texture> TextureManager::LoadMask(const std::filesystem::path& file_name)
+    {
+        const auto asset = assets::intern_asset(file_name);
+        if (const auto it = texture_cache.find({ asset, true }); it != texture_cache.end())
+        {
+            it->second.LastUsedFrame = frame_number;
+            return it->second.Resident;
+        }
 
-            texture_cache[file_name] = newtexture;
+        constexpr bool                     flip_image = true; // same orientation as Texture(file_name)
+        const CS200::Image                 image(assets::resolve_asset(asset), flip_image);
+        const auto                         size = image.GetSize();
+        const std::span<const CS200::RGBA> texels(image.data(), static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y));
+        const auto                         format = OpenGL::ChooseMaskFormat(texels);
 
-            loaded_textures.push_back(newtexture);
+        std::shared_ptr<Texture> newtexture(new Texture(OpenGL::CreateTextureFromMemory(size, texels, format), size, texels.size() * OpenGL::BytesPerTexel(format)));
+        newtexture->format             = format;
+        texture_cache[{ asset, true }] = { newtexture, frame_number };
 
-            Engine::GetLogger().LogDebug("Loaded texture for first time : " + file_name.string());
-            return newtexture;
+        Engine::GetLogger().LogDebug("Loaded mask texture as " + std::string(OpenGL::GetFormatName(format)) + " : " + assets::asset_key(asset));
+        return newtexture;
+    }
+
+    std::shared_ptr<Texture> TextureManager::LoadAsync(const std::filesystem::path& file_name)
+    {
+        return LoadAsync(assets::intern_asset(file_name));
+    }
+
+    std::shared_ptr<Texture> TextureManager::LoadAsync(assets::AssetName asset)
+    {
+        return LoadAsync(assets::intern_asset(asset));
+    }
+
+    std::shared_ptr<Texture> TextureManager::LoadAsync(assets::AssetId asset)
+    {
+        if (const auto it = texture_cache.find({ asset, false }); it != texture_cache.end())
+        {
+            it->second.LastUsedFrame = frame_number;
+            return it->second.Resident;
+        }
+
+        // resolved once here, the workers reuse the answer instead of searching again
+        const auto file_name = assets::resolve_asset(asset);
+
+        const auto size = CS200::Image::ReadSize(file_name);
+        if (!size)
+        {
+            throw std::runtime_error("failed to read image header : " + file_name.string());
+        }
+
+        std::shared_ptr<Texture> newtexture(new Texture(create_placeholder(), *size, 2 * 2 * 4));
+        newtexture->placeholder = true; // SetFiltering() waits for the real pixels
+        const bool               allow_compressed = etc2_supported(); // the workers have no GL context to ask
+        texture_cache[{ asset, false }] = { newtexture, frame_number };
+
+#if defined(__EMSCRIPTEN__)
+        // no threads on the web build, decode now and still defer the upload
+        auto result = decode({ file_name, newtexture, allow_compressed });
+        {
+            std::scoped_lock lock(async_mutex);
+            decoded.push_back(std::move(result));
+            ++pending_count;
+        }
+#else
+        {
+            std::scoped_lock lock(async_mutex);
+            decode_jobs.push_back({ file_name, newtexture, allow_compressed });
+            ++pending_count;
+        }
+        start_workers();
+        jobs_ready.notify_one();
+#endif
+
+        Engine::GetLogger().LogDebug("Queued texture for background loading : " + file_name.string());
+        return newtexture;
+    }
+
+    TextureManager::MemoryStats TextureManager::GetMemoryStats() const
+    {
+        MemoryStats stats;
+        stats.Evictions = eviction_count;
+        for (const auto& [key, entry] : texture_cache)
+        {
+            const auto& texture = entry.Resident;
+            const auto  size    = texture->GetSize();
+            ++stats.Textures;
+            if (texture->atlasPage != nullptr)
+            {
+                continue; // its page is counted below, and never evicted
+            }
+            stats.GpuBytes += texture->GetMemoryBytes();
+            stats.Rgba8Bytes += static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) * 4;
+            if (texture->compressed)
+            {
+                ++stats.Compressed;
+            }
+            if (texture.use_count() == 1)
+            {
+                stats.Evictable += texture->GetMemoryBytes();
+            }
         }
+        for (const auto* page : live_atlas_pages())
+        {
+            stats.GpuBytes += page_bytes(*page);
+            stats.Rgba8Bytes += page_bytes(*page);
+        }
+        return stats;
+    }
 
+    std::vector<TextureManager::ResidentTexture> TextureManager::GetResidentTextures() const
+    {
+        std::vector<ResidentTexture> residents;
+        residents.reserve(texture_cache.size());
+        for (const auto& [key, entry] : texture_cache)
+        {
+            const auto& texture  = *entry.Resident;
+            const bool  in_atlas = texture.atlasPage != nullptr;
+            residents.push_back({ assets::asset_key(key.Asset) + (key.Mask ? " (mask)" : ""), texture.GetSize(), in_atlas ? 0 : texture.GetMemoryBytes(), texture.GetMipLevelCount(), texture.compressed, in_atlas,
+                                  OpenGL::GetFormatName(texture.format), entry.Resident.use_count() > 1, frame_number - entry.LastUsedFrame });
+        }
+        const auto pages = live_atlas_pages();
+        for (std::size_t i = 0; i < pages.size(); ++i)
+        {
+            residents.push_back({ "atlas page " + std::to_string(i), pages[i]->Packer.GetSize(), page_bytes(*pages[i]), 1, false, true, "RGBA8", true, 0 });
+        }
+        std::sort(residents.begin(), residents.end(), [](const ResidentTexture& a, const ResidentTexture& b) { return a.FramesIdle > b.FramesIdle; });
+        return residents;
+    }
+
+    std::vector<const TextureAtlas::Page*> TextureManager::live_atlas_pages() const
+    {
+        // the atlas's own pages, plus pages a disabled or replaced atlas left behind that cached images still sit on
+        std::vector<const TextureAtlas::Page*> pages;
+        if (atlas)
+        {
+            for (const auto& page : atlas->GetPages())
+            {
+                pages.push_back(page.get());
+            }
+        }
+        for (const auto& [key, entry] : texture_cache)
+        {
+            const auto* page = entry.Resident->atlasPage.get();
+            if (page != nullptr && std::find(pages.begin(), pages.end(), page) == pages.end())
+            {
+                pages.push_back(page);
+            }
+        }
+        return pages;
+    }
+
+    TextureRef TextureManager::Acquire(const std::shared_ptr<Texture>& texture)
+    {
+        if (!texture)
+        {
+            return {};
+        }
+        if (const auto found = slot_of_texture.find(texture.get()); found != slot_of_texture.end())
+        {
+            auto& slot = slots[found->second];
+            ++slot.Holders;
+            return { found->second, slot.Generation };
+        }
+
+        std::uint32_t index = 0;
+        if (!free_slots.empty())
+        {
+            index = free_slots.back();
+            free_slots.pop_back();
+        }
+        else
+        {
+            index = static_cast<std::uint32_t>(slots.size());
+            slots.emplace_back();
+        }
+        auto& slot   = slots[index];
+        slot.Owner   = texture;
+        slot.Holders = 1;
+        slot_of_texture.emplace(texture.get(), index);
+        return { index, slot.Generation };
+    }
+
+    void TextureManager::Release(TextureRef texture)
+    {
+        if (Get(texture) == nullptr)
+        {
+            return;
+        }
+        auto& slot = slots[texture.GetIndex()];
+        if (--slot.Holders > 0)
+        {
+            return;
+        }
+        slot_of_texture.erase(slot.Owner.get());
+        slot.Owner.reset();
+        // 0 is what default constructed refs carry, skip it when the counter wraps
+        if (++slot.Generation == 0)
+        {
+            slot.Generation = 1;
+        }
+        free_slots.push_back(texture.GetIndex());
+    }
+
+    void TextureManager::EnableAtlas(TextureAtlas::Settings settings)
+    {
+        atlas.emplace(settings);
+    }
+
+    void TextureManager::DisableAtlas()
+    {
+        atlas.reset();
+    }
+
+    void TextureManager::Update()
+    {
+        std::deque<DecodedImage> finished;
+        {
+            std::scoped_lock lock(async_mutex);
+            finished.swap(decoded);
+            pending_count -= finished.size();
+        }
+
+        for (auto& result : finished)
+        {
+            const auto texture = result.Target.lock();
+            if (!texture)
+            {
+                continue; // nobody holds the texture anymore, drop the pixels
+            }
+            if (result.Compressed)
+            {
+                // already in its final form, one small upload
+                const auto& compressed = *result.Compressed;
+                const auto  filtering  = texture->filtering;
+                *texture               = Texture(create_compressed(compressed), compressed);
+                texture->SetFiltering(filtering);
+                Engine::GetLogger().LogDebug("Uploaded background loaded compressed texture : " + result.Path.string());
+                continue;
+            }
+            if (!result.Cooked && !result.Pixels)
+            {
+                Engine::GetLogger().LogError("Background texture load failed, keeping placeholder : " + result.Error);
+                continue;
+            }
+
+            if (!uploads.IsCreated())
+            {
+                uploads.Create(upload_budget_bytes);
+            }
+
+            // the texels are handed to the upload queue and freed once their last row went out
+            Math::ivec2                  size;
+            std::span<const CS200::RGBA> texels;
+            std::shared_ptr<const void>  keep_alive;
+            if (result.Cooked)
+            {
+                // already decoded and flipped by cs200_cook
+                const auto cooked = std::make_shared<const CS200::CookedTexture>(std::move(*result.Cooked));
+                size              = cooked->Size;
+                texels            = cooked->Texels;
+                keep_alive        = cooked;
+            }
+            else
+            {
+                const auto pixels = std::make_shared<const CS200::Image>(std::move(*result.Pixels));
+                size              = pixels->GetSize();
+                texels            = std::span<const CS200::RGBA>(pixels->data(), static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y));
+                keep_alive        = pixels;
+            }
+            const auto handle = OpenGL::CreateRGBATexture(size);
+            uploads.Enqueue(handle, size, texels, std::move(keep_alive),
+                            [target = result.Target, handle, size, path = std::move(result.Path)](bool uploaded) mutable
+                            {
+                                // swap into the existing object so every holder of the shared_ptr sees the real image
+                                if (const auto target_texture = target.lock(); target_texture && uploaded)
+                                {
+                                    // a filtering mode set on the placeholder, mipmaps included, carries over
+                                    const auto filtering = target_texture->filtering;
+                                    *target_texture      = Texture(handle, size);
+                                    target_texture->SetFiltering(filtering);
+                                    Engine::GetLogger().LogDebug("Uploaded background loaded texture : " + path.string());
+                                    return;
+                                }
+                                GL::DeleteTextures(1, &handle);
+                            });
+        }
+
+        uploads.Pump(upload_budget_bytes);
+
+        enforce_budget();
+        ++frame_number;
+    }
+
+    void TextureManager::enforce_budget()
+    {
+        std::size_t                                            total_bytes = 0;
+        std::vector<std::pair<std::uint64_t, CacheKey>>        candidates;
+        for (auto& [key, entry] : texture_cache)
+        {
+            total_bytes += entry.Resident->GetMemoryBytes();
+            if (entry.Resident.use_count() > 1)
+            {
+                entry.LastUsedFrame = frame_number; // a game object still draws with it
+            }
+            else if (entry.Resident->atlasPage == nullptr)
+            {
+                candidates.emplace_back(entry.LastUsedFrame, key);
+            }
+        }
+        if (memory_budget_bytes == 0 || total_bytes <= memory_budget_bytes)
+        {
+            return;
+        }
+
+        // oldest first; the cache holds the only reference, so erasing deletes the GL texture
+        std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (const auto& [last_used, key] : candidates)
+        {
+            if (total_bytes <= memory_budget_bytes)
+            {
+                break;
+            }
+            const auto found = texture_cache.find(key);
+            total_bytes -= found->second.Resident->GetMemoryBytes();
+            Engine::GetLogger().LogDebug("Evicted texture over the memory budget : " + assets::asset_key(key.Asset));
+            texture_cache.erase(found);
+            ++eviction_count;
+        }
+    }
+
+    std::size_t TextureManager::GetPendingCount() const
+    {
+        std::scoped_lock lock(async_mutex);
+        return pending_count + uploads.GetStats().QueuedTextures;
+    }
+
+    TextureManager::DecodedImage TextureManager::decode(DecodeJob job)
+    {
+        DecodedImage result{ std::move(job.Path), std::move(job.Target), std::nullopt, std::nullopt, std::nullopt, {} };
+        try
+        {
+            if (job.AllowCompressed && (result.Compressed = read_compressed(result.Path)))
+            {
+                return result;
+            }
+            if ((result.Cooked = read_cooked(result.Path)))
+            {
+                return result;
+            }
+
+            constexpr bool flip_image = true; // same orientation as Texture(file_name)
+            result.Pixels.emplace(result.Path, flip_image);
+        }
+        catch (const std::exception& e)
+        {
+            result.Error = e.what();
+        }
+        return result;
+    }
+
+    void TextureManager::start_workers()
+    {
+        if (!workers.empty())
+        {
+            return;
+        }
+
+        // leave a core for the main thread, decoding is memory bound past a few threads anyway
+        const unsigned hardware     = std::thread::hardware_concurrency();
+        const unsigned worker_count = std::clamp(hardware > 1 ? hardware - 1 : 1u, 1u, 4u);
+        for (unsigned i = 0; i < worker_count; ++i)
+        {
+            workers.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    void TextureManager::stop_workers()
+    {
+        {
+            std::scoped_lock lock(async_mutex);
+            stopping = true;
+        }
+        jobs_ready.notify_all();
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        workers.clear();
+
+        // queued and finished decodes are dropped with the workers, otherwise GetPendingCount() would never reach zero again
+        std::scoped_lock lock(async_mutex);
+        decode_jobs.clear();
+        decoded.clear();
+        pending_count = 0;
+        stopping      = false;
+    }
+
+    void TextureManager::worker_loop()
+    {
+        while (true)
+        {
+            DecodeJob job;
+            {
+                std::unique_lock lock(async_mutex);
+                jobs_ready.wait(lock, [this] { return stopping || !decode_jobs.empty(); });
+                if (stopping)
+                {
+                    return;
+                }
+                job = std::move(decode_jobs.front());
+                decode_jobs.pop_front();
+            }
+
+            if (job.Target.expired())
+            {
+                std::scoped_lock lock(async_mutex);
+                --pending_count;
+                continue;
+            }
+
+            auto result = decode(std::move(job));
+            std::scoped_lock lock(async_mutex);
+            decoded.push_back(std::move(result));
+        }
     }
 
     void TextureManager::Unload()
     {
         Engine::GetLogger().LogDebug("unloading textures");
 
-        loaded_textures.clear();
+        // let decodes in flight finish, they may read from the asset pack; queued ones are dropped
+        stop_workers();
+
+        // unfinished uploads delete their GPU textures; like the dropped decodes, their placeholders stay placeholders
+        uploads.Destroy();
+
+        // pages stay alive while textures on them are held elsewhere, new loads start on fresh pages
+        if (atlas)
+        {
+            // emplace destroys the old atlas first, so its settings must be copied out before
+            const auto settings = atlas->GetSettings();
+            atlas.emplace(settings);
+        }
 
         texture_cache.clear();
 
+        // every ref goes stale, the slots themselves are reused with their next generation
+        for (std::uint32_t index = 0; index < slots.size(); ++index)
+        {
+            auto& slot = slots[index];
+            if (slot.Owner)
+            {
+                slot.Owner.reset();
+                slot.Holders = 0;
+                if (++slot.Generation == 0)
+                {
+                    slot.Generation = 1;
+                }
+                free_slots.push_back(index);
+            }
+        }
+        slot_of_texture.clear();
+
 
     }
 
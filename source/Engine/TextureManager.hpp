@@ -9,11 +9,26 @@
  */
 
 #pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <filesystem>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
+#include "CS200/CookedTexture.hpp"
+#include "CS200/Image.hpp"
+#include "CS200/Ktx2.hpp"
+#include "Engine/AssetRegistry.hpp"
 #include "OpenGL/Framebuffer.hpp"
+#include "OpenGL/PixelUploadQueue.hpp"
+#include "TextureAtlas.hpp"
+#include "TextureRef.hpp"
 
 #include "Engine/Vec2.hpp"
 
@@ -78,7 +93,7 @@ namespace CS230
          * Caching Behavior:
          * - First load: Reads file, creates GPU texture, stores in cache
          * - Subsequent loads: Returns shared cached texture immediately
-         * - Cache key: Full file path (different paths to same file create separate entries)
+         * - Cache key: The interned assets::AssetId, so "Assets/x.png" and an absolute path to it share an entry
          * - Memory efficiency: Prevents duplicate GPU resources for same image
          *
          * Resource Ownership:
@@ -96,9 +111,263 @@ namespace CS230
          * - First load: File I/O + GPU texture creation overhead
          * - Cached loads: Very fast hash table lookup with no I/O
          * - Memory usage: One GPU texture per unique file path
+         *
+         * Compressed Textures:
+         * When a .ktx2 file made by the cs200_compress_textures tool sits next
+         * to the png, was made from a png with the current contents (the png
+         * is read and hashed, which is still far cheaper than decoding it),
+         * and the GPU supports ETC2, the compressed blocks are uploaded
+         * instead and the png is never decoded. Otherwise the png is loaded as RGBA8 as usual.
          */
         std::shared_ptr<Texture> Load(const std::filesystem::path& file_name);
 
+        /**
+         * \brief Load() for an interned asset, a cache hit is one integer hash lookup
+         *
+         * Load("Assets/images/Cat.png"_asset) in code that runs every frame
+         * skips the path normalization and hashing of the path overload.
+         */
+        std::shared_ptr<Texture> Load(assets::AssetId asset);
+        std::shared_ptr<Texture> Load(assets::AssetName asset);
+
+        /**
+         * \brief Start loading a texture in the background and return its handle right away
+         * \param file_name Path to the image file to load
+         * \return Shared pointer to the texture, shared with Load() through the same cache
+         *
+         * Only the image header is read here, so GetSize() already reports the
+         * final dimensions and layout code does not need to wait. Until the
+         * pixels arrive the texture shows a small checkerboard placeholder.
+         *
+         * Decoding happens on a pool of worker threads. The decoded images are
+         * queued and uploaded to the GPU by Update() on the main thread, which
+         * owns the OpenGL context, so a state can request many large images in
+         * Load() without stalling the first frame.
+         *
+         * The workers pick up a .ktx2 or cooked .ctex next to the png the same
+         * way Load() does, and then skip the decode.
+         *
+         * If decoding fails the error is logged and the placeholder stays. A
+         * missing file still throws right away, like Load() does. Unload()
+         * drops loads that have not arrived yet, and their textures keep the
+         * placeholder too.
+         *
+         * On the web build there are no worker threads; the decode runs inside
+         * this call and only the upload is deferred to Update().
+         */
+        std::shared_ptr<Texture> LoadAsync(const std::filesystem::path& file_name);
+        std::shared_ptr<Texture> LoadAsync(assets::AssetId asset);
+        std::shared_ptr<Texture> LoadAsync(assets::AssetName asset);
+
+        /**
+         * \brief Load a font sheet or mask image into the smallest format that samples the same
+         * \param file_name Path to the image file to load
+         * \return Shared pointer to the texture, cached like Load() does
+         *
+         * Glyph sheets and masks carry their information in alpha. Texels that
+         * are white wherever they are visible are stored as R8, coverage only,
+         * and gray ones as RG8, gray and alpha; the texture swizzle makes both
+         * sample as the RGBA image did, so shaders do not change. That is a
+         * quarter or half of the RGBA8 memory and sampling bandwidth. Images
+         * with real color stay RGBA8.
+         *
+         * WebGL2 has no texture swizzle, so there both formats are uploaded as
+         * LUMINANCE_ALPHA at two bytes per texel.
+         *
+         * Masks are never packed into the atlas or replaced by a KTX2 file.
+         * They are cached apart from Load(), so loading the same image both
+         * ways gives two textures, each in its own format.
+         */
+        std::shared_ptr<Texture> LoadMask(const std::filesystem::path& file_name);
+
+        /**
+         * \brief Video memory taken by the textures loaded through Load() and LoadAsync()
+         *
+         * Rgba8Bytes is what the same textures would take uncompressed, so the
+         * two together show what the KTX2 files save. Sampling bandwidth scales
+         * the same way: GpuBytes * 8 / texels is the average bits per texel a
+         * sample fetches, against 32 for RGBA8.
+         *
+         * Images in the atlas are counted through their pages, each live page
+         * once at its full size, since that is what sits in video memory no
+         * matter how much of it is filled.
+         */
+        struct MemoryStats
+        {
+            std::size_t Textures   = 0;
+            std::size_t Compressed = 0;
+            std::size_t GpuBytes   = 0;
+            std::size_t Rgba8Bytes = 0;
+            std::size_t Evictable  = 0; ///< Textures only the cache still holds, first to go when over budget
+            std::size_t Evictions  = 0; ///< Textures evicted since startup
+        };
+
+        [[nodiscard]] MemoryStats GetMemoryStats() const;
+
+        /**
+         * \brief Cap the video memory of the cached textures, 0 turns the cap off
+         * \param bytes Budget compared against the sum of Texture::GetMemoryBytes(), mip chains included
+         *
+         * Without a budget every texture stays cached until Unload(). With one,
+         * Update() checks the total once per frame and, while it is over,
+         * releases the least recently used textures that nothing outside the
+         * manager holds anymore. "Used" means returned by Load() or LoadAsync(),
+         * or held by a game object during a frame. An evicted texture is loaded
+         * again, from disk or the asset pack, the next time it is asked for.
+         *
+         * Textures still in use are never evicted, so the total can stay above
+         * the budget. Atlas images are not evicted either, freeing one would not
+         * give its page's memory back. Meant for running large content sets
+         * inside the small heaps of browsers and WebGL.
+         */
+        void SetMemoryBudget(std::size_t bytes) noexcept
+        {
+            memory_budget_bytes = bytes;
+        }
+
+        [[nodiscard]] std::size_t GetMemoryBudget() const noexcept
+        {
+            return memory_budget_bytes;
+        }
+
+        /**
+         * \brief One cached texture, as listed by GetResidentTextures()
+         */
+        struct ResidentTexture
+        {
+            std::string   Asset;
+            Math::ivec2   Size{ 0, 0 };
+            std::size_t   GpuBytes   = 0;
+            int           MipLevels  = 1;
+            bool          Compressed = false;
+            bool          InAtlas    = false;
+            const char*   Format     = "RGBA8";
+            bool          Referenced = false; ///< Held outside the manager, cannot be evicted
+            std::uint64_t FramesIdle = 0;     ///< Frames since it was last loaded or held
+        };
+
+        /**
+         * \brief Every cached texture, least recently used first, for debug views
+         *
+         * Each live atlas page gets a row of its own holding the page's bytes.
+         * The images on it report 0 GpuBytes, so the rows add up to
+         * MemoryStats::GpuBytes.
+         */
+        [[nodiscard]] std::vector<ResidentTexture> GetResidentTextures() const;
+
+        /**
+         * \brief Hold a texture through a TextureRef instead of a shared_ptr
+         * \param texture Any texture, from Load(), LoadAsync(), Font or render-to-texture
+         * \return A ref that Get() resolves, the same one every time for the same texture
+         *
+         * The manager keeps one shared_ptr per slot and a plain count of the
+         * Acquire() calls, so game code can copy the ref freely and pays for
+         * ownership only here and in Release(). Held textures count as in use
+         * and are never evicted by the memory budget.
+         */
+        [[nodiscard]] TextureRef Acquire(const std::shared_ptr<Texture>& texture);
+
+        /**
+         * \brief Undo one Acquire(), the last one frees the slot and makes every copy of the ref stale
+         */
+        void Release(TextureRef texture);
+
+        /**
+         * \brief The texture behind a ref, or nullptr once it was released
+         *
+         * An index and a generation compare, no reference counting. The
+         * pointer stays valid until the ref's last Release() or Unload().
+         */
+        [[nodiscard]] Texture* Get(TextureRef texture) const noexcept
+        {
+            if (texture.GetIndex() >= slots.size() || slots[texture.GetIndex()].Generation != texture.GetGeneration())
+            {
+                return nullptr;
+            }
+            return slots[texture.GetIndex()].Owner.get();
+        }
+
+        /**
+         * \brief Pack images loaded from now on into shared atlas pages
+         * \param settings Page size, largest image that is packed, padding and edge extrusion
+         *
+         * In atlas mode Load() copies every image up to Settings::MaxImageSize
+         * into a TextureAtlas page instead of giving it a GL texture of its
+         * own. The returned Texture refers to the page plus a sub-rectangle,
+         * so sprites from different files share one texture binding, and
+         * Texture::Draw() with texel positions and frame sizes keeps working
+         * because it remaps the coordinates into the page.
+         *
+         * Textures loaded before the call are not moved. LoadAsync() is meant
+         * for large images and always gives them their own texture.
+         */
+        void EnableAtlas(TextureAtlas::Settings settings = {});
+
+        /**
+         * \brief Give images loaded from now on their own texture again
+         *
+         * Textures already on atlas pages stay valid, a page is freed with the
+         * last texture on it. A state that turns atlas mode on for its own
+         * loads turns it off when it unloads, so later states are unaffected.
+         */
+        void DisableAtlas();
+
+        /**
+         * \brief The atlas used by Load(), or null when atlas mode is off
+         */
+        [[nodiscard]] const TextureAtlas* GetAtlas() const noexcept
+        {
+            return atlas ? &*atlas : nullptr;
+        }
+
+        /**
+         * \brief Upload images finished by the decode workers, called once per frame by the Engine
+         *
+         * Finished images are queued on an OpenGL::PixelUploadQueue, which
+         * streams them through pixel unpack buffers, a band of rows at a time,
+         * until the byte budget for this frame is spent. A burst of completed
+         * loads is spread over several frames instead of causing a hitch. A
+         * texture swaps in only after its last row arrived, never half drawn.
+         *
+         * Afterwards the memory budget is enforced, see SetMemoryBudget().
+         */
+        void Update();
+
+        /**
+         * \brief Bytes of pixel data Update() may send to the GPU per frame
+         *
+         * Takes effect on the next Update(), uploads already queued included.
+         */
+        void SetUploadBudget(std::size_t bytes_per_frame) noexcept
+        {
+            upload_budget_bytes = bytes_per_frame;
+            uploads.SetBandBytes(bytes_per_frame);
+        }
+
+        [[nodiscard]] std::size_t GetUploadBudget() const noexcept
+        {
+            return upload_budget_bytes;
+        }
+
+        /**
+         * \brief Queue state of the streaming uploads, for profiling overlays
+         */
+        [[nodiscard]] OpenGL::PixelUploadQueue::Stats GetUploadStats() const noexcept
+        {
+            return uploads.GetStats();
+        }
+
+        /**
+         * \brief Number of LoadAsync() textures that still show their placeholder, decoding or uploading
+         */
+        [[nodiscard]] std::size_t GetPendingCount() const;
+
+        TextureManager() = default;
+        ~TextureManager();
+
+        TextureManager(const TextureManager&)            = delete;
+        TextureManager& operator=(const TextureManager&) = delete;
+
         /**
          * \brief Unload and clean up all managed textures
          *
@@ -124,7 +393,8 @@ namespace CS230
          *
          * Post-Cleanup State:
          * After calling Unload(), the manager's cache is cleared but previously
-         * returned shared_ptrs remain valid if held by client code. The manager
+         * returned shared_ptrs remain valid if held by client code. Every
+         * TextureRef goes stale, whatever its Acquire() count. The manager
          * returns to its initial empty state and is ready to load new textures.
          *
          */
@@ -239,8 +509,77 @@ namespace CS230
         static std::shared_ptr<Texture> EndRenderTextureMode();
 
     private:
-        std::unordered_map <std::filesystem::path, std::shared_ptr<Texture>> texture_cache;
-        std::vector<std::shared_ptr<Texture>>                     loaded_textures;
+        struct DecodeJob
+        {
+            std::filesystem::path   Path;
+            std::weak_ptr<Texture>  Target;
+            bool                    AllowCompressed = false;
+        };
+
+        struct DecodedImage
+        {
+            std::filesystem::path               Path;
+            std::weak_ptr<Texture>              Target;
+            std::optional<CS200::Ktx2Texture>   Compressed;
+            std::optional<CS200::CookedTexture> Cooked;
+            std::optional<CS200::Image>         Pixels;
+            std::string                         Error;
+        };
+
+        struct CacheEntry
+        {
+            std::shared_ptr<Texture> Resident;
+            std::uint64_t            LastUsedFrame = 0;
+        };
+
+        struct CacheKey
+        {
+            assets::AssetId Asset;
+            bool            Mask = false; // LoadMask() keeps its own texture, Load() of the same image does not get the mask format
+
+            bool operator==(const CacheKey&) const = default;
+        };
+
+        struct CacheKeyHash
+        {
+            std::size_t operator()(const CacheKey& key) const noexcept;
+        };
+
+        struct TextureSlot
+        {
+            std::shared_ptr<Texture> Owner;
+            std::uint32_t            Generation = 1;
+            std::uint32_t            Holders    = 0;
+        };
+
+        static DecodedImage decode(DecodeJob job);
+        void                start_workers();
+        void                stop_workers();
+        void                worker_loop();
+        void                enforce_budget();
+
+        [[nodiscard]] std::vector<const TextureAtlas::Page*> live_atlas_pages() const;
+
+        std::unordered_map<CacheKey, CacheEntry, CacheKeyHash> texture_cache;
+        std::vector<TextureSlot>                               slots;
+        std::vector<std::uint32_t>                             free_slots;
+        std::unordered_map<const Texture*, std::uint32_t>      slot_of_texture;
+        std::optional<TextureAtlas>                            atlas;
+        std::size_t                                            memory_budget_bytes = 0;
+        std::size_t                                            eviction_count      = 0;
+        std::uint64_t                                          frame_number        = 0;
+
+        // decode_jobs is filled by LoadAsync() and drained by the workers,
+        // decoded is filled by the workers and drained by Update()
+        mutable std::mutex                 async_mutex;
+        std::condition_variable            jobs_ready;
+        std::deque<DecodeJob>              decode_jobs;
+        std::deque<DecodedImage>           decoded;
+        std::size_t                        pending_count       = 0;
+        std::size_t                        upload_budget_bytes = 4 * 1024 * 1024;
+        bool                               stopping            = false;
+        std::vector<std::thread>           workers;
+        OpenGL::PixelUploadQueue           uploads;
 
         struct RenderState
         {
@@ -0,0 +1,70 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace CS230
+{
+    /**
+     * \brief Generational handle of a texture held by the TextureManager
+     *
+     * A slot index into the manager's dense slot array plus the generation
+     * the slot had when the handle was made. Copying one is copying 8 bytes,
+     * with no reference count to bump, so refs can be stored by value in
+     * draw commands, sort keys and component arrays.
+     *
+     * TextureManager::Get() checks the generation in O(1): once the slot is
+     * released and reused, old refs to it resolve to nullptr instead of to
+     * the new texture. A default constructed ref is never valid.
+     */
+    class TextureRef
+    {
+    public:
+        constexpr TextureRef() noexcept = default;
+
+        constexpr TextureRef(std::uint32_t slot_index, std::uint32_t slot_generation) noexcept : index(slot_index), generation(slot_generation)
+        {
+        }
+
+        [[nodiscard]] constexpr std::uint32_t GetIndex() const noexcept
+        {
+            return index;
+        }
+
+        [[nodiscard]] constexpr std::uint32_t GetGeneration() const noexcept
+        {
+            return generation;
+        }
+
+        /**
+         * \brief False for default constructed refs; a ref that is true may still be stale
+         */
+        [[nodiscard]] constexpr explicit operator bool() const noexcept
+        {
+            return generation != 0;
+        }
+
+        /**
+         * \brief Both halves in one integer, to fold the texture into sort keys
+         */
+        [[nodiscard]] constexpr std::uint64_t GetKey() const noexcept
+        {
+            return (static_cast<std::uint64_t>(generation) << 32) | index;
+        }
+
+        constexpr bool operator==(const TextureRef&) const noexcept = default;
+
+    private:
+        std::uint32_t index      = 0;
+        std::uint32_t generation = 0; // slots start at generation 1
+    };
+
+    static_assert(std::is_trivially_copyable_v<TextureRef> && sizeof(TextureRef) == 8);
+}
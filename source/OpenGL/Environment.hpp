@@ -9,10 +9,12 @@
 
 namespace OpenGL
 {
-    inline int MajorVersion         = 0;
-    inline int MinorVersion         = 0;
-    inline int MaxTextureImageUnits = 2;
-    inline int MaxTextureSize       = 64;
+    inline int  MajorVersion                  = 0;
+    inline int  MinorVersion                  = 0;
+    inline int  MaxTextureImageUnits          = 2;
+    inline int  MaxTextureSize                = 64;
+    inline bool SupportsProgramBinary         = false;
+    inline bool SupportsParallelShaderCompile = false;
 
     constexpr int version(int major, int minor) noexcept
     {
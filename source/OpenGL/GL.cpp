@@ -199,6 +199,11 @@ namespace GL
         glCheck(glBindBufferBase(target, index, buffer));
     }
 
+    void BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size SOURCE_LOCATION)
+    {
+        glCheck(glBindBufferRange(target, index, buffer, offset, size));
+    }
+
     void BindTexture(GLenum target, GLuint texture SOURCE_LOCATION)
     {
         glCheck(glBindTexture(target, texture));
@@ -885,6 +890,12 @@ namespace GL
         return index;
     }
 
+    const GLubyte* GetStringi(GLenum name, GLuint index SOURCE_LOCATION)
+    {
+        glCheck(const auto the_string = glGetStringi(name, index));
+        return the_string;
+    }
+
     void BeginQuery(GLenum target, GLuint id SOURCE_LOCATION)
     {
         glCheck(glBeginQuery(target, id));
@@ -1242,11 +1253,63 @@ namespace GL
         glCheck(glWaitSync(sync, flags, timeout));
     }
 
+#if !defined(IS_WEBGL2)
+
+    // Buffer mapping is not exposed by WebGL2
+    void* MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access SOURCE_LOCATION)
+    {
+        glCheck(void* const pointer = glMapBufferRange(target, offset, length, access));
+        return pointer;
+    }
+
+    GLboolean UnmapBuffer(GLenum target SOURCE_LOCATION)
+    {
+        glCheck(const auto result = glUnmapBuffer(target));
+        return result;
+    }
+
+#endif
+
+#if !defined(IS_WEBGL2)
+
+    // Program binaries are not exposed by WebGL2
+    void GetProgramBinary(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary SOURCE_LOCATION)
+    {
+        glCheck(glGetProgramBinary(program, bufSize, length, binaryFormat, binary));
+    }
+
+    void ProgramBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length SOURCE_LOCATION)
+    {
+        glCheck(glProgramBinary(program, binaryFormat, binary, length));
+    }
+
+    void ProgramParameteri(GLuint program, GLenum pname, GLint value SOURCE_LOCATION)
+    {
+        glCheck(glProgramParameteri(program, pname, value));
+    }
+
+#endif
+
     void TexStorage2D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height SOURCE_LOCATION)
     {
         glCheck(glTexStorage2D(target, levels, internalformat, width, height));
     }
 
+    void MaxShaderCompilerThreads([[maybe_unused]] GLuint count SOURCE_LOCATION)
+    {
+#if !defined(IS_WEBGL2)
+        if (GLEW_KHR_parallel_shader_compile)
+        {
+            glCheck(glMaxShaderCompilerThreadsKHR(count));
+        }
+        else if (GLEW_ARB_parallel_shader_compile)
+        {
+            glCheck(glMaxShaderCompilerThreadsARB(count));
+        }
+#endif
+        // browsers pick the compiler thread count themselves
+    }
+
 #if !defined(IS_WEBGL2)
 
     // OpenGL 4.3+ Debug functions
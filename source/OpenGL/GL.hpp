@@ -38,6 +38,7 @@ namespace GL
     void           AttachShader(GLuint program, GLuint shader SOURCE_LOCATION);
     void           BindBuffer(GLenum target, GLuint buffer SOURCE_LOCATION);
     void           BindBufferBase(GLenum target, GLuint index, GLuint buffer SOURCE_LOCATION);
+    void           BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size SOURCE_LOCATION);
     void           BindTexture(GLenum target, GLuint texture SOURCE_LOCATION);
     void           BlendEquation(GLenum mode SOURCE_LOCATION);
     void           BlendFunc(GLenum sfactor, GLenum dfactor SOURCE_LOCATION);
@@ -159,11 +160,14 @@ namespace GL
     GLboolean IsSampler(GLuint id SOURCE_LOCATION);
     GLboolean IsSync(GLsync sync SOURCE_LOCATION);
     GLboolean IsTransformFeedback(GLuint id SOURCE_LOCATION);
+    GLboolean UnmapBuffer(GLenum target SOURCE_LOCATION);
     GLenum    CheckFramebufferStatus(GLenum target SOURCE_LOCATION);
     GLenum    ClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout SOURCE_LOCATION);
     GLint     GetFragDataLocation(GLuint program, const char* name SOURCE_LOCATION);
     GLsync    FenceSync(GLenum condition, GLbitfield flags SOURCE_LOCATION);
     GLuint    GetUniformBlockIndex(GLuint program, const GLchar* uniformBlockName SOURCE_LOCATION);
+    const GLubyte* GetStringi(GLenum name, GLuint index SOURCE_LOCATION);
+    void*     MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access SOURCE_LOCATION); // not in WebGL2
     void      BeginQuery(GLenum target, GLuint id SOURCE_LOCATION);
     void      BeginTransformFeedback(GLenum primitiveMode SOURCE_LOCATION);
     void      BindFramebuffer(GLenum target, GLuint framebuffer SOURCE_LOCATION);
@@ -250,10 +254,18 @@ namespace GL
     // Opengl Version 3.2
     void TexImage2DMultisample(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations SOURCE_LOCATION);
 
+    // Opengl ES 3.0 or Opengl Version 4.1
+    void GetProgramBinary(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary SOURCE_LOCATION);
+    void ProgramBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length SOURCE_LOCATION);
+    void ProgramParameteri(GLuint program, GLenum pname, GLint value SOURCE_LOCATION);
+
     // Opengl ES 3.0 or Opengl Version 4.2
     void TexStorage2D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height SOURCE_LOCATION);
 
 
+    // KHR_parallel_shader_compile or ARB_parallel_shader_compile, no-op when neither is available
+    void MaxShaderCompilerThreads(GLuint count SOURCE_LOCATION);
+
     // Opengl 4.3
     void DebugMessageCallback(DEBUGPROC callback, const void* userParam SOURCE_LOCATION);
     void DebugMessageControl(GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint* ids, GLboolean enabled SOURCE_LOCATION);
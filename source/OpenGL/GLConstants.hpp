@@ -1271,3 +1271,15 @@
 #    define GL_TRANSFORM_FEEDBACK_STREAM_OVERFLOW 0x82ED
 
 #endif // GL_DEPTH_BUFFER_BIT
+
+// KHR_parallel_shader_compile / ARB_parallel_shader_compile (same values)
+#ifndef GL_COMPLETION_STATUS_KHR
+#    define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#    define GL_COMPLETION_STATUS_KHR           0x91B1
+#endif
+
+// ETC2 / EAC, core in OpenGL ES 3.0 and WebGL2, desktop through ARB_ES3_compatibility
+#ifndef GL_COMPRESSED_RGB8_ETC2
+#    define GL_COMPRESSED_RGB8_ETC2      0x9274
+#    define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
@@ -0,0 +1,161 @@
+/**
+ * \file
+ * \author JUNSEOK LEE
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "PixelUploadQueue.hpp"
+
+#include "GL.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    void fill_bound_buffer(const CS200::RGBA* pixels, std::size_t bytes)
+    {
+        const auto size = static_cast<GLsizeiptr>(bytes);
+#if defined(IS_WEBGL2)
+        // WebGL2 cannot map buffers, so the band is handed over with a copy that finishes before the call returns
+        GL::BufferData(GL_PIXEL_UNPACK_BUFFER, size, pixels, GL_STREAM_DRAW);
+#else
+        // orphan the old storage, then write the fresh one through an unsynchronized mapping: the driver neither
+        // copies the band a second time nor waits for the transfer still reading the old storage
+        GL::BufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+        void* const mapped = GL::MapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        if (mapped != nullptr)
+        {
+            std::memcpy(mapped, pixels, bytes);
+            if (GL::UnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE)
+            {
+                return;
+            }
+        }
+        // mapping failed, or the storage was lost while mapped (a mode switch on some drivers); copy the plain way
+        GL::BufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, size, pixels);
+#endif
+    }
+}
+
+namespace OpenGL
+{
+    PixelUploadQueue::~PixelUploadQueue()
+    {
+        Destroy();
+    }
+
+    void PixelUploadQueue::Create(std::size_t band_bytes, int buffer_count)
+    {
+        Destroy();
+        SetBandBytes(band_bytes);
+        buffers.resize(static_cast<std::size_t>(std::max(buffer_count, 1)));
+        GL::GenBuffers(static_cast<GLsizei>(buffers.size()), buffers.data());
+    }
+
+    void PixelUploadQueue::Destroy() noexcept
+    {
+        auto dropped = std::move(jobs);
+        jobs.clear();
+        for (auto& job : dropped)
+        {
+            if (!job.OnComplete)
+            {
+                continue;
+            }
+            try
+            {
+                job.OnComplete(false);
+            }
+            catch (...)
+            {
+                // nothing can be reported from here, the other dropped uploads still need their callbacks
+            }
+        }
+
+        if (!buffers.empty())
+        {
+            GL::DeleteBuffers(static_cast<GLsizei>(buffers.size()), buffers.data());
+            buffers.clear();
+        }
+        next_buffer = 0;
+    }
+
+    void PixelUploadQueue::SetBandBytes(std::size_t band_bytes) noexcept
+    {
+        max_band_bytes = std::max<std::size_t>(band_bytes, 4);
+    }
+
+    void PixelUploadQueue::Enqueue(TextureHandle texture, Math::ivec2 size, std::span<const CS200::RGBA> pixels, std::shared_ptr<const void> keep_alive, Completion on_complete)
+    {
+        if (size.x <= 0 || size.y <= 0 || pixels.size() < static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y))
+        {
+            throw std::runtime_error("PixelUploadQueue::Enqueue given fewer pixels than the texture size");
+        }
+        jobs.push_back(Job{ texture, size, pixels, std::move(keep_alive), std::move(on_complete), 0 });
+    }
+
+    std::size_t PixelUploadQueue::Pump(std::size_t byte_budget)
+    {
+        bytes_last_pump = 0;
+        if (buffers.empty())
+        {
+            return 0;
+        }
+
+        while (!jobs.empty())
+        {
+            auto&             job       = jobs.front();
+            const std::size_t row_bytes = static_cast<std::size_t>(job.Size.x) * sizeof(CS200::RGBA);
+            const std::size_t left      = byte_budget > bytes_last_pump ? byte_budget - bytes_last_pump : 0;
+            if (left < row_bytes && bytes_last_pump > 0)
+            {
+                break;
+            }
+
+            // whole rows only, and always at least one so a tiny budget still makes progress
+            const std::size_t budget_rows = std::max<std::size_t>(left / row_bytes, 1);
+            const std::size_t band_rows   = std::max<std::size_t>(max_band_bytes / row_bytes, 1);
+            const int         rows        = static_cast<int>(std::min({ budget_rows, band_rows, static_cast<std::size_t>(job.Size.y - job.NextRow) }));
+            const std::size_t band_bytes  = static_cast<std::size_t>(rows) * row_bytes;
+            const auto*       band_start  = job.Pixels.data() + static_cast<std::size_t>(job.NextRow) * static_cast<std::size_t>(job.Size.x);
+
+            // a buffer of the ring is reused every few bands, fill_bound_buffer() gives it fresh storage each time
+            GL::BindBuffer(GL_PIXEL_UNPACK_BUFFER, buffers[next_buffer]);
+            fill_bound_buffer(band_start, band_bytes);
+            GL::BindTexture(GL_TEXTURE_2D, job.Texture);
+            GL::TexSubImage2D(GL_TEXTURE_2D, 0, 0, job.NextRow, job.Size.x, rows, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            GL::BindTexture(GL_TEXTURE_2D, 0);
+            // left bound, every other glTexImage2D in the engine would read from the buffer
+            GL::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+            next_buffer = (next_buffer + 1) % buffers.size();
+            bytes_last_pump += band_bytes;
+            job.NextRow += rows;
+
+            if (job.NextRow >= job.Size.y)
+            {
+                auto finished = std::move(job);
+                jobs.pop_front();
+                if (finished.OnComplete)
+                {
+                    finished.OnComplete(true);
+                }
+            }
+        }
+        return bytes_last_pump;
+    }
+
+    PixelUploadQueue::Stats PixelUploadQueue::GetStats() const noexcept
+    {
+        Stats stats;
+        stats.BytesLastPump  = bytes_last_pump;
+        stats.QueuedTextures = jobs.size();
+        for (const auto& job : jobs)
+        {
+            stats.QueuedBytes += static_cast<std::size_t>(job.Size.y - job.NextRow) * static_cast<std::size_t>(job.Size.x) * sizeof(CS200::RGBA);
+        }
+        return stats;
+    }
+}
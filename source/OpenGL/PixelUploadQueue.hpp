@@ -0,0 +1,136 @@
+/**
+ * \file
+ * \author JUNSEOK LEE
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Buffer.hpp"
+#include "CS200/RGBA.hpp"
+#include "Engine/Vec2.hpp"
+#include "Texture.hpp"
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace OpenGL
+{
+    /**
+     * \brief Streams RGBA pixels into existing textures through a ring of pixel unpack buffers
+     *
+     * Uploads are queued and then fed to the GPU by Pump(), a band of rows at
+     * a time, never more bytes per call than the budget it is given. Each band
+     * is copied into the next pixel unpack buffer of the ring and
+     * glTexSubImage2D reads from that buffer instead of client memory, so the
+     * call returns as soon as the copy into the buffer is done and the
+     * transfer into the texture overlaps with the frame's draws. Rotating
+     * through several buffers keeps a band from waiting on the transfer of
+     * the band before it.
+     *
+     * On desktop GL the band is written through an unsynchronized mapping of
+     * freshly orphaned storage. WebGL2 cannot map buffers, so there the band
+     * goes through glBufferData, a copy the call waits for.
+     *
+     * Large images therefore spread over several frames instead of stalling
+     * one. The texture must already have storage of the queued size, for
+     * example from CreateRGBATexture().
+     *
+     * Create() and Destroy() need a current OpenGL context.
+     */
+    class PixelUploadQueue
+    {
+    public:
+        static constexpr int DefaultBufferCount = 3;
+
+        /**
+         * \brief Called once per queued upload, with false if it was dropped by Destroy() before finishing
+         *
+         * Runs inside Pump() or Destroy(), so it may call OpenGL, for example
+         * to delete the texture of a dropped upload. Destroy() is noexcept and
+         * also runs from the destructor: an exception a completion throws there
+         * is swallowed so the remaining completions still run, and the queue
+         * should be destroyed while the context is still current.
+         */
+        using Completion = std::function<void(bool uploaded)>;
+
+        struct Stats
+        {
+            std::size_t BytesLastPump   = 0;
+            std::size_t QueuedBytes     = 0;
+            std::size_t QueuedTextures  = 0;
+        };
+
+        PixelUploadQueue() = default;
+        ~PixelUploadQueue();
+
+        PixelUploadQueue(const PixelUploadQueue&)            = delete;
+        PixelUploadQueue& operator=(const PixelUploadQueue&) = delete;
+
+        /**
+         * \brief Create the pixel unpack buffers
+         * \param band_bytes Largest band uploaded at once, rounded up to whole rows of the widest texture
+         * \param buffer_count Number of buffers rotated through
+         */
+        void Create(std::size_t band_bytes, int buffer_count = DefaultBufferCount);
+        void Destroy() noexcept;
+
+        /**
+         * \brief Change the largest band of later Pump() calls, queued uploads carry on
+         *
+         * The buffers are re-specified for every band, so this needs neither
+         * a context nor recreating them.
+         */
+        void SetBandBytes(std::size_t band_bytes) noexcept;
+
+        [[nodiscard]] bool IsCreated() const noexcept
+        {
+            return !buffers.empty();
+        }
+
+        /**
+         * \brief Queue a full upload of a texture
+         * \param texture Texture with storage of at least size, filled bottom row first
+         * \param size Width and height in texels
+         * \param pixels size.x * size.y texels, must stay valid until the completion runs
+         * \param keep_alive Optional owner of pixels, released once the upload is done
+         * \param on_complete Optional callback after the last band went out
+         */
+        void Enqueue(TextureHandle texture, Math::ivec2 size, std::span<const CS200::RGBA> pixels, std::shared_ptr<const void> keep_alive = {}, Completion on_complete = {});
+
+        /**
+         * \brief Upload queued rows until the byte budget is spent
+         * \param byte_budget Bytes allowed for this call, at least one row goes out if anything is queued
+         * \return Number of bytes uploaded
+         */
+        std::size_t Pump(std::size_t byte_budget);
+
+        [[nodiscard]] bool IsIdle() const noexcept
+        {
+            return jobs.empty();
+        }
+
+        [[nodiscard]] Stats GetStats() const noexcept;
+
+    private:
+        struct Job
+        {
+            TextureHandle                Texture = 0;
+            Math::ivec2                  Size{ 0, 0 };
+            std::span<const CS200::RGBA> Pixels;
+            std::shared_ptr<const void>  KeepAlive;
+            Completion                   OnComplete;
+            int                          NextRow = 0;
+        };
+
+        std::vector<BufferHandle> buffers;
+        std::size_t               next_buffer     = 0;
+        std::size_t               max_band_bytes  = 0;
+        std::size_t               bytes_last_pump = 0;
+        std::deque<Job>           jobs;
+    };
+}
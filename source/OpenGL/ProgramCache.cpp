@@ -0,0 +1,284 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "ProgramCache.hpp"
+
+#include "Engine/Engine.hpp"
+#include "Engine/Logger.hpp"
+#include "Engine/Path.hpp"
+#include "Engine/Timer.hpp"
+#include "Environment.hpp"
+#include "GL.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+    constexpr std::uint32_t CacheMagic   = 0x42505343; // "CSPB"
+    constexpr std::uint32_t CacheVersion = 1;
+
+    struct CacheFileHeader
+    {
+        std::uint32_t Magic;
+        std::uint32_t Version;
+        std::uint64_t Key;
+        std::uint32_t BinaryFormat;
+        std::uint32_t BinaryLength;
+        double        BuildMilliseconds;
+    };
+
+    OpenGL::ProgramCacheStats gStats{};
+
+    constexpr std::uint64_t FnvOffsetBasis = 14695981039346656037ull;
+    constexpr std::uint64_t FnvPrime       = 1099511628211ull;
+
+    std::uint64_t fnv1a(std::uint64_t hash, std::string_view text) noexcept
+    {
+        for (const char c : text)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= FnvPrime;
+        }
+        // separator so that ("ab","c") and ("a","bc") hash differently
+        hash ^= 0xFF;
+        hash *= FnvPrime;
+        return hash;
+    }
+
+    std::string get_gl_string(GLenum name)
+    {
+        const auto text = GL::GetString(name);
+        return text != nullptr ? std::string(reinterpret_cast<const char*>(text)) : std::string{};
+    }
+
+    const std::string& driver_signature()
+    {
+        static const std::string signature = get_gl_string(GL_VENDOR) + '|' + get_gl_string(GL_RENDERER) + '|' + get_gl_string(GL_VERSION);
+        return signature;
+    }
+
+    std::filesystem::path entry_path(std::uint64_t key)
+    {
+        std::ostringstream name;
+        name << std::hex << std::setw(16) << std::setfill('0') << key << ".glprog";
+        return assets::get_cache_path() / "shaders" / name.str();
+    }
+
+    // checked once, every program built asks
+    bool cache_folder_usable() noexcept
+    {
+        static const bool usable = []() noexcept
+        {
+            try
+            {
+                std::error_code ec;
+                const auto      folder = assets::get_cache_path() / "shaders";
+                std::filesystem::create_directories(folder, ec);
+                return std::filesystem::is_directory(folder, ec);
+            }
+            catch (...)
+            {
+                return false; // no writable per-user or temp folder at all
+            }
+        }();
+        return usable;
+    }
+
+    bool is_supported_format(GLenum format)
+    {
+        static const std::vector<GLint> formats = []()
+        {
+            GLint count = 0;
+            GL::GetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &count);
+            std::vector<GLint> result(static_cast<std::size_t>(std::max(count, 0)));
+            if (!result.empty())
+            {
+                GL::GetIntegerv(GL_PROGRAM_BINARY_FORMATS, result.data());
+            }
+            return result;
+        }();
+        return std::find(formats.begin(), formats.end(), static_cast<GLint>(format)) != formats.end();
+    }
+
+    void reject_entry(const std::filesystem::path& path, std::string_view reason)
+    {
+        ++gStats.Rejected;
+        Engine::GetLogger().LogDebug("Discarding program cache entry " + path.filename().string() + ": " + std::string(reason));
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+}
+
+namespace OpenGL
+{
+    bool IsProgramCacheAvailable() noexcept
+    {
+        if constexpr (IsWebGL)
+        {
+            return false;
+        }
+        else
+        {
+            return SupportsProgramBinary && cache_folder_usable();
+        }
+    }
+
+    std::uint64_t HashProgramSources(std::string_view vertex_source, std::string_view fragment_source)
+    {
+        std::uint64_t hash = FnvOffsetBasis;
+        hash               = fnv1a(hash, vertex_source);
+        hash               = fnv1a(hash, fragment_source);
+        hash               = fnv1a(hash, driver_signature());
+        return hash;
+    }
+
+#if !defined(IS_WEBGL2)
+
+    ShaderHandle LoadCachedProgram(std::uint64_t key)
+    {
+        const auto path = entry_path(key);
+        if (!std::filesystem::exists(path))
+        {
+            return 0;
+        }
+
+        util::Timer   timer;
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return 0;
+        }
+
+        CacheFileHeader header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || header.Magic != CacheMagic || header.Version != CacheVersion || header.Key != key || header.BinaryLength == 0)
+        {
+            reject_entry(path, "bad header");
+            return 0;
+        }
+        if (!is_supported_format(header.BinaryFormat))
+        {
+            reject_entry(path, "binary format not supported by this driver");
+            return 0;
+        }
+
+        std::vector<char> binary(header.BinaryLength);
+        file.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+        if (!file)
+        {
+            reject_entry(path, "truncated");
+            return 0;
+        }
+
+        ShaderHandle program = GL::CreateProgram();
+        GL::ProgramBinary(program, header.BinaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+        GLint is_linked = GL_FALSE;
+        GL::GetProgramiv(program, GL_LINK_STATUS, &is_linked);
+        if (is_linked == GL_FALSE)
+        {
+            GL::DeleteProgram(program);
+            reject_entry(path, "driver refused the binary");
+            return 0;
+        }
+
+        const double load_ms = timer.GetElapsedSeconds() * 1000.0;
+        ++gStats.Hits;
+        gStats.LoadMilliseconds += load_ms;
+        gStats.SavedMilliseconds += std::max(0.0, header.BuildMilliseconds - load_ms);
+
+        std::ostringstream message;
+        message << std::fixed << std::setprecision(2) << "Program cache hit " << path.filename().string() << ": " << load_ms << " ms instead of " << header.BuildMilliseconds << " ms (saved "
+                << gStats.SavedMilliseconds << " ms over " << gStats.Hits << " programs)";
+        Engine::GetLogger().LogEvent(message.str());
+        return program;
+    }
+
+    void MarkProgramRetrievable(ShaderHandle program)
+    {
+        GL::ProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
+    void StoreCachedProgram(std::uint64_t key, ShaderHandle program, double build_milliseconds)
+    {
+        ++gStats.Misses;
+        gStats.BuildMilliseconds += build_milliseconds;
+
+        GLint length = 0;
+        GL::GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+        {
+            return;
+        }
+
+        std::vector<char> binary(static_cast<std::size_t>(length));
+        GLenum            format  = 0;
+        GLsizei           written = 0;
+        GL::GetProgramBinary(program, length, &written, &format, binary.data());
+        if (written <= 0)
+        {
+            return;
+        }
+
+        const auto      path = entry_path(key);
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+
+        // write to a temporary name first so a crash never leaves a half written entry behind
+        auto temp_path = path;
+        temp_path += ".tmp";
+        {
+            std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                Engine::GetLogger().LogDebug("Cannot write program cache entry " + temp_path.string());
+                return;
+            }
+            const CacheFileHeader header{ CacheMagic, CacheVersion, key, format, static_cast<std::uint32_t>(written), build_milliseconds };
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(binary.data(), written);
+            if (!file)
+            {
+                file.close();
+                std::filesystem::remove(temp_path, ec);
+                return;
+            }
+        }
+        std::filesystem::rename(temp_path, path, ec);
+        if (ec)
+        {
+            std::filesystem::remove(temp_path, ec);
+        }
+    }
+
+#else
+
+    ShaderHandle LoadCachedProgram(std::uint64_t)
+    {
+        return 0;
+    }
+
+    void MarkProgramRetrievable(ShaderHandle)
+    {
+    }
+
+    void StoreCachedProgram(std::uint64_t, ShaderHandle, double build_milliseconds)
+    {
+        ++gStats.Misses;
+        gStats.BuildMilliseconds += build_milliseconds;
+    }
+
+#endif
+
+    const ProgramCacheStats& GetProgramCacheStats() noexcept
+    {
+        return gStats;
+    }
+}
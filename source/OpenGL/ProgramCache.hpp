@@ -0,0 +1,94 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Shader.hpp"
+#include <cstdint>
+#include <string_view>
+
+namespace OpenGL
+{
+    /**
+     * \brief Counters describing how well the program binary cache is doing
+     *
+     * Hits are programs restored from disk, Misses are programs that had to be
+     * compiled from GLSL (and were then written to the cache), and Rejected are
+     * cache entries that existed but were refused by the driver or failed
+     * validation, for example after a driver update.
+     *
+     * SavedMilliseconds accumulates, for every hit, the time the original
+     * compile and link took minus the time needed to load the binary. This is
+     * the startup time the cache saved compared to compiling everything.
+     */
+    struct ProgramCacheStats
+    {
+        int    Hits              = 0;
+        int    Misses            = 0;
+        int    Rejected          = 0;
+        double BuildMilliseconds = 0.0;
+        double LoadMilliseconds  = 0.0;
+        double SavedMilliseconds = 0.0;
+    };
+
+    /**
+     * \brief Check whether linked programs can be saved to and restored from disk
+     * \return True when the driver supports program binaries and the cache folder is usable
+     *
+     * Requires OpenGL 4.1 or ARB_get_program_binary with at least one binary
+     * format, and a shaders folder under assets::get_cache_path() that exists
+     * or can be created; the folder is checked on the first call only. WebGL2
+     * has no program binaries, so this is always false there and every
+     * program is compiled from source.
+     */
+    [[nodiscard]] bool IsProgramCacheAvailable() noexcept;
+
+    /**
+     * \brief Compute the cache key of a program from its final GLSL text
+     * \param vertex_source Vertex shader text, after any defines were injected
+     * \param fragment_source Fragment shader text, after any defines were injected
+     * \return 64 bit FNV-1a hash of both sources and the driver vendor, renderer and version strings
+     *
+     * Because defines are part of the text, every permutation gets its own key.
+     * Including the driver strings means a driver update simply misses the cache
+     * instead of handing the new driver a binary it does not understand.
+     */
+    [[nodiscard]] std::uint64_t HashProgramSources(std::string_view vertex_source, std::string_view fragment_source);
+
+    /**
+     * \brief Try to restore a linked program from the on-disk cache
+     * \param key Key from HashProgramSources()
+     * \return Linked program handle, or 0 if there was no usable entry
+     *
+     * Invalid entries (bad header, unsupported binary format, or a binary the
+     * driver refuses to link) are deleted and counted as rejected so the caller
+     * can fall back to compiling from source.
+     */
+    [[nodiscard]] ShaderHandle LoadCachedProgram(std::uint64_t key);
+
+    /**
+     * \brief Ask the driver to keep the program binary retrievable
+     * \param program Program that has not been linked yet
+     *
+     * Must be called before GL::LinkProgram() for StoreCachedProgram() to work.
+     */
+    void MarkProgramRetrievable(ShaderHandle program);
+
+    /**
+     * \brief Save a freshly linked program to the on-disk cache
+     * \param key Key from HashProgramSources()
+     * \param program Successfully linked program
+     * \param build_milliseconds Time the compile and link took, used to report time saved on later hits
+     */
+    void StoreCachedProgram(std::uint64_t key, ShaderHandle program, double build_milliseconds);
+
+    /**
+     * \brief Access the cache counters accumulated since startup
+     * \return Reference to the current statistics
+     */
+    [[nodiscard]] const ProgramCacheStats& GetProgramCacheStats() noexcept;
+}
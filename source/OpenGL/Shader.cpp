@@ -10,15 +10,28 @@
 #include "Engine/Engine.hpp"
 #include "Engine/Logger.hpp"
 #include "Engine/Path.hpp"
+#include "Engine/Timer.hpp"
+#include "Environment.hpp"
 #include "GL.hpp"
+#include "ProgramCache.hpp"
+#include "ShaderSource.hpp"
 #include <algorithm>
+#include <fstream>
+#include <sstream>
 
 namespace
 {
     void                                                 print_glsl_text(std::string_view source);
-    [[nodiscard]] OpenGL::Handle                         compile_shader_source(GLenum type, std::string_view glsl_text);
-    [[nodiscard]] OpenGL::Handle                         compile_shader_file(GLenum type, const std::filesystem::path& file_path);
-    [[nodiscard]] OpenGL::ShaderHandle                   link_shader_program(OpenGL::Handle vertex_handle, OpenGL::Handle fragment_handle);
+    [[nodiscard]] OpenGL::Handle                         start_shader_compile(GLenum type, std::string_view glsl_text);
+    [[nodiscard]] std::string                            get_compile_error(OpenGL::Handle shader);
+    using StageCache = std::unordered_map<std::string, OpenGL::Handle>;
+
+    [[nodiscard]] std::string                            read_shader_file(const std::filesystem::path& file_path);
+    [[nodiscard]] std::string                            inject_defines(std::string_view glsl_text, const std::vector<std::string>& defines);
+    [[nodiscard]] OpenGL::Handle                         acquire_stage(GLenum type, std::string_view glsl_text, StageCache* shared_stages);
+    [[nodiscard]] OpenGL::PendingShader                  begin_program(std::string vertex_text, std::string fragment_text, StageCache* shared_stages = nullptr);
+    [[nodiscard]] OpenGL::CompiledShader                 finish_program(OpenGL::PendingShader& pending);
+    void                                                 release_pending(OpenGL::PendingShader& pending) noexcept;
     [[nodiscard]] std::unordered_map<std::string, GLint> get_uniform_locations(OpenGL::ShaderHandle shader);
 }
 
@@ -26,22 +39,47 @@ namespace OpenGL
 {
     CompiledShader CreateShader(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath)
     {
-        const auto     vertex_handle   = compile_shader_file(GL_VERTEX_SHADER, vertex_filepath);
-        const auto     fragment_handle = compile_shader_file(GL_FRAGMENT_SHADER, fragment_filepath);
-        CompiledShader cs{};
-        cs.Shader           = link_shader_program(vertex_handle, fragment_handle);
-        cs.UniformLocations = get_uniform_locations(cs.Shader);
-        return cs;
+        auto pending = BeginCreateShader(std::move(vertex_filepath), std::move(fragment_filepath));
+        return finish_program(pending);
+    }
+
+    CompiledShader CreateShader(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath, const std::vector<std::string>& defines)
+    {
+        auto pending = BeginCreateShader(std::move(vertex_filepath), std::move(fragment_filepath), defines);
+        return finish_program(pending);
     }
 
     CompiledShader CreateShader(std::string_view vertex_source, std::string_view fragment_source)
     {
-        const auto     vertex_handle   = compile_shader_source(GL_VERTEX_SHADER, vertex_source);
-        const auto     fragment_handle = compile_shader_source(GL_FRAGMENT_SHADER, fragment_source);
-        CompiledShader cs{};
-        cs.Shader           = link_shader_program(vertex_handle, fragment_handle);
-        cs.UniformLocations = get_uniform_locations(cs.Shader);
-        return cs;
+        auto pending = begin_program(std::string(vertex_source), std::string(fragment_source));
+        return finish_program(pending);
+    }
+
+    PendingShader BeginCreateShader(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath)
+    {
+        return begin_program(read_shader_file(vertex_filepath), read_shader_file(fragment_filepath));
+    }
+
+    PendingShader BeginCreateShader(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath, const std::vector<std::string>& defines)
+    {
+        return begin_program(inject_defines(read_shader_file(vertex_filepath), defines), inject_defines(read_shader_file(fragment_filepath), defines));
+    }
+
+    bool IsShaderReady(const PendingShader& pending)
+    {
+        // cache hits are linked already, and without the extension FinishCreateShader simply blocks
+        if (pending.Shader == 0 || pending.VertexShader == 0 || !SupportsParallelShaderCompile)
+        {
+            return true;
+        }
+        GLint is_complete = GL_FALSE;
+        GL::GetProgramiv(pending.Shader, GL_COMPLETION_STATUS_KHR, &is_complete);
+        return is_complete == GL_TRUE;
+    }
+
+    CompiledShader FinishCreateShader(PendingShader& pending)
+    {
+        return finish_program(pending);
     }
 
     void DestroyShader(CompiledShader& shader) noexcept
@@ -65,6 +103,158 @@ namespace OpenGL
             Engine::GetLogger().LogError("Uniform block '" + std::string(uniform_block_name) + "' not found in shader.");
         }
     }
+
+    ShaderVariantCache::~ShaderVariantCache()
+    {
+        Clear();
+    }
+
+    const CompiledShader& ShaderVariantCache::Get(const std::filesystem::path& vertex_filepath, const std::filesystem::path& fragment_filepath, const std::vector<std::string>& defines)
+    {
+        return get(assets::intern_asset(vertex_filepath), assets::intern_asset(fragment_filepath), defines);
+    }
+
+    const CompiledShader& ShaderVariantCache::Get(assets::AssetName vertex, assets::AssetName fragment, const std::vector<std::string>& defines)
+    {
+        return get(assets::intern_asset(vertex), assets::intern_asset(fragment), defines);
+    }
+
+    const CompiledShader* ShaderVariantCache::Request(const std::filesystem::path& vertex_filepath, const std::filesystem::path& fragment_filepath, const std::vector<std::string>& defines)
+    {
+        return request(assets::intern_asset(vertex_filepath), assets::intern_asset(fragment_filepath), defines);
+    }
+
+    const CompiledShader* ShaderVariantCache::Request(assets::AssetName vertex, assets::AssetName fragment, const std::vector<std::string>& defines)
+    {
+        return request(assets::intern_asset(vertex), assets::intern_asset(fragment), defines);
+    }
+
+    void ShaderVariantCache::Update()
+    {
+        for (auto& [key, entry] : programs)
+        {
+            tryFinish(entry);
+        }
+    }
+
+    void ShaderVariantCache::Clear() noexcept
+    {
+        for (auto& [key, entry] : programs)
+        {
+            if (entry.Pending.Shader != 0)
+            {
+                release_pending(entry.Pending);
+            }
+            DestroyShader(entry.Program);
+        }
+        programs.clear();
+        for (const auto& [key, stage] : stages)
+        {
+            GL::DeleteShader(stage);
+        }
+        stages.clear();
+    }
+
+    std::size_t ShaderVariantCache::GetProgramCount() const noexcept
+    {
+        return static_cast<std::size_t>(std::count_if(programs.begin(), programs.end(), [](const auto& pair) { return pair.second.Program.Shader != 0; }));
+    }
+
+    std::size_t ShaderVariantCache::GetPendingCount() const noexcept
+    {
+        return static_cast<std::size_t>(std::count_if(programs.begin(), programs.end(), [](const auto& pair) { return pair.second.Pending.Shader != 0; }));
+    }
+
+    std::size_t ShaderVariantCache::GetStageCount() const noexcept
+    {
+        return stages.size();
+    }
+
+    std::size_t ShaderVariantCache::ProgramKeyHash::operator()(const ProgramKey& key) const noexcept
+    {
+        const std::uint64_t files = (static_cast<std::uint64_t>(key.Vertex.GetIndex()) << 32) | key.Fragment.GetIndex();
+        return std::hash<std::uint64_t>{}(files) ^ (std::hash<std::string>{}(key.Defines) * 31);
+    }
+
+    const CompiledShader& ShaderVariantCache::get(assets::AssetId vertex, assets::AssetId fragment, const std::vector<std::string>& defines)
+    {
+        auto& entry = findOrBegin(vertex, fragment, defines);
+        if (entry.Pending.Shader != 0)
+        {
+            try
+            {
+                entry.Program = FinishCreateShader(entry.Pending);
+            }
+            catch (...)
+            {
+                entry.Failed = true;
+                throw;
+            }
+        }
+        if (entry.Failed)
+        {
+            throw std::runtime_error("Shader variant failed to build: " + assets::asset_key(fragment));
+        }
+        return entry.Program;
+    }
+
+    const CompiledShader* ShaderVariantCache::request(assets::AssetId vertex, assets::AssetId fragment, const std::vector<std::string>& defines)
+    {
+        auto& entry = findOrBegin(vertex, fragment, defines);
+        tryFinish(entry);
+        return entry.Program.Shader != 0 ? &entry.Program : nullptr;
+    }
+
+    ShaderVariantCache::Entry& ShaderVariantCache::findOrBegin(assets::AssetId vertex, assets::AssetId fragment, const std::vector<std::string>& defines)
+    {
+        ProgramKey key{ vertex, fragment, {} };
+        // define order does not change the program, so sort it out of the key
+        auto sorted_defines = defines;
+        if (!sorted_defines.empty())
+        {
+            std::sort(sorted_defines.begin(), sorted_defines.end());
+            for (const auto& define : sorted_defines)
+            {
+                key.Defines += '|';
+                key.Defines += define;
+            }
+        }
+
+        if (const auto found = programs.find(key); found != programs.end())
+        {
+            return found->second;
+        }
+
+        Entry entry{};
+        try
+        {
+            entry.Pending = begin_program(inject_defines(read_shader_file(assets::resolve_asset(vertex)), sorted_defines),
+                                          inject_defines(read_shader_file(assets::resolve_asset(fragment)), sorted_defines), &stages);
+        }
+        catch (const std::exception& e)
+        {
+            Engine::GetLogger().LogError(e.what());
+            entry.Failed = true;
+        }
+        return programs.emplace(std::move(key), std::move(entry)).first->second;
+    }
+
+    void ShaderVariantCache::tryFinish(Entry& entry)
+    {
+        if (entry.Pending.Shader == 0 || !IsShaderReady(entry.Pending))
+        {
+            return;
+        }
+        try
+        {
+            entry.Program = FinishCreateShader(entry.Pending);
+        }
+        catch (const std::exception&)
+        {
+            // the error and the GLSL were already logged, keep the entry so it is not rebuilt every frame
+            entry.Failed = true;
+        }
+    }
 }
 
 namespace
@@ -86,74 +276,204 @@ namespace
         Engine::GetLogger().LogVerbose(sout.str());
     }
 
-    OpenGL::Handle compile_shader_source(GLenum type, std::string_view glsl_text)
+    OpenGL::Handle start_shader_compile(GLenum type, std::string_view glsl_text)
     {
         OpenGL::Handle shader = GL::CreateShader(type);
         GLchar const*  source[]{ glsl_text.data() };
         GL::ShaderSource(shader, 1, source, nullptr);
         GL::CompileShader(shader);
+        return shader;
+    }
+
+    std::string get_compile_error(OpenGL::Handle shader)
+    {
         GLint is_compiled = 0;
         GL::GetShaderiv(shader, GL_COMPILE_STATUS, &is_compiled);
-        if (is_compiled == GL_FALSE)
-        {
-            GLint log_length = 0;
-            GL::GetShaderiv(shader, GL_INFO_LOG_LENGTH, &log_length);
-            std::string error_log;
-            error_log.resize(static_cast<std::string::size_type>(log_length) + 1);
-            GL::GetShaderInfoLog(shader, log_length, nullptr, error_log.data());
-            GL::DeleteShader(shader);
-            shader = 0;
-            Engine::GetLogger().LogError(error_log);
-            print_glsl_text(glsl_text);
-            throw std::runtime_error(error_log);
+        if (is_compiled != GL_FALSE)
+        {
+            return {};
         }
-        return shader;
+        GLint log_length = 0;
+        GL::GetShaderiv(shader, GL_INFO_LOG_LENGTH, &log_length);
+        std::string error_log;
+        error_log.resize(static_cast<std::string::size_type>(log_length) + 1);
+        GL::GetShaderInfoLog(shader, log_length, nullptr, error_log.data());
+        return error_log;
     }
 
-    OpenGL::Handle compile_shader_file(GLenum type, const std::filesystem::path& file_path)
+    std::string read_shader_file(const std::filesystem::path& file_path)
     {
-        const auto    shader_file_path = assets::locate_asset(file_path);
-        std::ifstream ifs(shader_file_path, std::ios::in);
-        if (!ifs)
+        if (assets::is_packed(file_path))
+        {
+            return OpenGL::ExpandShaderIncludes(file_path);
+        }
+
+        const auto shader_file_path = assets::locate_asset(file_path);
+        if (!std::ifstream(shader_file_path, std::ios::in))
         {
             Engine::GetLogger().LogError("Cannot open " + file_path.string());
-            return 0;
+            return {};
         }
-        std::string glsl_text;
-        glsl_text.reserve(gsl::narrow<std::size_t>(std::filesystem::file_size(shader_file_path)));
-        std::copy((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>(), std::back_insert_iterator(glsl_text));
-        return compile_shader_source(type, std::string_view(glsl_text));
+        return OpenGL::ExpandShaderIncludes(shader_file_path);
     }
 
-    OpenGL::ShaderHandle link_shader_program(OpenGL::Handle vertex_handle, OpenGL::Handle fragment_handle)
+    std::string inject_defines(std::string_view glsl_text, const std::vector<std::string>& defines)
     {
-        OpenGL::ShaderHandle program_handle = GL::CreateProgram();
-        if (program_handle == 0)
+        // #version has to stay the first line, so the defines go right after it
+        std::size_t insert_at = 0;
+        if (const auto version = glsl_text.find("#version"); version != std::string_view::npos)
+        {
+            const auto line_end = glsl_text.find('\n', version);
+            insert_at           = (line_end == std::string_view::npos) ? glsl_text.size() : line_end + 1;
+        }
+
+        std::string result;
+        result.reserve(glsl_text.size() + defines.size() * 32);
+        result.append(glsl_text.substr(0, insert_at));
+        if (insert_at == glsl_text.size() && insert_at > 0 && glsl_text.back() != '\n')
+        {
+            result += '\n';
+        }
+        for (const auto& define : defines)
         {
+            result += "#define ";
+            result += define;
+            result += '\n';
+        }
+        result.append(glsl_text.substr(insert_at));
+        return result;
+    }
+
+    OpenGL::Handle acquire_stage(GLenum type, std::string_view glsl_text, StageCache* shared_stages)
+    {
+        if (shared_stages == nullptr)
+        {
+            return start_shader_compile(type, glsl_text);
+        }
+        std::string key = (type == GL_VERTEX_SHADER) ? "vert:" : "frag:";
+        key += glsl_text;
+        if (const auto found = shared_stages->find(key); found != shared_stages->end())
+        {
+            return found->second;
+        }
+        const auto stage = start_shader_compile(type, glsl_text);
+        shared_stages->emplace(std::move(key), stage);
+        return stage;
+    }
+
+    OpenGL::PendingShader begin_program(std::string vertex_text, std::string fragment_text, StageCache* shared_stages)
+    {
+        OpenGL::PendingShader pending{};
+
+        // the key is computed from the final text, so injected defines give each permutation its own entry
+        pending.Cacheable = OpenGL::IsProgramCacheAvailable();
+        if (pending.Cacheable)
+        {
+            pending.CacheKey = OpenGL::HashProgramSources(vertex_text, fragment_text);
+            if (const auto program = OpenGL::LoadCachedProgram(pending.CacheKey); program != 0)
+            {
+                pending.Shader = program;
+                return pending;
+            }
+        }
+
+        // no status queries here, they would wait for the driver and defeat parallel compilation
+        pending.BuildTimer.ResetTimeStamp();
+        pending.OwnsStages     = shared_stages == nullptr;
+        pending.VertexShader   = acquire_stage(GL_VERTEX_SHADER, vertex_text, shared_stages);
+        pending.FragmentShader = acquire_stage(GL_FRAGMENT_SHADER, fragment_text, shared_stages);
+        pending.Shader         = GL::CreateProgram();
+        if (pending.Shader == 0)
+        {
+            release_pending(pending);
             throw std::runtime_error("Unable to create program\n");
         }
+        if (pending.Cacheable)
+        {
+            OpenGL::MarkProgramRetrievable(pending.Shader);
+        }
+        GL::AttachShader(pending.Shader, pending.VertexShader);
+        GL::AttachShader(pending.Shader, pending.FragmentShader);
+        GL::LinkProgram(pending.Shader);
 
-        GL::AttachShader(program_handle, vertex_handle);
-        GL::AttachShader(program_handle, fragment_handle);
+        pending.VertexText   = std::move(vertex_text);
+        pending.FragmentText = std::move(fragment_text);
+        return pending;
+    }
 
-        GL::LinkProgram(program_handle);
+    OpenGL::CompiledShader finish_program(OpenGL::PendingShader& pending)
+    {
+        if (pending.Shader == 0)
+        {
+            throw std::runtime_error("No shader program is being created");
+        }
 
-        GL::DeleteShader(vertex_handle);
-        GL::DeleteShader(fragment_handle);
+        if (pending.VertexShader != 0)
+        {
+            const std::pair<OpenGL::Handle, const std::string*> stages[] = {
+                { pending.VertexShader, &pending.VertexText },
+                { pending.FragmentShader, &pending.FragmentText }
+            };
+            for (const auto& [stage, text] : stages)
+            {
+                if (const auto error_log = get_compile_error(stage); !error_log.empty())
+                {
+                    Engine::GetLogger().LogError(error_log);
+                    print_glsl_text(*text);
+                    release_pending(pending);
+                    throw std::runtime_error(error_log);
+                }
+            }
+
+            GLint is_linked = 0;
+            GL::GetProgramiv(pending.Shader, GL_LINK_STATUS, &is_linked);
+            if (is_linked == GL_FALSE)
+            {
+                GLint log_length = 0;
+                GL::GetProgramiv(pending.Shader, GL_INFO_LOG_LENGTH, &log_length);
+                std::string error;
+                error.resize(static_cast<unsigned>(log_length) + 1);
+                GL::GetProgramInfoLog(pending.Shader, log_length, nullptr, error.data());
+                Engine::GetLogger().LogError(error);
+                release_pending(pending);
+                throw std::runtime_error(error);
+            }
 
-        GLint is_linked = 0;
-        GL::GetProgramiv(program_handle, GL_LINK_STATUS, &is_linked);
-        if (is_linked == GL_FALSE)
+            if (pending.OwnsStages)
+            {
+                GL::DeleteShader(pending.VertexShader);
+                GL::DeleteShader(pending.FragmentShader);
+            }
+            else
+            {
+                // shared stages stay alive in their cache, the program no longer needs them attached
+                GL::DetachShader(pending.Shader, pending.VertexShader);
+                GL::DetachShader(pending.Shader, pending.FragmentShader);
+            }
+            pending.VertexShader   = 0;
+            pending.FragmentShader = 0;
+            if (pending.Cacheable)
+            {
+                OpenGL::StoreCachedProgram(pending.CacheKey, pending.Shader, pending.BuildTimer.GetElapsedSeconds() * 1000.0);
+            }
+        }
+
+        OpenGL::CompiledShader cs{};
+        cs.Shader           = pending.Shader;
+        cs.UniformLocations = get_uniform_locations(cs.Shader);
+        pending             = OpenGL::PendingShader{};
+        return cs;
+    }
+
+    void release_pending(OpenGL::PendingShader& pending) noexcept
+    {
+        if (pending.OwnsStages)
         {
-            GLint log_length = 0;
-            GL::GetProgramiv(program_handle, GL_INFO_LOG_LENGTH, &log_length);
-            std::string error;
-            error.resize(static_cast<unsigned>(log_length) + 1);
-            GL::GetProgramInfoLog(program_handle, log_length, nullptr, error.data());
-            Engine::GetLogger().LogError(error);
-            throw std::runtime_error(error);
+            GL::DeleteShader(pending.VertexShader);
+            GL::DeleteShader(pending.FragmentShader);
         }
-        return program_handle;
+        GL::DeleteProgram(pending.Shader);
+        pending = OpenGL::PendingShader{};
     }
 
     std::unordered_map<std::string, GLint> get_uniform_locations(OpenGL::ShaderHandle shader)
@@ -7,12 +7,16 @@
  */
 #pragma once
 
+#include "Engine/AssetRegistry.hpp"
+#include "Engine/Timer.hpp"
 #include "Handle.hpp"
+#include <cstdint>
 #include <filesystem>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace OpenGL
 {
@@ -63,6 +67,34 @@ namespace OpenGL
         std::unordered_map<std::string, GLint> UniformLocations;
     };
 
+    /**
+     * \brief Shader program whose compile and link were started but not yet checked
+     *
+     * Returned by BeginCreateShader(). The GLSL has been handed to the driver and
+     * the program link requested, but no status has been queried yet, because
+     * any status query makes the driver finish that work on the spot. Keeping
+     * the queries back lets drivers with KHR_parallel_shader_compile build
+     * several programs at the same time on their own threads.
+     *
+     * Programs restored from the binary cache come back already linked, with
+     * no stage objects to check.
+     *
+     * Treat the members as private to the shader module. Pass the object to
+     * IsShaderReady() and FinishCreateShader().
+     */
+    struct [[nodiscard]] PendingShader
+    {
+        ShaderHandle  Shader         = 0;
+        Handle        VertexShader   = 0;
+        Handle        FragmentShader = 0;
+        std::string   VertexText;
+        std::string   FragmentText;
+        std::uint64_t CacheKey   = 0;
+        bool          Cacheable  = false;
+        bool          OwnsStages = true;
+        util::Timer   BuildTimer;
+    };
+
     /**
      * \brief Create shader program from vertex and fragment shader files
      * \param vertex_filepath Path to the vertex shader source file (.vert)
@@ -76,6 +108,7 @@ namespace OpenGL
      *
      * The compilation process includes:
      * - Loading shader source code from the specified files
+     * - Expanding `#include "file"` directives (see ShaderVariantCache)
      * - Compiling vertex and fragment shaders separately
      * - Linking both shaders into a complete program
      * - Extracting and caching all uniform locations for fast access
@@ -97,6 +130,23 @@ namespace OpenGL
      */
     CompiledShader CreateShader(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath);
 
+    /**
+     * \brief Create shader program from shader files with preprocessor defines injected
+     * \param vertex_filepath Path to the vertex shader source file (.vert)
+     * \param fragment_filepath Path to the fragment shader source file (.frag)
+     * \param defines Macros to define, each either "NAME" or "NAME VALUE"
+     * \return Fully compiled shader program with cached uniform locations
+     *
+     * Same as the file-based overload, but every entry of defines is emitted as a
+     * `#define` line directly after the `#version` directive of both stages. This
+     * lets a single source file with `#ifdef` blocks produce several specialized
+     * programs (permutations) without branching on uniforms at runtime.
+     *
+     * Each call compiles a new program, so callers that switch permutations
+     * often should cache the results keyed by their define set.
+     */
+    CompiledShader CreateShader(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath, const std::vector<std::string>& defines);
+
     /**
      * \brief Create shader program from vertex and fragment shader source strings
      * \param vertex_source Complete GLSL source code for the vertex shader
@@ -130,6 +180,50 @@ namespace OpenGL
      */
     CompiledShader CreateShader(std::string_view vertex_source, std::string_view fragment_source);
 
+    /**
+     * \brief Start building a shader program without waiting for the driver
+     * \param vertex_filepath Path to the vertex shader source file (.vert)
+     * \param fragment_filepath Path to the fragment shader source file (.frag)
+     * \return Handle to the in-flight build, to be passed to FinishCreateShader()
+     *
+     * Submits both stages for compilation and requests the link, then returns
+     * immediately. Start every program a game state needs first, then poll
+     * IsShaderReady() each frame, so that all the programs compile together
+     * instead of one after another.
+     */
+    PendingShader BeginCreateShader(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath);
+
+    /**
+     * \brief Start building a shader program with preprocessor defines injected
+     * \param vertex_filepath Path to the vertex shader source file (.vert)
+     * \param fragment_filepath Path to the fragment shader source file (.frag)
+     * \param defines Macros to define, each either "NAME" or "NAME VALUE"
+     * \return Handle to the in-flight build, to be passed to FinishCreateShader()
+     */
+    PendingShader BeginCreateShader(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath, const std::vector<std::string>& defines);
+
+    /**
+     * \brief Check without blocking whether a pending program has finished building
+     * \param pending Build started with BeginCreateShader()
+     * \return True when FinishCreateShader() will not stall
+     *
+     * Uses GL_COMPLETION_STATUS_KHR when the driver supports parallel shader
+     * compilation. Without the extension this always returns true, and
+     * FinishCreateShader() does the work synchronously as CreateShader() would.
+     */
+    [[nodiscard]] bool IsShaderReady(const PendingShader& pending);
+
+    /**
+     * \brief Check a pending build and turn it into a usable shader program
+     * \param pending Build started with BeginCreateShader(), reset to empty afterwards
+     * \return Fully compiled shader program with cached uniform locations
+     *
+     * Compile and link errors are reported here, the same way CreateShader()
+     * reports them, and an exception is thrown. Uniform locations are looked
+     * up only now, because querying them earlier would wait for the link.
+     */
+    CompiledShader FinishCreateShader(PendingShader& pending);
+
     /**
      * \brief Safely destroy shader program and release all associated resources
      * \param shader Compiled shader structure to destroy (will be reset to safe state)
@@ -192,4 +286,105 @@ namespace OpenGL
      * access the same uniform buffer data, enabling true data sharing.
      */
     void BindUniformBufferToShader(ShaderHandle shader_handle, GLuint binding_number, Handle uniform_bufer, std::string_view uniform_block_name);
+
+    /**
+     * \brief Owns every program variant built from a set of shader files and defines
+     *
+     * Shader files loaded through this module may use `#include "file"`. The
+     * include is looked up next to the including file first and then through
+     * assets::locate_asset(), and each file is pasted in at most once. Defines
+     * are injected as a generated block right after `#version`. That makes it
+     * cheap to compile specialized, branch-free variants of one source instead
+     * of switching on a uniform inside the fragment shader.
+     *
+     * Programs are cached per (vertex file, fragment file, define set) key, with
+     * the define order ignored. Files are keyed by their interned
+     * assets::AssetId, so the AssetName overloads, fed by the _asset literal,
+     * find a cached program without building or hashing any path string. Compiled stage objects are cached by their final
+     * GLSL text and shared between programs, so a vertex shader used by several
+     * programs (such as a fullscreen triangle) is compiled only once.
+     *
+     * Get() builds synchronously and throws on errors. Request() and Update()
+     * use the asynchronous path: Request() starts the build and returns nullptr
+     * until the program is ready. Variants that fail to build are logged once
+     * and then stay unavailable instead of being rebuilt every frame.
+     *
+     * The cache owns its programs. Pointers and references it hands out stay
+     * valid until Clear() or destruction.
+     */
+    class ShaderVariantCache
+    {
+    public:
+        ShaderVariantCache() = default;
+        ~ShaderVariantCache();
+
+        ShaderVariantCache(const ShaderVariantCache&)            = delete;
+        ShaderVariantCache& operator=(const ShaderVariantCache&) = delete;
+        ShaderVariantCache(ShaderVariantCache&&)                 = delete;
+        ShaderVariantCache& operator=(ShaderVariantCache&&)      = delete;
+
+        /**
+         * \brief Get a variant, building it right away if needed
+         * \param vertex_filepath Path to the vertex shader source file
+         * \param fragment_filepath Path to the fragment shader source file
+         * \param defines Macros to define, each either "NAME" or "NAME VALUE"
+         * \return The compiled program, owned by the cache
+         */
+        const CompiledShader& Get(const std::filesystem::path& vertex_filepath, const std::filesystem::path& fragment_filepath, const std::vector<std::string>& defines = {});
+        const CompiledShader& Get(assets::AssetName vertex, assets::AssetName fragment, const std::vector<std::string>& defines = {});
+
+        /**
+         * \brief Get a variant if it is ready, starting an asynchronous build otherwise
+         * \param vertex_filepath Path to the vertex shader source file
+         * \param fragment_filepath Path to the fragment shader source file
+         * \param defines Macros to define, each either "NAME" or "NAME VALUE"
+         * \return The compiled program, or nullptr while it is building or if it failed
+         */
+        [[nodiscard]] const CompiledShader* Request(const std::filesystem::path& vertex_filepath, const std::filesystem::path& fragment_filepath, const std::vector<std::string>& defines = {});
+        [[nodiscard]] const CompiledShader* Request(assets::AssetName vertex, assets::AssetName fragment, const std::vector<std::string>& defines = {});
+
+        /**
+         * \brief Finish every pending build the driver has completed, without blocking
+         */
+        void Update();
+
+        /**
+         * \brief Destroy all programs and shared stage objects
+         */
+        void Clear() noexcept;
+
+        [[nodiscard]] std::size_t GetProgramCount() const noexcept;
+        [[nodiscard]] std::size_t GetPendingCount() const noexcept;
+        [[nodiscard]] std::size_t GetStageCount() const noexcept;
+
+    private:
+        struct Entry
+        {
+            CompiledShader Program{};
+            PendingShader  Pending{};
+            bool           Failed = false;
+        };
+
+        struct ProgramKey
+        {
+            assets::AssetId Vertex;
+            assets::AssetId Fragment;
+            std::string     Defines; // sorted and joined, empty for the plain program
+
+            bool operator==(const ProgramKey&) const = default;
+        };
+
+        struct ProgramKeyHash
+        {
+            std::size_t operator()(const ProgramKey& key) const noexcept;
+        };
+
+        const CompiledShader& get(assets::AssetId vertex, assets::AssetId fragment, const std::vector<std::string>& defines);
+        const CompiledShader* request(assets::AssetId vertex, assets::AssetId fragment, const std::vector<std::string>& defines);
+        Entry&                findOrBegin(assets::AssetId vertex, assets::AssetId fragment, const std::vector<std::string>& defines);
+        void                  tryFinish(Entry& entry);
+
+        std::unordered_map<ProgramKey, Entry, ProgramKeyHash> programs;
+        std::unordered_map<std::string, Handle>               stages;
+    };
 }
@@ -0,0 +1,98 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "ShaderSource.hpp"
+
+#include "Engine/AssetPack.hpp"
+#include "Engine/Path.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    void expand_includes(const fs::path& file_path, const fs::path& assets_parent, std::string& output, std::vector<fs::path>& included, int depth)
+    {
+        constexpr int max_include_depth = 16;
+        if (depth > max_include_depth)
+        {
+            throw std::runtime_error("#include nested too deeply in " + file_path.string());
+        }
+
+        // every file is included at most once, which also stops include cycles
+        const auto packed         = assets::find_packed(file_path);
+        const auto canonical_path = packed ? fs::path(assets::pack_key(file_path)) : fs::weakly_canonical(file_path);
+        if (std::find(included.begin(), included.end(), canonical_path) != included.end())
+        {
+            return;
+        }
+        included.push_back(canonical_path);
+
+        std::istringstream packed_text;
+        std::ifstream      loose_file;
+        if (packed)
+        {
+            packed_text.str(std::string(reinterpret_cast<const char*>(packed->data()), packed->size()));
+        }
+        else
+        {
+            loose_file.open(file_path, std::ios::in);
+            if (!loose_file)
+            {
+                throw std::runtime_error("Cannot open shader include " + file_path.string());
+            }
+        }
+        std::istream& ifs = packed ? static_cast<std::istream&>(packed_text) : loose_file;
+
+        std::string line;
+        while (std::getline(ifs, line))
+        {
+            const auto first = line.find_first_not_of(" \t");
+            if (first == std::string::npos || line.compare(first, 8, "#include") != 0)
+            {
+                output += line;
+                output += '\n';
+                continue;
+            }
+
+            const auto open  = line.find_first_of("\"<", first + 8);
+            const auto close = (open == std::string::npos) ? std::string::npos : line.find_first_of("\">", open + 1);
+            if (close == std::string::npos)
+            {
+                throw std::runtime_error("Malformed #include in " + file_path.string() + ": " + line);
+            }
+            const fs::path include_name = line.substr(open + 1, close - open - 1);
+
+            auto include_path = file_path.parent_path() / include_name;
+            if (!assets::is_packed(include_path) && !fs::exists(include_path))
+            {
+                // the base path is only looked for here, a game running from a pack may have no Assets folder at all
+                include_path = assets::is_packed(include_name) ? include_name : (assets_parent.empty() ? assets::get_base_path() : assets_parent) / include_name;
+                if (!assets::is_packed(include_path) && !fs::exists(include_path))
+                {
+                    throw std::runtime_error("Cannot find #include " + include_name.string() + " from " + file_path.string());
+                }
+            }
+            expand_includes(include_path, assets_parent, output, included, depth + 1);
+        }
+    }
+}
+
+namespace OpenGL
+{
+    std::string ExpandShaderIncludes(const std::filesystem::path& file_path, const std::filesystem::path& assets_parent)
+    {
+        std::string           glsl_text;
+        std::vector<fs::path> included;
+        expand_includes(file_path, assets_parent, glsl_text, included, 0);
+        return glsl_text;
+    }
+}
@@ -0,0 +1,30 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+namespace OpenGL
+{
+    /**
+     * \brief Read a shader file with its `#include "file"` directives pasted in
+     * \param file_path Shader to read, a packed asset or a loose file
+     * \param assets_parent Folder holding Assets, empty for assets::get_base_path()
+     * \return The expanded GLSL text
+     * \throw std::runtime_error if a file cannot be read, an include is malformed or missing, or includes nest more than 16 deep
+     *
+     * An include is looked up next to the including file first, then in the
+     * mounted asset pack, then below assets_parent. Every file is pasted in at
+     * most once, which also stops include cycles.
+     *
+     * Needs no OpenGL context, so the runtime shader loader and the offline
+     * cooker share it and always resolve an include to the same file.
+     */
+    [[nodiscard]] std::string ExpandShaderIncludes(const std::filesystem::path& file_path, const std::filesystem::path& assets_parent = {});
+}
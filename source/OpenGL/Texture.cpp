@@ -10,6 +10,159 @@
 #include "CS200/Image.hpp"
 #include "Environment.hpp"
 #include "GL.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    struct UploadFormat
+    {
+        GLint  InternalFormat;
+        GLenum Format;
+        GLenum Type;
+    };
+
+    // from_texels: filled from RGBA texels, so R8 and RG8 have to sample like the RGBA they came from
+    UploadFormat upload_format(OpenGL::TextureFormat format, [[maybe_unused]] bool from_texels) noexcept
+    {
+        switch (format)
+        {
+            case OpenGL::TextureFormat::R8:
+#if defined(__EMSCRIPTEN__)
+                // no swizzle in WebGL2, the legacy format samples as (L, L, L, A) by itself
+                if (from_texels)
+                {
+                    return { GL_LUMINANCE_ALPHA, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE };
+                }
+#endif
+                return { GL_R8, GL_RED, GL_UNSIGNED_BYTE };
+            case OpenGL::TextureFormat::RG8:
+#if defined(__EMSCRIPTEN__)
+                if (from_texels)
+                {
+                    return { GL_LUMINANCE_ALPHA, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE };
+                }
+#endif
+                return { GL_RG8, GL_RG, GL_UNSIGNED_BYTE };
+            case OpenGL::TextureFormat::RGB565: return { GL_RGB565, GL_RGB, GL_UNSIGNED_SHORT_5_6_5 };
+            case OpenGL::TextureFormat::RGBA4444: return { GL_RGBA4, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4 };
+            case OpenGL::TextureFormat::RGB10_A2: return { GL_RGB10_A2, GL_RGBA, GL_UNSIGNED_INT_2_10_10_10_REV };
+            case OpenGL::TextureFormat::R11F_G11F_B10F: return { GL_R11F_G11F_B10F, GL_RGB, GL_FLOAT };
+            case OpenGL::TextureFormat::RGBA8: break;
+        }
+        return { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE };
+    }
+
+    // 8 bit channel to n bits, rounded
+    constexpr std::uint32_t narrow(std::uint8_t value, std::uint32_t bits) noexcept
+    {
+        const std::uint32_t top = (1u << bits) - 1u;
+        return (static_cast<std::uint32_t>(value) * top + 127u) / 255u;
+    }
+
+    template <typename T>
+    void append(std::vector<std::uint8_t>& bytes, T value)
+    {
+        const auto at = bytes.size();
+        bytes.resize(at + sizeof(T));
+        std::memcpy(bytes.data() + at, &value, sizeof(T)); // packed types are read in native byte order
+    }
+
+    std::vector<std::uint8_t> convert_texels(std::span<const CS200::RGBA> colors, OpenGL::TextureFormat format)
+    {
+        std::vector<std::uint8_t> bytes;
+        bytes.reserve(colors.size() * 4);
+        // images hold their channels in R, G, B, A byte order
+        const auto* channels = reinterpret_cast<const std::uint8_t*>(colors.data());
+        for (std::size_t i = 0; i < colors.size(); ++i)
+        {
+            const std::uint8_t r = channels[i * 4 + 0];
+            const std::uint8_t g = channels[i * 4 + 1];
+            const std::uint8_t b = channels[i * 4 + 2];
+            const std::uint8_t a = channels[i * 4 + 3];
+            switch (format)
+            {
+                case OpenGL::TextureFormat::R8:
+#if defined(__EMSCRIPTEN__)
+                    bytes.push_back(255);
+#endif
+                    bytes.push_back(a);
+                    break;
+                case OpenGL::TextureFormat::RG8:
+                    bytes.push_back(static_cast<std::uint8_t>((static_cast<unsigned>(r) + g + b + 1u) / 3u));
+                    bytes.push_back(a);
+                    break;
+                case OpenGL::TextureFormat::RGB565: append(bytes, static_cast<std::uint16_t>((narrow(r, 5) << 11) | (narrow(g, 6) << 5) | narrow(b, 5))); break;
+                case OpenGL::TextureFormat::RGBA4444:
+                    append(bytes, static_cast<std::uint16_t>((narrow(r, 4) << 12) | (narrow(g, 4) << 8) | (narrow(b, 4) << 4) | narrow(a, 4)));
+                    break;
+                case OpenGL::TextureFormat::RGB10_A2: append(bytes, (narrow(a, 2) << 30) | (narrow(b, 10) << 20) | (narrow(g, 10) << 10) | narrow(r, 10)); break;
+                case OpenGL::TextureFormat::R11F_G11F_B10F:
+                    append(bytes, static_cast<float>(r) / 255.0f);
+                    append(bytes, static_cast<float>(g) / 255.0f);
+                    append(bytes, static_cast<float>(b) / 255.0f);
+                    break;
+                case OpenGL::TextureFormat::RGBA8:
+                    bytes.insert(bytes.end(), { r, g, b, a });
+                    break;
+            }
+        }
+        return bytes;
+    }
+
+    OpenGL::TextureHandle create_texture(Math::ivec2 size, OpenGL::TextureFormat format, const void* texels, OpenGL::Filtering filtering, OpenGL::Wrapping wrapping) noexcept
+    {
+        const auto upload = upload_format(format, texels != nullptr);
+
+        OpenGL::TextureHandle handle{};
+        GL::GenTextures(1, &handle);
+        GL::BindTexture(GL_TEXTURE_2D, handle);
+        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(filtering));
+        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, OpenGL::MagnificationFilter(filtering));
+        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, static_cast<GLint>(wrapping));
+        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, static_cast<GLint>(wrapping));
+#if !defined(__EMSCRIPTEN__)
+        if (texels != nullptr && format == OpenGL::TextureFormat::R8)
+        {
+            // white, with the stored value as alpha
+            GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_ONE);
+            GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_ONE);
+            GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_ONE);
+            GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_RED);
+        }
+        else if (texels != nullptr && format == OpenGL::TextureFormat::RG8)
+        {
+            // luminance in red, alpha in green
+            GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_RED);
+            GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_RED);
+            GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+            GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_GREEN);
+        }
+#endif
+
+        // rows of 1, 2 and 3 byte texels are not 4 byte aligned in general
+        const bool unaligned = (static_cast<std::size_t>(size.x) * OpenGL::BytesPerTexel(format)) % 4 != 0;
+        if (unaligned)
+        {
+            GL::PixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        }
+        GL::TexImage2D(GL_TEXTURE_2D, 0, upload.InternalFormat, size.x, size.y, 0, upload.Format, upload.Type, texels);
+        if (unaligned)
+        {
+            GL::PixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        }
+
+        // glGenerateMipmap needs a color renderable format, which the float one only is with EXT_color_buffer_float
+        if (texels != nullptr && OpenGL::UsesMipmaps(filtering) && format != OpenGL::TextureFormat::R11F_G11F_B10F)
+        {
+            GL::GenerateMipmap(GL_TEXTURE_2D);
+        }
+        GL::BindTexture(GL_TEXTURE_2D, 0);
+        return handle;
+    }
+}
 
 namespace OpenGL
 {
@@ -30,7 +183,7 @@ namespace OpenGL
         GL::BindTexture(GL_TEXTURE_2D, handle);
 
         GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(filtering));
-        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, static_cast<GLint>(filtering));
+        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, MagnificationFilter(filtering));
 
 
         GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, static_cast<GLint>(wrapping));
@@ -49,6 +202,12 @@ namespace OpenGL
                        GL_UNSIGNED_BYTE,     // data type (check your RGBA definition)
                        colors.data());       // pointer to pixel data
 
+        // a mipmapped min filter on a texture without its smaller levels samples black
+        if (UsesMipmaps(filtering))
+        {
+            GL::GenerateMipmap(GL_TEXTURE_2D);
+        }
+
         // Unbind
         GL::BindTexture(GL_TEXTURE_2D, 0);
 
@@ -72,11 +231,107 @@ namespace OpenGL
         return texture_handle;
     }
 
+    TextureHandle CreateTextureFromMemory(Math::ivec2 size, std::span<const CS200::RGBA> colors, TextureFormat format, Filtering filtering, Wrapping wrapping) noexcept
+    {
+        if (format == TextureFormat::RGBA8)
+        {
+            return CreateTextureFromMemory(size, colors, filtering, wrapping);
+        }
+        const auto texels = convert_texels(colors, format);
+        return create_texture(size, format, texels.data(), filtering, wrapping);
+    }
+
+    TextureHandle CreateTexture(Math::ivec2 size, TextureFormat format, Filtering filtering, Wrapping wrapping) noexcept
+    {
+        return create_texture(size, format, nullptr, filtering, wrapping);
+    }
+
+    TextureFormat ChooseMaskFormat(std::span<const CS200::RGBA> colors) noexcept
+    {
+        constexpr int white_floor = 240; // the odd off-white texel from an antialiased export still counts
+        constexpr int gray_spread = 2;
+        bool          all_white   = true;
+        const auto*   channels    = reinterpret_cast<const std::uint8_t*>(colors.data());
+        for (std::size_t i = 0; i < colors.size(); ++i)
+        {
+            const int r = channels[i * 4 + 0];
+            const int g = channels[i * 4 + 1];
+            const int b = channels[i * 4 + 2];
+            const int a = channels[i * 4 + 3];
+            if (a == 0)
+            {
+                continue;
+            }
+            // judged by how far off the texel is once blended, so faint edge texels may stray further than solid ones
+            const int lowest = std::min({ r, g, b });
+            if ((255 - lowest) * a / 255 <= 255 - white_floor)
+            {
+                continue; // near white counts as white, whatever its tint
+            }
+            if ((std::max({ r, g, b }) - lowest) * a / 255 > gray_spread)
+            {
+                return TextureFormat::RGBA8;
+            }
+            all_white = false;
+        }
+        return all_white ? TextureFormat::R8 : TextureFormat::RG8;
+    }
+
+    bool IsCompressedFormatSupported(GLenum internal_format) noexcept
+    {
+        static const std::vector<GLint> formats = []
+        {
+            GLint count = 0;
+            GL::GetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count);
+            std::vector<GLint> result(static_cast<std::size_t>(std::max(count, 0)));
+            if (!result.empty())
+            {
+                GL::GetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, result.data());
+            }
+            return result;
+        }();
+        return std::find(formats.begin(), formats.end(), static_cast<GLint>(internal_format)) != formats.end();
+    }
+
+    TextureHandle CreateCompressedTexture(Math::ivec2 size, GLenum internal_format, std::span<const std::uint8_t> blocks, Filtering filtering, Wrapping wrapping) noexcept
+    {
+        const std::array<std::span<const std::uint8_t>, 1> level_zero{ blocks };
+        return CreateCompressedTexture(size, internal_format, level_zero, filtering, wrapping);
+    }
+
+    TextureHandle CreateCompressedTexture(Math::ivec2 size, GLenum internal_format, std::span<const std::span<const std::uint8_t>> levels, Filtering filtering, Wrapping wrapping) noexcept
+    {
+        TextureHandle handle{};
+        GL::GenTextures(1, &handle);
+        GL::BindTexture(GL_TEXTURE_2D, handle);
+        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(filtering));
+        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, MagnificationFilter(filtering));
+        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, static_cast<GLint>(wrapping));
+        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, static_cast<GLint>(wrapping));
+        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levels.size()) - 1);
+        Math::ivec2 level_size = size;
+        for (std::size_t level = 0; level < levels.size(); ++level)
+        {
+            GL::CompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), internal_format, level_size.x, level_size.y, 0, static_cast<GLsizei>(levels[level].size()),
+                                     levels[level].data());
+            level_size = { std::max(level_size.x / 2, 1), std::max(level_size.y / 2, 1) };
+        }
+        GL::BindTexture(GL_TEXTURE_2D, 0);
+        return handle;
+    }
+
+    void GenerateMipmaps(TextureHandle texture_handle) noexcept
+    {
+        GL::BindTexture(GL_TEXTURE_2D, texture_handle);
+        GL::GenerateMipmap(GL_TEXTURE_2D);
+        GL::BindTexture(GL_TEXTURE_2D, 0);
+    }
+
     void SetFiltering(TextureHandle texture_handle, Filtering filtering) noexcept
     {
         GL::BindTexture(GL_TEXTURE_2D, texture_handle);
         GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(filtering));
-        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, static_cast<GLint>(filtering));
+        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, MagnificationFilter(filtering));
         GL::BindTexture(GL_TEXTURE_2D, 0);
     }
 
@@ -12,6 +12,8 @@
 #include "GLConstants.hpp"
 #include "GLTypes.hpp"
 #include "Handle.hpp"
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <span>
 
@@ -41,13 +43,56 @@ namespace OpenGL
      * Performance considerations:
      * - NearestPixel: Faster sampling, lower memory bandwidth
      * - Linear: More expensive sampling, higher memory bandwidth
+     *
+     * Minified textures:
+     * Without mipmaps a texture drawn at a quarter of its size still reads
+     * texels spread over its full resolution, which thrashes the texture cache
+     * and shimmers as it moves. The mipmapped modes sample a prebuilt half,
+     * quarter, ... size copy instead. They only apply to minification; when
+     * magnified they behave like Linear. A texture needs its mip chain before
+     * a mipmapped mode is set, see GenerateMipmaps().
+     * - LinearMipmapNearest: Bilinear in the closest mip level, visible steps where levels change
+     * - Trilinear: Blends the two closest mip levels, smooth at every scale
      */
     enum class Filtering : GLint
     {
-        NearestPixel = GL_NEAREST, ///< Sharp pixelated sampling, ideal for pixel art and crisp graphics
-        Linear       = GL_LINEAR   ///< Smooth interpolated sampling, ideal for photographs and realistic textures
+        NearestPixel        = GL_NEAREST,                ///< Sharp pixelated sampling, ideal for pixel art and crisp graphics
+        Linear              = GL_LINEAR,                 ///< Smooth interpolated sampling, ideal for photographs and realistic textures
+        LinearMipmapNearest = GL_LINEAR_MIPMAP_NEAREST,  ///< Bilinear sampling of the closest mip level when minified
+        Trilinear           = GL_LINEAR_MIPMAP_LINEAR    ///< Bilinear sampling of the two closest mip levels, blended
     };
 
+    /**
+     * \brief Whether a filtering mode reads mip levels below level 0
+     */
+    [[nodiscard]] constexpr bool UsesMipmaps(Filtering filtering) noexcept
+    {
+        return filtering == Filtering::LinearMipmapNearest || filtering == Filtering::Trilinear;
+    }
+
+    /**
+     * \brief The GL_TEXTURE_MAG_FILTER value for a filtering mode, mipmapped modes are invalid there
+     */
+    [[nodiscard]] constexpr GLint MagnificationFilter(Filtering filtering) noexcept
+    {
+        return UsesMipmaps(filtering) ? GL_LINEAR : static_cast<GLint>(filtering);
+    }
+
+    /**
+     * \brief Number of levels in a full mip chain, level 0 included, down to 1x1
+     */
+    [[nodiscard]] constexpr int MipLevelCount(Math::ivec2 size) noexcept
+    {
+        int levels  = 1;
+        int largest = size.x > size.y ? size.x : size.y;
+        while (largest > 1)
+        {
+            largest /= 2;
+            ++levels;
+        }
+        return levels;
+    }
+
     /**
      * \brief Texture wrapping modes for controlling behavior outside texture boundaries
      *
@@ -80,6 +125,81 @@ namespace OpenGL
      */
     using TextureHandle = Handle;
 
+    /**
+     * \brief Storage formats a texture can be created with, smaller ones for images that do not need RGBA8
+     *
+     * Filling one from RGBA texels with CreateTextureFromMemory() keeps what
+     * shaders see the same, only the precision drops:
+     * - R8: coverage masks and simple fonts. Stores alpha only, texels sample as white with that alpha. 1 byte.
+     * - RG8: gray images with alpha, such as outlined fonts. Samples as (L, L, L, A). 2 bytes.
+     * - RGB565: opaque color, 5-6-5 bits. 2 bytes.
+     * - RGBA4444: color with simple alpha, 4 bits per channel. 2 bytes.
+     * - RGB10_A2: 10 bits per color channel, 2 bit alpha. 4 bytes.
+     * - R11F_G11F_B10F: small unsigned floats for HDR color without alpha. 4 bytes.
+     *
+     * R8 and RG8 reach that through the texture swizzle, so the fragment
+     * shaders keep reading .rgba. WebGL2 has no texture swizzle; there both
+     * are stored as LUMINANCE_ALPHA instead, which samples the same way at 2
+     * bytes per texel. Empty textures from CreateTexture() are never swizzled.
+     */
+    enum class TextureFormat
+    {
+        RGBA8,
+        R8,
+        RG8,
+        RGB565,
+        RGBA4444,
+        RGB10_A2,
+        R11F_G11F_B10F
+    };
+
+    /**
+     * \brief Video memory per texel of a format as this platform stores it
+     */
+    [[nodiscard]] constexpr std::size_t BytesPerTexel(TextureFormat format) noexcept
+    {
+        switch (format)
+        {
+#if defined(__EMSCRIPTEN__)
+            case TextureFormat::R8: return 2; // LUMINANCE_ALPHA
+#else
+            case TextureFormat::R8: return 1;
+#endif
+            case TextureFormat::RG8:
+            case TextureFormat::RGB565:
+            case TextureFormat::RGBA4444: return 2;
+            case TextureFormat::RGBA8:
+            case TextureFormat::RGB10_A2:
+            case TextureFormat::R11F_G11F_B10F: return 4;
+        }
+        return 4;
+    }
+
+    [[nodiscard]] constexpr const char* GetFormatName(TextureFormat format) noexcept
+    {
+        switch (format)
+        {
+            case TextureFormat::RGBA8: return "RGBA8";
+            case TextureFormat::R8: return "R8";
+            case TextureFormat::RG8: return "RG8";
+            case TextureFormat::RGB565: return "RGB565";
+            case TextureFormat::RGBA4444: return "RGBA4444";
+            case TextureFormat::RGB10_A2: return "RGB10_A2";
+            case TextureFormat::R11F_G11F_B10F: return "R11F_G11F_B10F";
+        }
+        return "?";
+    }
+
+    /**
+     * \brief The smallest of R8, RG8 and RGBA8 that holds a mask or font image without visible loss
+     * \param colors Texels of the image
+     *
+     * R8 when every visible texel is (close to) white, RG8 when every one is
+     * gray, RGBA8 otherwise. Fully transparent texels do not count, and the
+     * closer a texel is to transparent the more tint it may have.
+     */
+    [[nodiscard]] TextureFormat ChooseMaskFormat(std::span<const CS200::RGBA> colors) noexcept;
+
     /**
      * \brief Create OpenGL texture from loaded image data
      * \param image Image object containing loaded pixel data and dimensions
@@ -127,6 +247,9 @@ namespace OpenGL
      * - Data is interpreted in row-major order (left-to-right, top-to-bottom)
      * - Each pixel is a packed 32-bit RGBA value
      *
+     * With a mipmapped filtering mode the mip chain is generated on the GPU
+     * right after the upload.
+     *
      * Common use cases:
      * - Procedurally generated textures (noise, patterns, gradients)
      * - Runtime texture modification and updates
@@ -175,6 +298,80 @@ namespace OpenGL
      */
     [[nodiscard]] TextureHandle CreateRGBATexture(Math::ivec2 size, Filtering filtering = Filtering::NearestPixel, Wrapping wrapping = Wrapping::Repeat) noexcept;
 
+    /**
+     * \brief Create a texture in a smaller format from RGBA texels
+     * \param size Texture dimensions in pixels
+     * \param colors size.x * size.y RGBA texels, converted on the CPU before the upload
+     * \param format Storage format, see TextureFormat for what each keeps
+     * \param filtering Texture sampling method, mipmapped modes generate the chain after the upload
+     * \param wrapping Texture coordinate wrapping behavior
+     * \return Handle to the created OpenGL texture object
+     */
+    [[nodiscard]] TextureHandle CreateTextureFromMemory(Math::ivec2 size, std::span<const CS200::RGBA> colors, TextureFormat format, Filtering filtering = Filtering::NearestPixel,
+                                                        Wrapping wrapping = Wrapping::Repeat) noexcept;
+
+    /**
+     * \brief Create an empty texture of any format, for render targets and data written later
+     * \param size Texture dimensions in pixels
+     * \param format Storage format, channels are sampled as stored
+     * \param filtering Texture sampling method
+     * \param wrapping Texture coordinate wrapping behavior
+     *
+     * RGB10_A2 and R11F_G11F_B10F targets keep more precision than RGBA8 at
+     * the same size. Rendering into R11F_G11F_B10F needs
+     * EXT_color_buffer_float on OpenGL ES and WebGL2.
+     */
+    [[nodiscard]] TextureHandle CreateTexture(Math::ivec2 size, TextureFormat format, Filtering filtering = Filtering::NearestPixel, Wrapping wrapping = Wrapping::Repeat) noexcept;
+
+    /**
+     * \brief Whether the driver lists a compressed internal format in GL_COMPRESSED_TEXTURE_FORMATS
+     * \param internal_format For example GL_COMPRESSED_RGBA8_ETC2_EAC
+     *
+     * The list is queried once and cached, so this is cheap to call per load.
+     */
+    [[nodiscard]] bool IsCompressedFormatSupported(GLenum internal_format) noexcept;
+
+    /**
+     * \brief Create a texture from already compressed blocks
+     * \param size Texture dimensions in pixels
+     * \param internal_format Compressed format of the blocks, see IsCompressedFormatSupported()
+     * \param blocks The compressed data for mip level 0, rows of blocks bottom first
+     * \param filtering Texture sampling method (default: nearest pixel)
+     * \param wrapping Texture coordinate wrapping behavior (default: repeat)
+     * \return Handle to the created OpenGL texture object
+     *
+     * The GPU samples the blocks directly, so the texture takes the compressed
+     * size in video memory and in bandwidth, not width * height * 4.
+     */
+    [[nodiscard]] TextureHandle CreateCompressedTexture(Math::ivec2 size, GLenum internal_format, std::span<const std::uint8_t> blocks, Filtering filtering = Filtering::NearestPixel,
+                                                        Wrapping wrapping = Wrapping::Repeat) noexcept;
+
+    /**
+     * \brief Create a compressed texture with a mip chain cooked offline
+     * \param size Texture dimensions of level 0 in pixels
+     * \param internal_format Compressed format of the blocks
+     * \param levels Blocks of level 0, 1, 2, ... each half the size of the one before
+     * \param filtering Texture sampling method, a mipmapped mode only pays off with more than one level
+     * \param wrapping Texture coordinate wrapping behavior
+     *
+     * glGenerateMipmap cannot write compressed formats, so compressed textures
+     * get their smaller levels from the file. GL_TEXTURE_MAX_LEVEL is set to
+     * the last level given, which keeps a partial chain, or a single level
+     * with a mipmapped filtering mode, complete and sampleable.
+     */
+    [[nodiscard]] TextureHandle CreateCompressedTexture(Math::ivec2 size, GLenum internal_format, std::span<const std::span<const std::uint8_t>> levels,
+                                                        Filtering filtering = Filtering::NearestPixel, Wrapping wrapping = Wrapping::Repeat) noexcept;
+
+    /**
+     * \brief Fill mip levels 1 and below of an RGBA8 texture from its level 0 on the GPU
+     * \param texture_handle Texture with level 0 uploaded
+     *
+     * Each level is a filtered half of the one above, down to 1x1, adding a
+     * third to the texture's memory. Call it again after changing level 0.
+     * Not available for compressed textures.
+     */
+    void GenerateMipmaps(TextureHandle texture_handle) noexcept;
+
     /**
      * \brief Update texture filtering mode after creation
      * \param texture_handle Handle to the texture object to modify
@@ -187,7 +384,8 @@ namespace OpenGL
      *
      * The filtering setting affects both magnification and minification,
      * determining how the texture appears when scaled larger or smaller
-     * than its native resolution.
+     * than its native resolution. Mipmapped modes set linear magnification
+     * and expect the mip chain to exist already.
      *
      * Common scenarios:
      * - Switching between pixel art and smooth rendering modes
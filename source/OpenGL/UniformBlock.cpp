@@ -0,0 +1,156 @@
+/**
+ * \file
+ * \author JUNSEOK LEE
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "UniformBlock.hpp"
+
+#include "Engine/Engine.hpp"
+#include "Engine/Logger.hpp"
+#include "GL.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace OpenGL
+{
+    UniformBlockLayout ReflectUniformBlock(ShaderHandle shader, std::string_view block_name)
+    {
+        UniformBlockLayout layout{};
+        layout.Index = GL::GetUniformBlockIndex(shader, std::string(block_name).c_str());
+        if (layout.Index == GL_INVALID_INDEX)
+        {
+            return layout;
+        }
+
+        GL::GetActiveUniformBlockiv(shader, layout.Index, GL_UNIFORM_BLOCK_DATA_SIZE, &layout.DataSize);
+        GLint member_count = 0;
+        GL::GetActiveUniformBlockiv(shader, layout.Index, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &member_count);
+        if (member_count <= 0)
+        {
+            return layout;
+        }
+
+        std::vector<GLint> member_indices(static_cast<std::size_t>(member_count));
+        GL::GetActiveUniformBlockiv(shader, layout.Index, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, member_indices.data());
+        std::vector<GLuint> indices(member_indices.begin(), member_indices.end());
+        std::vector<GLint>  offsets(indices.size());
+        GL::GetActiveUniformsiv(shader, member_count, indices.data(), GL_UNIFORM_OFFSET, offsets.data());
+
+        GLint max_name_length = 0;
+        GL::GetProgramiv(shader, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_name_length);
+        std::string name;
+        for (std::size_t i = 0; i < indices.size(); ++i)
+        {
+            name.resize(static_cast<std::size_t>(max_name_length));
+            GLsizei length = 0;
+            GLint   size   = 0;
+            GLenum  type   = 0;
+            GL::GetActiveUniform(shader, indices[i], max_name_length, &length, &size, &type, name.data());
+            name.resize(static_cast<std::size_t>(length));
+            layout.Offsets[name] = offsets[i];
+        }
+        return layout;
+    }
+
+    bool ValidateUniformBlock(const UniformBlockLayout& layout, std::string_view block_name, std::size_t cpp_size, std::initializer_list<std::pair<std::string_view, std::size_t>> members)
+    {
+        bool               valid = true;
+        std::ostringstream errors;
+        if (static_cast<std::size_t>(layout.DataSize) > cpp_size)
+        {
+            errors << "\n  block needs " << layout.DataSize << " bytes but the C++ struct has " << cpp_size;
+            valid = false;
+        }
+        for (const auto& [member, cpp_offset] : members)
+        {
+            const auto found = layout.Offsets.find(std::string(member));
+            if (found == layout.Offsets.end())
+            {
+                continue;
+            }
+            if (static_cast<std::size_t>(found->second) != cpp_offset)
+            {
+                errors << "\n  " << member << " is at offset " << found->second << " in GLSL but " << cpp_offset << " in C++";
+                valid = false;
+            }
+        }
+        if (!valid)
+        {
+            Engine::GetLogger().LogError("Uniform block '" + std::string(block_name) + "' does not match its C++ struct:" + errors.str());
+        }
+        return valid;
+    }
+
+    bool SetUniformBlockBinding(ShaderHandle shader, std::string_view block_name, GLuint binding_number)
+    {
+        const auto block_index = GL::GetUniformBlockIndex(shader, std::string(block_name).c_str());
+        if (block_index == GL_INVALID_INDEX)
+        {
+            return false;
+        }
+        GL::UniformBlockBinding(shader, block_index, binding_number);
+        return true;
+    }
+
+    UniformRingBuffer::~UniformRingBuffer()
+    {
+        Destroy();
+    }
+
+    void UniformRingBuffer::Create(GLsizeiptr capacity_in_bytes)
+    {
+        Destroy();
+        GL::GetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        alignment = std::max(alignment, 1);
+        capacity  = capacity_in_bytes;
+        head      = 0;
+
+        GL::GenBuffers(1, &buffer);
+        GL::BindBuffer(GL_UNIFORM_BUFFER, buffer);
+        GL::BufferData(GL_UNIFORM_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+        GL::BindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    void UniformRingBuffer::Destroy() noexcept
+    {
+        if (buffer != 0)
+        {
+            GL::DeleteBuffers(1, &buffer);
+            buffer = 0;
+        }
+        capacity = 0;
+        head     = 0;
+    }
+
+    UniformRingBuffer::Range UniformRingBuffer::Write(const void* data, GLsizeiptr size_in_bytes)
+    {
+        if (size_in_bytes > capacity)
+        {
+            throw std::runtime_error("UniformRingBuffer::Write larger than the whole ring");
+        }
+
+        GL::BindBuffer(GL_UNIFORM_BUFFER, buffer);
+        GLintptr offset = (head + alignment - 1) / alignment * alignment;
+        if (offset + size_in_bytes > capacity)
+        {
+            // wrap around on fresh storage so draws still reading the old contents are not stalled
+            GL::BufferData(GL_UNIFORM_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+            offset = 0;
+        }
+        GL::BufferSubData(GL_UNIFORM_BUFFER, offset, size_in_bytes, data);
+        GL::BindBuffer(GL_UNIFORM_BUFFER, 0);
+
+        head = offset + size_in_bytes;
+        return Range{ offset, size_in_bytes };
+    }
+
+    void UniformRingBuffer::BindRange(GLuint binding_number, Range range) const
+    {
+        GL::BindBufferRange(GL_UNIFORM_BUFFER, binding_number, buffer, range.Offset, range.Size);
+    }
+}
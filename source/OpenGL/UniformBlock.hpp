@@ -0,0 +1,136 @@
+/**
+ * \file
+ * \author JUNSEOK LEE
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Buffer.hpp"
+#include "Shader.hpp"
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace OpenGL
+{
+    /**
+     * \brief Layout of one uniform block as the driver laid it out in a program
+     *
+     * Filled by ReflectUniformBlock() from glGetActiveUniformBlockiv and
+     * glGetActiveUniformsiv(GL_UNIFORM_OFFSET). For std140 blocks the offsets
+     * are fixed by the rules of the layout, so a matching C++ struct can be
+     * written once and uploaded as raw bytes. The reflection is there to catch
+     * the C++ struct and the GLSL block drifting apart.
+     */
+    struct UniformBlockLayout
+    {
+        GLuint                                 Index    = GL_INVALID_INDEX;
+        GLint                                  DataSize = 0;
+        std::unordered_map<std::string, GLint> Offsets;
+    };
+
+    /**
+     * \brief Query the layout of a named uniform block
+     * \param shader Linked program that declares the block
+     * \param block_name Name of the block in GLSL
+     * \return Layout with Index == GL_INVALID_INDEX if the program has no such active block
+     */
+    [[nodiscard]] UniformBlockLayout ReflectUniformBlock(ShaderHandle shader, std::string_view block_name);
+
+    /**
+     * \brief Check that a C++ struct matches the layout the driver reports for a block
+     * \param layout Result of ReflectUniformBlock()
+     * \param block_name Block name, only used for error messages
+     * \param cpp_size sizeof the C++ struct
+     * \param members Pairs of GLSL member name and offsetof in the C++ struct
+     * \return True if every active member sits at the expected offset and the struct is large enough
+     *
+     * Members the compiler optimized away are not reported by the driver and
+     * are skipped. Mismatches are logged as errors.
+     */
+    bool ValidateUniformBlock(const UniformBlockLayout& layout, std::string_view block_name, std::size_t cpp_size, std::initializer_list<std::pair<std::string_view, std::size_t>> members);
+
+    /**
+     * \brief Point a program's uniform block at a binding index without touching any buffer
+     * \param shader Linked program
+     * \param block_name Name of the block in GLSL
+     * \param binding_number Binding index shared by every program using this block
+     * \return False if the program has no active block with that name
+     *
+     * Unlike BindUniformBufferToShader() this only sets up the program side, so
+     * the buffer range can be bound separately each frame, for example from a
+     * UniformRingBuffer.
+     */
+    bool SetUniformBlockBinding(ShaderHandle shader, std::string_view block_name, GLuint binding_number);
+
+    /**
+     * \brief Streaming uniform buffer that hands out a fresh aligned range for every write
+     *
+     * Per-frame, per-view and per-pass data is written once into the next free
+     * slice of one large buffer and then bound with glBindBufferRange. Every
+     * program using the block reads the same copy, instead of each program
+     * getting its own glUniform calls.
+     *
+     * Slices start on GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT. When the buffer is
+     * full, writing wraps to the start and orphans the storage with
+     * glBufferData(nullptr), so the driver never has to wait for draws that
+     * still read the older data.
+     *
+     * Create() and Destroy() need a current OpenGL context.
+     */
+    class UniformRingBuffer
+    {
+    public:
+        struct Range
+        {
+            GLintptr   Offset = 0;
+            GLsizeiptr Size   = 0;
+        };
+
+        UniformRingBuffer() = default;
+        ~UniformRingBuffer();
+
+        UniformRingBuffer(const UniformRingBuffer&)            = delete;
+        UniformRingBuffer& operator=(const UniformRingBuffer&) = delete;
+
+        void Create(GLsizeiptr capacity_in_bytes);
+        void Destroy() noexcept;
+
+        /**
+         * \brief Copy bytes into the next free aligned slice
+         * \param data Bytes to upload
+         * \param size_in_bytes Number of bytes, must not exceed the capacity
+         * \return Range to pass to BindRange()
+         */
+        Range Write(const void* data, GLsizeiptr size_in_bytes);
+
+        template <typename Block>
+        Range Write(const Block& block)
+        {
+            static_assert(std::is_trivially_copyable_v<Block>, "uniform blocks are uploaded as raw bytes");
+            return Write(&block, static_cast<GLsizeiptr>(sizeof(Block)));
+        }
+
+        /**
+         * \brief Bind a slice returned by Write() to a uniform block binding index
+         */
+        void BindRange(GLuint binding_number, Range range) const;
+
+        [[nodiscard]] BufferHandle GetHandle() const noexcept
+        {
+            return buffer;
+        }
+
+    private:
+        BufferHandle buffer    = 0;
+        GLsizeiptr   capacity  = 0;
+        GLintptr     head      = 0;
+        GLint        alignment = 256;
+    };
+}
@@ -0,0 +1,146 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ *
+ * Packs an Assets folder into the single memory mapped file that
+ * assets::mount_default_pack() looks for.
+ *
+ *     cs200_pack_assets [--store] Assets build/assets.pak
+ *
+ * Every file becomes an entry named "Assets/<path inside the folder>", the
+ * same names the game asks for. Shaders and other text are zlib compressed
+ * when that saves at least an eighth; png, jpg and ktx2 files are compressed
+ * already and stored as is, so the engine decodes them straight from the
+ * mapping. --store turns compression off for every file.
+ */
+
+#include "Engine/AssetPack.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <gsl/gsl>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// the compressor of stb_image_write, built into the_stb_write; declared here because stb only declares it in its implementation section
+extern "C" unsigned char* stbi_zlib_compress(unsigned char* data, int data_len, int* out_len, int quality);
+
+namespace
+{
+    std::vector<std::uint8_t> read_file(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            throw std::runtime_error("cannot read " + path.string());
+        }
+        std::vector<std::uint8_t> bytes(gsl::narrow<std::size_t>(std::filesystem::file_size(path)));
+        file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return bytes;
+    }
+
+    bool is_precompressed(const std::filesystem::path& path)
+    {
+        auto extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".ktx2";
+    }
+
+    assets::PackSource make_source(const std::filesystem::path& path, std::string key, bool allow_compression)
+    {
+        assets::PackSource source;
+        source.Key           = std::move(key);
+        source.Stored        = read_file(path);
+        source.OriginalBytes = source.Stored.size();
+        if (!allow_compression || is_precompressed(path) || source.Stored.empty())
+        {
+            return source;
+        }
+
+        constexpr int  quality          = 8;
+        int            compressed_bytes = 0;
+        unsigned char* compressed       = stbi_zlib_compress(source.Stored.data(), static_cast<int>(source.Stored.size()), &compressed_bytes, quality);
+        if (compressed != nullptr && static_cast<std::size_t>(compressed_bytes) <= source.Stored.size() - source.Stored.size() / 8)
+        {
+            source.Stored.assign(compressed, compressed + compressed_bytes);
+            source.Compressed = true;
+        }
+        std::free(compressed);
+        return source;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    bool                     allow_compression = true;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--store")
+        {
+            allow_compression = false;
+        }
+        else
+        {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.size() != 2)
+    {
+        std::cerr << "usage: cs200_pack_assets [--store] Assets assets.pak\n";
+        return EXIT_FAILURE;
+    }
+
+    namespace fs = std::filesystem;
+    const fs::path assets_folder = paths[0];
+    const fs::path pack_path     = paths[1];
+    try
+    {
+        std::vector<assets::PackSource> sources;
+        std::size_t                     original_total   = 0;
+        std::size_t                     stored_total     = 0;
+        std::size_t                     compressed_count = 0;
+        for (const auto& entry : fs::recursive_directory_iterator(assets_folder))
+        {
+            if (!entry.is_regular_file())
+            {
+                continue;
+            }
+            auto key    = "Assets/" + fs::relative(entry.path(), assets_folder).generic_string();
+            auto source = make_source(entry.path(), std::move(key), allow_compression);
+            original_total += source.OriginalBytes;
+            stored_total += source.Stored.size();
+            compressed_count += source.Compressed ? 1 : 0;
+            sources.push_back(std::move(source));
+        }
+
+        const auto file_count = sources.size();
+        if (!assets::AssetPack::Write(pack_path, std::move(sources)))
+        {
+            throw std::runtime_error("cannot write " + pack_path.string());
+        }
+
+        // open it the way the game will, which also validates the index
+        const auto pack = assets::AssetPack::Open(pack_path);
+        std::cout << std::fixed << std::setprecision(2) << pack_path.string() << ": " << file_count << " files, " << compressed_count << " compressed, "
+                  << static_cast<double>(original_total) / 1048576.0 << " MiB -> " << static_cast<double>(stored_total) / 1048576.0 << " MiB of data, "
+                  << static_cast<double>(pack->GetMappedBytes()) / 1048576.0 << " MiB file\n";
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
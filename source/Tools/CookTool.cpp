@@ -0,0 +1,524 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ *
+ * Offline asset cooker: does ahead of time the preparation the game
+ * otherwise does while loading.
+ *
+ *     cs200_cook [--compress] [--mips] [--premultiply] [--jobs N] [--force] Assets build/cooked
+ *
+ * Mirrors the Assets folder into build/cooked/Assets and adds, per asset:
+ *
+ * - images: a .ctex next to the png, decoded RGBA8 already flipped bottom
+ *   row first, which TextureManager uploads without decoding. --premultiply
+ *   stores premultiplied colors instead, for renderers blending with GL_ONE;
+ *   the engine blends straight alpha and ignores those. --compress also
+ *   writes the ETC2 .ktx2 that cs200_compress_textures makes, --mips with
+ *   its mip chain.
+ * - fonts, the images under Assets/fonts: the .fontmetrics glyph table
+ *   CS230::Font would scan for, and the .sdffont atlas of CS230::SdfFont.
+ * - shaders: #include directives expanded, comments and indentation dropped
+ *   but every line kept, so compiler errors keep their line numbers, then
+ *   checked for a leading #version, a main() and balanced brackets.
+ *   Real compilation still needs a GL context and happens in the game.
+ * - anything else: copied as is.
+ *
+ * Sidecars already in the source folder (.ctex, .ktx2, .fontmetrics,
+ * .sdffont) are not copied, the cooker makes its own.
+ *
+ * build/cooked/cook_manifest.txt records a content hash per asset (for
+ * shaders the expanded source, so editing an include recooks its users)
+ * together with the options used. Assets whose hash matches and whose
+ * outputs exist are skipped; --force cooks everything. Assets are cooked on
+ * --jobs threads, every core by default.
+ *
+ * Run the game from build/cooked, or pack the result with
+ * cs200_pack_assets build/cooked/Assets assets.pak.
+ */
+
+#include "CS200/CookedTexture.hpp"
+#include "CS200/Etc2.hpp"
+#include "CS200/Image.hpp"
+#include "CS200/ImageProcessing.hpp"
+#include "CS200/Ktx2.hpp"
+#include "CS200/MipChain.hpp"
+#include "CS200/SdfFontAtlas.hpp"
+#include "Engine/AssetPack.hpp"
+#include "Engine/Path.hpp"
+#include "OpenGL/ShaderSource.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    constexpr std::uint64_t CookVersion = 6; // bump when an output format changes, recooks everything
+
+    enum class AssetKind
+    {
+        Copy,
+        Texture,
+        Font,
+        Shader
+    };
+
+    struct Options
+    {
+        bool Compress    = false;
+        bool Mips        = false;
+        bool Premultiply = false;
+        bool Force       = false;
+
+        [[nodiscard]] std::uint64_t Bits() const noexcept
+        {
+            return (CookVersion << 8) | (Compress ? 1u : 0u) | (Mips ? 2u : 0u) | (Premultiply ? 4u : 0u);
+        }
+    };
+
+    struct Item
+    {
+        fs::path    Source;
+        std::string Key; ///< "Assets/..." like the game asks for it, see assets::pack_key()
+        AssetKind   Kind = AssetKind::Copy;
+    };
+
+    struct Result
+    {
+        std::uint64_t Hash     = 0;
+        bool          UpToDate = false;
+        std::string   Note;
+        std::string   Error;
+    };
+
+    std::string lower_extension(const fs::path& path)
+    {
+        auto extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension;
+    }
+
+    std::string read_text(const fs::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            throw std::runtime_error("cannot read " + path.string());
+        }
+        std::ostringstream text;
+        text << file.rdbuf();
+        return text.str();
+    }
+
+    void write_text(const fs::path& path, const std::string& text)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(text.data(), static_cast<std::streamsize>(text.size()));
+        if (!file)
+        {
+            throw std::runtime_error("cannot write " + path.string());
+        }
+    }
+
+    // same FNV-1a as the pack index, over file contents here
+    std::uint64_t content_hash(std::string_view bytes, const Options& options)
+    {
+        return assets::hash_pack_key(bytes) ^ (options.Bits() * 0x9E3779B97F4A7C15ull);
+    }
+
+    std::vector<fs::path> outputs_for(const Item& item, const fs::path& target, const Options& options)
+    {
+        std::vector<fs::path> outputs{ target };
+        const auto            sidecar = [&](const char* extension) { return fs::path(target).replace_extension(extension); };
+        if (item.Kind == AssetKind::Texture)
+        {
+            outputs.push_back(sidecar(".ctex"));
+            if (options.Compress)
+            {
+                outputs.push_back(sidecar(".ktx2"));
+            }
+        }
+        else if (item.Kind == AssetKind::Font)
+        {
+            outputs.push_back(sidecar(".fontmetrics"));
+            outputs.push_back(sidecar(".sdffont"));
+        }
+        return outputs;
+    }
+
+    // --- shaders ---------------------------------------------------------
+
+    // every newline is kept, blank or not, so a GL compile error points at the same line as in the expanded source
+    std::string strip_comments(std::string_view glsl)
+    {
+        std::string result;
+        result.reserve(glsl.size());
+        std::string line;
+        const auto  end_line = [&]
+        {
+            if (const auto first = line.find_first_not_of(" \t\r"); first != std::string::npos)
+            {
+                result.append(line, first, line.find_last_not_of(" \t\r") - first + 1);
+            }
+            result += '\n';
+            line.clear();
+        };
+
+        bool in_block = false;
+        for (std::size_t i = 0; i < glsl.size(); ++i)
+        {
+            const char c    = glsl[i];
+            const char next = i + 1 < glsl.size() ? glsl[i + 1] : '\0';
+            if (in_block)
+            {
+                if (c == '*' && next == '/')
+                {
+                    in_block = false;
+                    line += ' ';
+                    ++i;
+                }
+                else if (c == '\n')
+                {
+                    end_line();
+                }
+            }
+            else if (c == '/' && next == '*')
+            {
+                in_block = true;
+                ++i;
+            }
+            else if (c == '/' && next == '/')
+            {
+                while (i + 1 < glsl.size() && glsl[i + 1] != '\n')
+                {
+                    ++i;
+                }
+            }
+            else if (c == '\n')
+            {
+                end_line();
+            }
+            else
+            {
+                line += c;
+            }
+        }
+        if (!line.empty())
+        {
+            end_line();
+        }
+        return result;
+    }
+
+    void validate_shader(std::string_view glsl, bool is_stage)
+    {
+        if (is_stage && !glsl.starts_with("#version"))
+        {
+            throw std::runtime_error("#version must come first");
+        }
+        if (is_stage && glsl.find("void main") == std::string_view::npos)
+        {
+            throw std::runtime_error("no main()");
+        }
+
+        std::string open_brackets;
+        int         line_number = 1;
+        for (const char c : glsl)
+        {
+            if (c == '\n')
+            {
+                ++line_number;
+            }
+            else if (c == '(' || c == '{' || c == '[')
+            {
+                open_brackets += c;
+            }
+            else if (c == ')' || c == '}' || c == ']')
+            {
+                const char expected = c == ')' ? '(' : (c == '}' ? '{' : '[');
+                if (open_brackets.empty() || open_brackets.back() != expected)
+                {
+                    throw std::runtime_error(std::string("unbalanced '") + c + "' on cooked line " + std::to_string(line_number));
+                }
+                open_brackets.pop_back();
+            }
+        }
+        if (!open_brackets.empty())
+        {
+            throw std::runtime_error(std::string("unclosed '") + open_brackets.back() + "'");
+        }
+    }
+
+    // --- cooking -----------------------------------------------------------
+
+    Result cook(const Item& item, const fs::path& target, const fs::path& assets_parent, const Options& options, const std::unordered_map<std::string, std::uint64_t>& manifest)
+    {
+        Result result;
+        try
+        {
+            const auto extension = lower_extension(item.Source);
+            const bool is_stage  = extension == ".vert" || extension == ".frag";
+
+            // shaders are hashed expanded, so editing an include recooks every shader using it
+            const auto source = item.Kind == AssetKind::Shader ? OpenGL::ExpandShaderIncludes(item.Source, assets_parent) : read_text(item.Source);
+            result.Hash = content_hash(source, options);
+
+            const auto outputs = outputs_for(item, target, options);
+            if (const auto found = manifest.find(item.Key); !options.Force && found != manifest.end() && found->second == result.Hash &&
+                                                          std::all_of(outputs.begin(), outputs.end(), [](const fs::path& output) { return fs::exists(output); }))
+            {
+                result.UpToDate = true;
+                return result;
+            }
+
+            fs::create_directories(target.parent_path());
+            const auto source_hash = assets::hash_asset(item.Source).value_or(0);
+            switch (item.Kind)
+            {
+                case AssetKind::Copy: fs::copy_file(item.Source, target, fs::copy_options::overwrite_existing); break;
+
+                case AssetKind::Shader:
+                {
+                    const auto cooked = strip_comments(source);
+                    validate_shader(cooked, is_stage);
+                    write_text(target, cooked);
+                    result.Note = std::to_string(source.size()) + " -> " + std::to_string(cooked.size()) + " bytes";
+                    break;
+                }
+
+                case AssetKind::Font:
+                {
+                    fs::copy_file(item.Source, target, fs::copy_options::overwrite_existing);
+                    const CS200::Image       image(item.Source);
+                    std::vector<Math::irect> rects(CS200::FontGlyphCount);
+                    CS200::ScanGlyphRects(image, rects);
+                    const auto atlas = CS200::GenerateSdfFontAtlas(image, rects, CS200::DefaultSdfSpread);
+                    if (!CS200::WriteGlyphMetrics(outputs[1], rects, source_hash) || !CS200::WriteSdfFontAtlas(outputs[2], atlas, source_hash))
+                    {
+                        throw std::runtime_error("cannot write the font tables");
+                    }
+                    result.Note = std::to_string(CS200::FontGlyphCount) + " glyphs, sdf " + std::to_string(atlas.Size.x) + "x" + std::to_string(atlas.Size.y);
+                    break;
+                }
+
+                case AssetKind::Texture:
+                {
+                    fs::copy_file(item.Source, target, fs::copy_options::overwrite_existing);
+                    // bottom row first, the order the textures are uploaded in
+                    constexpr bool     flip_image = true;
+                    const CS200::Image image(item.Source, flip_image);
+                    const auto         size        = image.GetSize();
+                    const auto         texel_count = static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y);
+                    const std::span<const CS200::RGBA> texels(image.data(), texel_count);
+
+                    CS200::CookedTexture cooked{ size, source_hash, options.Premultiply, std::vector<CS200::RGBA>(texels.begin(), texels.end()) };
+                    if (options.Premultiply)
+                    {
+                        CS200::ImageProcessing::PremultiplyAlpha(cooked.Texels);
+                    }
+                    if (!CS200::WriteCookedTexture(outputs[1], cooked))
+                    {
+                        throw std::runtime_error("cannot write " + outputs[1].string());
+                    }
+                    result.Note = std::to_string(size.x) + "x" + std::to_string(size.y) + (options.Premultiply ? " premultiplied" : "");
+
+                    if (options.Compress)
+                    {
+                        // straight alpha, TextureManager uploads .ktx2 files as they are
+                        CS200::Ktx2Texture compressed;
+                        compressed.Format      = CS200::HasTranslucentTexels(image) ? CS200::Etc2Format::RGBA8 : CS200::Etc2Format::RGB8;
+                        compressed.Size        = size;
+                        compressed.SourceHash  = source_hash;
+                        compressed.Data        = CS200::EncodeEtc2(image, compressed.Format);
+                        if (options.Mips)
+                        {
+                            for (const auto& level : CS200::BuildMipChain(texels, size))
+                            {
+                                compressed.MipLevels.push_back(CS200::EncodeEtc2(level.Texels, level.Size, compressed.Format));
+                            }
+                        }
+                        if (!CS200::WriteKtx2(outputs[2], compressed))
+                        {
+                            throw std::runtime_error("cannot write " + outputs[2].string());
+                        }
+                        result.Note += compressed.Format == CS200::Etc2Format::RGB8 ? ", ETC2 RGB8" : ", ETC2 RGBA8";
+                    }
+                    break;
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            result.Error = e.what();
+        }
+        return result;
+    }
+
+    std::unordered_map<std::string, std::uint64_t> read_manifest(const fs::path& path)
+    {
+        std::unordered_map<std::string, std::uint64_t> manifest;
+        std::ifstream                                   file(path);
+        std::string                                     line;
+        while (std::getline(file, line))
+        {
+            const auto space = line.find(' ');
+            if (space == std::string::npos)
+            {
+                continue;
+            }
+            manifest[line.substr(space + 1)] = std::stoull(line.substr(0, space), nullptr, 16);
+        }
+        return manifest;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options                  options;
+    unsigned                 jobs = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--compress")
+        {
+            options.Compress = true;
+        }
+        else if (arg == "--mips")
+        {
+            options.Mips = true;
+        }
+        else if (arg == "--premultiply")
+        {
+            options.Premultiply = true;
+        }
+        else if (arg == "--force")
+        {
+            options.Force = true;
+        }
+        else if (arg == "--jobs" && i + 1 < argc)
+        {
+            jobs = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        }
+        else
+        {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.size() != 2)
+    {
+        std::cerr << "usage: cs200_cook [--compress] [--mips] [--premultiply] [--jobs N] [--force] Assets out_folder\n";
+        return EXIT_FAILURE;
+    }
+    if (!CS200::ImageProcessing::MatchesScalar())
+    {
+        std::cerr << "image processing self check failed: the vector loops disagree with the scalar ones\n";
+        return EXIT_FAILURE;
+    }
+
+    const auto     start         = std::chrono::steady_clock::now();
+    const fs::path assets_folder = fs::absolute(paths[0]).lexically_normal();
+    const fs::path out_folder    = fs::absolute(paths[1]).lexically_normal();
+    const fs::path manifest_path = out_folder / "cook_manifest.txt";
+    try
+    {
+        std::vector<Item> items;
+        for (const auto& entry : fs::recursive_directory_iterator(assets_folder))
+        {
+            if (!entry.is_regular_file())
+            {
+                continue;
+            }
+            const auto extension = lower_extension(entry.path());
+            if (extension == ".ctex" || extension == ".ktx2" || extension == ".fontmetrics" || extension == ".sdffont")
+            {
+                continue;
+            }
+            Item item{ entry.path(), "Assets/" + fs::relative(entry.path(), assets_folder).generic_string() };
+            if (extension == ".png" || extension == ".jpg" || extension == ".jpeg")
+            {
+                item.Kind = item.Key.starts_with("Assets/fonts/") ? AssetKind::Font : AssetKind::Texture;
+            }
+            else if (extension == ".vert" || extension == ".frag" || extension == ".glsl")
+            {
+                item.Kind = AssetKind::Shader;
+            }
+            items.push_back(std::move(item));
+        }
+        std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) { return a.Key < b.Key; });
+
+        const auto          manifest = read_manifest(manifest_path);
+        std::vector<Result> results(items.size());
+        std::atomic<std::size_t> next{ 0 };
+        const auto               worker = [&]
+        {
+            for (std::size_t i = next++; i < items.size(); i = next++)
+            {
+                results[i] = cook(items[i], out_folder / items[i].Key, assets_folder.parent_path(), options, manifest);
+            }
+        };
+        jobs = std::min<unsigned>(jobs, static_cast<unsigned>(std::max<std::size_t>(items.size(), 1)));
+        std::vector<std::thread> threads;
+        for (unsigned j = 1; j < jobs; ++j)
+        {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        // failed assets stay out of the manifest so the next run retries them
+        std::ostringstream new_manifest;
+        int                cooked = 0, up_to_date = 0, failed = 0;
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            const auto& result = results[i];
+            if (!result.Error.empty())
+            {
+                std::cerr << items[i].Key << ": " << result.Error << '\n';
+                ++failed;
+                continue;
+            }
+            new_manifest << std::hex << std::setw(16) << std::setfill('0') << result.Hash << std::dec << ' ' << items[i].Key << '\n';
+            if (result.UpToDate)
+            {
+                ++up_to_date;
+                continue;
+            }
+            ++cooked;
+            std::cout << items[i].Key << (result.Note.empty() ? "" : " (" + result.Note + ")") << '\n';
+        }
+        fs::create_directories(out_folder);
+        write_text(manifest_path, new_manifest.str());
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << std::fixed << std::setprecision(2) << cooked << " cooked, " << up_to_date << " up to date, " << failed << " failed in " << elapsed.count() << " s on "
+                  << jobs << " threads\n";
+        return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}
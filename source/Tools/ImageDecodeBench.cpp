@@ -0,0 +1,208 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ *
+ * Measures how fast each image decoder in the build turns files into RGBA8.
+ *
+ *     cs200_image_bench [--runs N] Assets/images [more files or folders ...]
+ *
+ * Every png and jpg found is decoded N times (5 by default) by stb_image and,
+ * when the build has CS200_USE_SPNG on, by libspng, each time into the same
+ * ImageAlignment aligned buffer, the way CS200::Image decodes. The fastest
+ * run counts. Speeds are MB of decoded RGBA8 per second; the total line is
+ * what matters for state load time. The two decoders must produce the same
+ * texels, the tool fails if they do not.
+ */
+
+#include "CS200/ImageDecoder.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <gsl/gsl>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct AlignedDelete
+    {
+        void operator()(CS200::RGBA* texels) const noexcept
+        {
+            ::operator delete[](texels, std::align_val_t{ CS200::ImageAlignment });
+        }
+    };
+
+    using TexelBuffer = std::unique_ptr<CS200::RGBA[], AlignedDelete>;
+
+    TexelBuffer allocate_texels(std::size_t count)
+    {
+        return TexelBuffer(static_cast<CS200::RGBA*>(::operator new[](count * sizeof(CS200::RGBA), std::align_val_t{ CS200::ImageAlignment })));
+    }
+
+    std::vector<std::uint8_t> read_file(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            throw std::runtime_error("cannot read " + path.string());
+        }
+        std::vector<std::uint8_t> bytes(gsl::narrow<std::size_t>(std::filesystem::file_size(path)));
+        file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return bytes;
+    }
+
+    bool is_image(const std::filesystem::path& path)
+    {
+        auto extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension == ".png" || extension == ".jpg" || extension == ".jpeg";
+    }
+
+    struct Timing
+    {
+        double Seconds      = 0.0; // fastest run
+        double DecodedBytes = 0.0;
+    };
+
+    Timing time_decoder(const CS200::ImageDecoder& decoder, std::span<const std::uint8_t> encoded, std::span<CS200::RGBA> target, int runs)
+    {
+        Timing timing{ 1e30, static_cast<double>(target.size_bytes()) };
+        for (int run = 0; run < runs; ++run)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            if (!decoder.Decode(encoded, target))
+            {
+                throw std::runtime_error(std::string(decoder.GetName()) + " failed to decode");
+            }
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            timing.Seconds                              = std::min(timing.Seconds, elapsed.count());
+        }
+        return timing;
+    }
+
+    double megabytes_per_second(const Timing& timing)
+    {
+        return timing.DecodedBytes / 1e6 / std::max(timing.Seconds, 1e-9);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int                                runs = 5;
+    std::vector<std::filesystem::path> inputs;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--runs" && i + 1 < argc)
+        {
+            runs = std::max(1, std::atoi(argv[++i]));
+        }
+        else
+        {
+            inputs.emplace_back(arg);
+        }
+    }
+    if (inputs.empty())
+    {
+        std::cerr << "usage: cs200_image_bench [--runs N] Assets/images [more files or folders ...]\n";
+        return EXIT_FAILURE;
+    }
+
+    namespace fs = std::filesystem;
+    std::vector<fs::path> files;
+    for (const auto& input : inputs)
+    {
+        if (fs::is_directory(input))
+        {
+            for (const auto& entry : fs::recursive_directory_iterator(input))
+            {
+                if (entry.is_regular_file() && is_image(entry.path()))
+                {
+                    files.push_back(entry.path());
+                }
+            }
+        }
+        else
+        {
+            files.push_back(input);
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    const CS200::ImageDecoder& stb  = CS200::GetStbImageDecoder();
+    const CS200::ImageDecoder* spng = CS200::GetSpngImageDecoder();
+    if (spng == nullptr)
+    {
+        std::cout << "built without CS200_USE_SPNG, timing stb_image only\n";
+    }
+
+    try
+    {
+        Timing stb_total;
+        Timing spng_total;
+        std::cout << std::fixed << std::setprecision(1);
+        for (const auto& file : files)
+        {
+            const auto encoded = read_file(file);
+            const auto size    = stb.ReadSize(encoded);
+            if (!size)
+            {
+                std::cerr << file.string() << ": not an image, skipped\n";
+                continue;
+            }
+
+            const auto  count = static_cast<std::size_t>(size->x) * static_cast<std::size_t>(size->y);
+            TexelBuffer texels(allocate_texels(count));
+            const auto  target = std::span<CS200::RGBA>(texels.get(), count);
+
+            const auto stb_timing = time_decoder(stb, encoded, target, runs);
+            stb_total.Seconds += stb_timing.Seconds;
+            stb_total.DecodedBytes += stb_timing.DecodedBytes;
+            std::cout << file.string() << " " << size->x << "x" << size->y << ": stb_image " << megabytes_per_second(stb_timing) << " MB/s";
+
+            if (spng != nullptr)
+            {
+                TexelBuffer reference(allocate_texels(count));
+                std::memcpy(reference.get(), texels.get(), target.size_bytes());
+
+                const auto spng_timing = time_decoder(*spng, encoded, target, runs);
+                spng_total.Seconds += spng_timing.Seconds;
+                spng_total.DecodedBytes += spng_timing.DecodedBytes;
+                std::cout << ", libspng " << megabytes_per_second(spng_timing) << " MB/s";
+                if (std::memcmp(reference.get(), texels.get(), target.size_bytes()) != 0)
+                {
+                    throw std::runtime_error(file.string() + ": libspng and stb_image decode different texels");
+                }
+            }
+            std::cout << '\n';
+        }
+
+        std::cout << "total: stb_image " << megabytes_per_second(stb_total) << " MB/s";
+        if (spng != nullptr)
+        {
+            std::cout << ", libspng " << megabytes_per_second(spng_total) << " MB/s, " << std::setprecision(2) << stb_total.Seconds / std::max(spng_total.Seconds, 1e-9)
+                      << "x faster";
+        }
+        std::cout << '\n';
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
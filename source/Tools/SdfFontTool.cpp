@@ -0,0 +1,75 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ *
+ * Offline generator for the .sdffont atlases CS230::SdfFont loads.
+ *
+ *     cs200_sdf_font [--spread N] Assets/fonts/Font_Simple.png [more.png ...]
+ *
+ * Writes Font_Simple.sdffont next to each png. The game generates the same
+ * file on first run when it is missing, so this only saves that first load.
+ */
+
+#include "CS200/Image.hpp"
+#include "CS200/SdfFontAtlas.hpp"
+#include "Engine/Path.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+    int                                spread = CS200::DefaultSdfSpread;
+    std::vector<std::filesystem::path> fonts;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--spread" && i + 1 < argc)
+        {
+            spread = std::max(1, std::atoi(argv[++i]));
+        }
+        else
+        {
+            fonts.emplace_back(arg);
+        }
+    }
+    if (fonts.empty())
+    {
+        std::cerr << "usage: cs200_sdf_font [--spread N] font.png [font.png ...]\n";
+        return EXIT_FAILURE;
+    }
+
+    int failures = 0;
+    for (const auto& png_path : fonts)
+    {
+        try
+        {
+            const CS200::Image       image(png_path);
+            std::vector<Math::irect> rects(CS200::FontGlyphCount);
+            CS200::ScanGlyphRects(image, rects);
+            const auto atlas = CS200::GenerateSdfFontAtlas(image, rects, spread);
+
+            auto out_path = png_path;
+            out_path.replace_extension(".sdffont");
+            if (!CS200::WriteSdfFontAtlas(out_path, atlas, assets::hash_asset(png_path).value_or(0)))
+            {
+                throw std::runtime_error("cannot write " + out_path.string());
+            }
+            std::cout << png_path.string() << " -> " << out_path.string() << " (" << atlas.Size.x << 'x' << atlas.Size.y << ", spread " << spread << ")\n";
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << png_path.string() << ": " << e.what() << '\n';
+            ++failures;
+        }
+    }
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,161 @@
+/**
+ * \file
+ * \author Junseok Lee
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ *
+ * Offline converter from png to ETC2 compressed .ktx2 textures.
+ *
+ *     cs200_compress_textures [--rgba] [--mips] Assets/images/DemoFramebuffer/Planets.png [more.png ...]
+ *
+ * Writes Planets.ktx2 next to each png. Opaque images become ETC2 RGB8
+ * (4 bits per texel), images with any translucent texel ETC2 RGBA8 with EAC
+ * alpha (8 bits per texel); --rgba forces the latter. TextureManager picks the
+ * .ktx2 up when the GPU supports ETC2 and falls back to the png otherwise.
+ *
+ * --mips also stores the full mip chain, built with an alpha weighted box
+ * filter (the plain SIMD one for opaque images) and compressed level by level, for textures that are drawn
+ * minified with Trilinear filtering. The GPU cannot generate mipmaps for
+ * compressed formats, so without it such textures only have level 0.
+ *
+ * For each file the tool prints the RGBA8 and compressed sizes and the
+ * PSNR of the color channels after a round trip, to judge the quality loss.
+ */
+
+#include "CS200/Etc2.hpp"
+#include "CS200/Image.hpp"
+#include "CS200/ImageProcessing.hpp"
+#include "CS200/Ktx2.hpp"
+#include "CS200/MipChain.hpp"
+#include "Engine/Path.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace
+{
+    double color_psnr(const CS200::Image& image, const std::vector<CS200::RGBA>& decoded)
+    {
+        const auto*  original = reinterpret_cast<const std::uint8_t*>(image.data());
+        const auto*  result   = reinterpret_cast<const std::uint8_t*>(decoded.data());
+        const auto   texels   = decoded.size();
+        double       squared  = 0.0;
+        for (std::size_t i = 0; i < texels; ++i)
+        {
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                const double d = static_cast<double>(original[i * 4 + c]) - static_cast<double>(result[i * 4 + c]);
+                squared += d * d;
+            }
+        }
+        const double mse = squared / static_cast<double>(texels * 3);
+        return mse > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / mse) : 99.0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    bool                               force_alpha = false;
+    bool                               with_mips   = false;
+    std::vector<std::filesystem::path> images;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--rgba")
+        {
+            force_alpha = true;
+        }
+        else if (arg == "--mips")
+        {
+            with_mips = true;
+        }
+        else
+        {
+            images.emplace_back(arg);
+        }
+    }
+    if (images.empty())
+    {
+        std::cerr << "usage: cs200_compress_textures [--rgba] [--mips] image.png [image.png ...]\n";
+        return EXIT_FAILURE;
+    }
+    if (!CS200::ImageProcessing::MatchesScalar())
+    {
+        std::cerr << "image processing self check failed: the vector loops disagree with the scalar ones\n";
+        return EXIT_FAILURE;
+    }
+
+    int         failures       = 0;
+    std::size_t total_before   = 0;
+    std::size_t total_after    = 0;
+    for (const auto& png_path : images)
+    {
+        try
+        {
+            // bottom row first, the order the textures are uploaded in
+            constexpr bool     flip_image = true;
+            const CS200::Image image(png_path, flip_image);
+
+            CS200::Ktx2Texture texture;
+            texture.Format      = force_alpha || CS200::HasTranslucentTexels(image) ? CS200::Etc2Format::RGBA8 : CS200::Etc2Format::RGB8;
+            texture.Size        = image.GetSize();
+            texture.SourceHash  = assets::hash_asset(png_path).value_or(0);
+            texture.Data        = CS200::EncodeEtc2(image, texture.Format);
+            if (with_mips)
+            {
+                const auto texel_count = static_cast<std::size_t>(texture.Size.x) * static_cast<std::size_t>(texture.Size.y);
+                for (const auto& level : CS200::BuildMipChain(std::span<const CS200::RGBA>(image.data(), texel_count), texture.Size))
+                {
+                    texture.MipLevels.push_back(CS200::EncodeEtc2(level.Texels, level.Size, texture.Format));
+                }
+            }
+
+            auto out_path = png_path;
+            out_path.replace_extension(".ktx2");
+            if (!CS200::WriteKtx2(out_path, texture))
+            {
+                throw std::runtime_error("cannot write " + out_path.string());
+            }
+
+            const auto decoded = CS200::DecodeEtc2(texture.Data, texture.Size, texture.Format);
+            const auto before  = static_cast<std::size_t>(texture.Size.x) * static_cast<std::size_t>(texture.Size.y) * 4;
+            auto       after   = texture.Data.size();
+            for (const auto& level : texture.MipLevels)
+            {
+                after += level.size();
+            }
+            total_before += before;
+            total_after += after;
+
+            std::cout << std::fixed << std::setprecision(1) << png_path.string() << " -> " << out_path.string() << " (" << texture.Size.x << 'x' << texture.Size.y << ", "
+                      << (texture.Format == CS200::Etc2Format::RGB8 ? "ETC2 RGB8" : "ETC2 RGBA8 + EAC") << ", " << 1 + texture.MipLevels.size() << " mip levels)\n"
+                      << "    VRAM " << static_cast<double>(before) / 1024.0 / 1024.0 << " MiB -> " << static_cast<double>(after) / 1024.0 / 1024.0 << " MiB, "
+                      << "32 -> " << static_cast<double>(after * 8) / static_cast<double>(texture.Size.x * texture.Size.y) << " bits per texel sampled";
+            if (decoded)
+            {
+                std::cout << ", color PSNR " << color_psnr(image, *decoded) << " dB";
+            }
+            std::cout << '\n';
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << png_path.string() << ": " << e.what() << '\n';
+            ++failures;
+        }
+    }
+
+    if (total_before > 0)
+    {
+        std::cout << std::fixed << std::setprecision(1) << "total VRAM " << static_cast<double>(total_before) / 1024.0 / 1024.0 << " MiB -> "
+                  << static_cast<double>(total_after) / 1024.0 / 1024.0 << " MiB\n";
+    }
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}